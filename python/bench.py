@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+
+#
+# modp against the standard library, build it first with setup.py
+#
+#   python3 bench.py [--sizes=64,4096,1048576] [--threads=4]
+#
+# The first table is single thread ns per call.  The second runs the
+# same 1M encode on N threads at once, with the stdlib (which holds the
+# GIL) and modp (which releases it), and reports the total GB/s.
+#
+
+import base64
+import binascii
+import html
+import os
+import sys
+import threading
+import time
+import timeit
+import urllib.parse
+
+import modp
+
+
+def bench(fn, arg, min_time=0.2):
+    t = timeit.Timer(lambda: fn(arg))
+    n, _ = t.autorange()
+    n = max(n, int(n * min_time / 0.2))
+    return min(t.repeat(3, n)) / n * 1e9
+
+
+def text(n):
+    # url and html like text, about 1 in 10 characters escaped
+    s = ('hello world/a=b&c<d>"e" ' * (n // 24 + 1))[:n]
+    return s.encode('ascii')
+
+
+def main():
+    sizes = [64, 4096, 1 << 20]
+    nthreads = os.cpu_count() or 1
+    for a in sys.argv[1:]:
+        if a.startswith('--sizes='):
+            sizes = [int(x) for x in a[8:].split(',')]
+        elif a.startswith('--threads='):
+            nthreads = int(a[10:])
+        else:
+            sys.exit(__doc__ or 'usage: bench.py [--sizes=..] [--threads=N]')
+
+    print('%-22s %9s %12s %12s %8s' % ('codec', 'size', 'stdlib ns', 'modp ns', 'speedup'))
+    for n in sizes:
+        raw = os.urandom(n)
+        txt = text(n)
+        b64 = base64.b64encode(raw)
+        q = urllib.parse.quote_plus(txt).encode('ascii')
+        esc = html.escape(txt.decode('ascii')).encode('ascii')
+        rows = [
+            ('b64 encode', base64.b64encode, modp.b64_encode, raw),
+            ('b64 decode', base64.b64decode, modp.b64_decode, b64),
+            ('b64 urlsafe encode', base64.urlsafe_b64encode, modp.b64r_encode, raw),
+            ('hex encode', binascii.hexlify, modp.b16_encode, raw),
+            ('b85 encode', base64.b85encode, modp.b85_encode, raw[:n // 4 * 4]),
+            ('url quote_plus', urllib.parse.quote_plus, modp.burl_encode, txt),
+            ('url unquote_plus', lambda s: urllib.parse.unquote_plus(s.decode('ascii')),
+             modp.burl_decode, q),
+            ('html escape', lambda s: html.escape(s.decode('ascii')), modp.xml_encode, txt),
+            ('html unescape', lambda s: html.unescape(s.decode('ascii')), modp.xml_decode, esc),
+        ]
+        for name, std, fast, arg in rows:
+            ts = bench(std, arg)
+            tm = bench(fast, arg)
+            print('%-22s %9d %12.0f %12.0f %7.1fx' % (name, n, ts, tm, ts / tm))
+
+    raw = os.urandom(1 << 20)
+    print()
+    print('%-22s %9s %12s %12s' % ('b64 encode 1M', 'threads', 'stdlib GB/s', 'modp GB/s'))
+    for t in sorted(set([1, nthreads])):
+        print('%-22s %9d %12.2f %12.2f' % ('', t, threaded(base64.b64encode, raw, t),
+                                           threaded(modp.b64_encode, raw, t)))
+
+
+def threaded(fn, arg, nthreads, seconds=0.5):
+    calls = [0] * nthreads
+    stop = time.perf_counter() + seconds
+
+    def work(i):
+        while time.perf_counter() < stop:
+            fn(arg)
+            calls[i] += 1
+
+    threads = [threading.Thread(target=work, args=(i,)) for i in range(nthreads)]
+    t0 = time.perf_counter()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    return sum(calls) * len(arg) / (time.perf_counter() - t0) / 1e9
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,511 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/*
+ * <PRE>
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ *
+ * The "modp" python module, the string codecs of the library as
+ *
+ *   modp.b64_encode(data, out=None)
+ *
+ * bjavascript_uencode and datauri_encode also take the flags and the
+ * media type as keyword-only arguments.  datauri_decode and
+ * utf8_validate do not write a buffer, and return a tuple and an int.
+ *
+ * data is anything with the buffer protocol (bytes, bytearray,
+ * memoryview, mmap, array, ...), read in place, or a str, read as
+ * UTF-8.  Without out a new bytes is returned.  With out, a writable
+ * buffer at least max_len(name, len(data)) bytes long, the output is
+ * written there and its length returned, so nothing is allocated.
+ *
+ * Calls with at least gil_threshold() bytes of input release the GIL
+ * while coding, so threads encoding large inputs run in parallel.
+ * Small inputs keep it, releasing it costs more than they take.
+ *
+ * The codecs come from the amalgamated modp_inline.h, so the module
+ * does not need the shared library.  See setup.py.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#define MODP_INLINE
+#include "modp_inline.h"
+
+typedef size_t (*codec_fn)(char* dest, const char* src, size_t len);
+
+/* the keyword-only argument of a codec */
+struct codec_kw {
+    int flags;
+    const char* mime;
+    size_t mime_len;
+};
+
+typedef size_t (*codec_kw_fn)(char* dest, const char* src, size_t len,
+                              const struct codec_kw* k);
+
+struct codec {
+    const char* name;
+    /* one of fn or fn_kw */
+    codec_fn fn;
+    codec_kw_fn fn_kw;
+    /* the name of the keyword-only argument of fn_kw */
+    const char* kw;
+    /* the most output bytes for n input bytes and a kw of m bytes */
+    size_t (*max_len)(size_t n, size_t m);
+};
+
+static Py_ssize_t gil_threshold = 64 * 1024;
+
+/*
+ * (data, out=None, *, kw) by hand, METH_FASTCALL without an argument
+ * parser, as for small inputs the call is most of the time
+ */
+static int parse(const char* name, PyObject* const* args, Py_ssize_t nargs,
+                 PyObject* kwnames, PyObject** data, PyObject** out,
+                 const char* kw, PyObject** kwval)
+{
+    Py_ssize_t i, nkw = kwnames ? PyTuple_GET_SIZE(kwnames) : 0;
+    PyObject* key;
+
+    *data = (nargs > 0) ? args[0] : NULL;
+    *out = (nargs > 1) ? args[1] : Py_None;
+    *kwval = NULL;
+    if (nargs > 2) {
+        PyErr_Format(PyExc_TypeError, "%s() takes at most 2 arguments (%zd given)",
+                     name, nargs);
+        return -1;
+    }
+    for (i = 0; i < nkw; ++i) {
+        key = PyTuple_GET_ITEM(kwnames, i);
+        if (nargs < 1 && PyUnicode_CompareWithASCIIString(key, "data") == 0) {
+            *data = args[nargs + i];
+        } else if (nargs < 2 && PyUnicode_CompareWithASCIIString(key, "out") == 0) {
+            *out = args[nargs + i];
+        } else if (kw != NULL && PyUnicode_CompareWithASCIIString(key, kw) == 0) {
+            *kwval = args[nargs + i];
+        } else {
+            PyErr_Format(PyExc_TypeError, "%s() got an unexpected keyword argument '%U'",
+                         name, key);
+            return -1;
+        }
+    }
+    if (*data == NULL) {
+        PyErr_Format(PyExc_TypeError, "%s() missing required argument 'data'", name);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * the bytes of a bytes-like object, read in place, or of a str as
+ * UTF-8.  b->obj is set if b must be released.
+ */
+static int get_bytes(PyObject* o, Py_buffer* b, const char** s, Py_ssize_t* len)
+{
+    b->obj = NULL;
+    if (PyUnicode_Check(o)) {
+        *s = PyUnicode_AsUTF8AndSize(o, len);
+        return (*s == NULL) ? -1 : 0;
+    }
+    if (PyObject_GetBuffer(o, b, PyBUF_SIMPLE) != 0) {
+        return -1;
+    }
+    *s = (const char*)b->buf;
+    *len = b->len;
+    return 0;
+}
+
+/* the keyword-only argument, the default if not given */
+static int get_kw(const struct codec* c, PyObject* o, Py_buffer* b, struct codec_kw* k)
+{
+    Py_ssize_t len = 0;
+    long flags;
+
+    b->obj = NULL;
+    k->flags = MODP_JS_ESCAPE_HTML;
+    k->mime = "";
+    k->mime_len = 0;
+    if (o == NULL) {
+        return 0;
+    }
+    if (strcmp(c->kw, "flags") == 0) {
+        flags = PyLong_AsLong(o);
+        if (flags == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        k->flags = (int)flags;
+        return 0;
+    }
+    if (get_bytes(o, b, &k->mime, &len) != 0) {
+        return -1;
+    }
+    k->mime_len = (size_t)len;
+    return 0;
+}
+
+static size_t call(const struct codec* c, char* dest, const char* src, size_t len,
+                   const struct codec_kw* k)
+{
+    return c->fn ? c->fn(dest, src, len) : c->fn_kw(dest, src, len, k);
+}
+
+static PyObject* run(const struct codec* c, PyObject* const* args, Py_ssize_t nargs,
+                     PyObject* kwnames)
+{
+    PyObject* data;
+    PyObject* out;
+    PyObject* kwval;
+    PyObject* result = NULL;
+    struct codec_kw k;
+    Py_buffer in;
+    Py_buffer kwbuf;
+    Py_buffer dest;
+    const char* src;
+    Py_ssize_t srclen;
+    size_t need, n;
+
+    if (parse(c->name, args, nargs, kwnames, &data, &out, c->kw, &kwval) != 0) {
+        return NULL;
+    }
+    if (get_bytes(data, &in, &src, &srclen) != 0) {
+        return NULL;
+    }
+    if (get_kw(c, kwval, &kwbuf, &k) != 0) {
+        goto done;
+    }
+    need = c->max_len((size_t)srclen, k.mime_len);
+
+    if (out == Py_None) {
+        result = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)need);
+        if (result == NULL) {
+            goto done;
+        }
+        dest.buf = PyBytes_AS_STRING(result);
+        dest.obj = NULL;
+    } else {
+        if (PyObject_GetBuffer(out, &dest, PyBUF_WRITABLE) != 0) {
+            goto done;
+        }
+        if ((size_t)dest.len < need) {
+            PyErr_Format(PyExc_ValueError, "%s: out needs %zu bytes, has %zd",
+                         c->name, need, dest.len);
+            PyBuffer_Release(&dest);
+            goto done;
+        }
+    }
+
+    if (srclen >= gil_threshold) {
+        Py_BEGIN_ALLOW_THREADS
+        n = call(c, (char*)dest.buf, src, (size_t)srclen, &k);
+        Py_END_ALLOW_THREADS
+    } else {
+        n = call(c, (char*)dest.buf, src, (size_t)srclen, &k);
+    }
+    if (dest.obj != NULL) {
+        PyBuffer_Release(&dest);
+    }
+
+    if (n == (size_t)-1) {
+        PyErr_Format(PyExc_ValueError, "%s: invalid input", c->name);
+        Py_CLEAR(result);
+    } else if (result != NULL) {
+        _PyBytes_Resize(&result, (Py_ssize_t)n);
+    } else {
+        result = PyLong_FromSize_t(n);
+    }
+
+done:
+    if (kwbuf.obj != NULL) {
+        PyBuffer_Release(&kwbuf);
+    }
+    if (in.obj != NULL) {
+        PyBuffer_Release(&in);
+    }
+    return result;
+}
+
+/* a JSON string, as modp_json_add_string writes it */
+static size_t json_string(char* dest, const char* src, size_t len)
+{
+    modp_json_ctx ctx;
+
+    modp_json_init(&ctx, dest);
+    modp_json_add_string(&ctx, src, len);
+    return modp_json_end(&ctx);
+}
+
+static size_t bjavascript_uencode(char* dest, const char* src, size_t len,
+                                  const struct codec_kw* k)
+{
+    return modp_bjavascript_uencode(dest, src, len, k->flags);
+}
+
+static size_t datauri_encode(char* dest, const char* src, size_t len,
+                             const struct codec_kw* k)
+{
+    return modp_datauri_encode(dest, k->mime, k->mime_len, src, len);
+}
+
+/*
+ * one codec, LEN is the output bound in terms of n, and m for the
+ * length of the keyword-only argument KW of FN_KW
+ */
+#define CODEC_DEF(name, FN, FN_KW, KW, LEN) \
+    static size_t name##_max_len(size_t n, size_t m) { (void)m; return (size_t)(LEN); } \
+    static const struct codec c_##name = { #name, FN, FN_KW, KW, name##_max_len }; \
+    static PyObject* py_##name(PyObject* self, PyObject* const* args, \
+                               Py_ssize_t nargs, PyObject* kwnames) \
+    { \
+        (void)self; \
+        return run(&c_##name, args, nargs, kwnames); \
+    }
+
+#define CODEC(name, LEN) CODEC_DEF(name, modp_##name, NULL, NULL, LEN)
+
+CODEC(b2_encode, modp_b2_encode_len(n))
+CODEC(b2_decode, modp_b2_decode_len(n))
+CODEC(b16_encode, modp_b16_encode_len(n))
+CODEC(b16_decode, modp_b16_decode_len(n))
+CODEC(b64_encode, modp_b64_encode_len(n))
+CODEC(b64_decode, modp_b64_decode_len(n))
+CODEC(b64w_encode, modp_b64w_encode_len(n))
+CODEC(b64w_decode, modp_b64w_decode_len(n))
+CODEC(b64r_encode, modp_b64r_encode_len(n))
+CODEC(b64r_decode, modp_b64r_decode_len(n))
+CODEC(b85_encode, modp_b85_encode_len(n))
+CODEC(b85_decode, modp_b85_decode_len(n))
+CODEC(burl_encode, modp_burl_encode_len(n))
+CODEC(burl_min_encode, modp_burl_encode_len(n))
+CODEC(burl_decode, modp_burl_decode_len(n))
+CODEC(burl_decode_raw, modp_burl_decode_len(n))
+CODEC(bjavascript_encode, modp_bjavascript_encode_len(n))
+CODEC(bjavascript_decode, modp_bjavascript_decode_len(n))
+CODEC_DEF(bjavascript_uencode, NULL, bjavascript_uencode, "flags",
+          modp_bjavascript_uencode_len(n))
+CODEC_DEF(json_string, json_string, NULL, NULL, 6 * n + 3)
+CODEC_DEF(datauri_encode, NULL, datauri_encode, "mime", modp_datauri_encode_len(m, n))
+CODEC(xml_encode, 6 * n + 1)
+CODEC(xml_decode, n + 1)
+CODEC(qp_encode, modp_qp_encode_len(n))
+CODEC(qp_decode, modp_qp_decode_len(n))
+CODEC(encword_encode, modp_encword_encode_len(n))
+CODEC(encword_decode, modp_encword_decode_len(n))
+CODEC(punycode_encode, modp_punycode_encode_len(n))
+CODEC(punycode_decode, modp_punycode_decode_len(n))
+
+static const struct codec* const codecs[] = {
+    &c_b2_encode, &c_b2_decode, &c_b16_encode, &c_b16_decode,
+    &c_b64_encode, &c_b64_decode, &c_b64w_encode, &c_b64w_decode,
+    &c_b64r_encode, &c_b64r_decode, &c_b85_encode, &c_b85_decode,
+    &c_burl_encode, &c_burl_min_encode, &c_burl_decode, &c_burl_decode_raw,
+    &c_bjavascript_encode, &c_bjavascript_decode, &c_bjavascript_uencode,
+    &c_json_string, &c_datauri_encode, &c_xml_encode, &c_xml_decode,
+    &c_qp_encode, &c_qp_decode, &c_encword_encode, &c_encword_decode,
+    &c_punycode_encode, &c_punycode_decode
+};
+
+#define NCODECS (sizeof(codecs) / sizeof(codecs[0]))
+
+static PyObject* py_max_len(PyObject* self, PyObject* args)
+{
+    const char* name;
+    Py_ssize_t n;
+    Py_ssize_t m = 0;
+    size_t i;
+
+    (void)self;
+    if (!PyArg_ParseTuple(args, "sn|n:max_len", &name, &n, &m)) {
+        return NULL;
+    }
+    if (n < 0 || m < 0) {
+        PyErr_SetString(PyExc_ValueError, "max_len: negative length");
+        return NULL;
+    }
+    for (i = 0; i < NCODECS; ++i) {
+        if (strcmp(codecs[i]->name, name) == 0) {
+            return PyLong_FromSize_t(codecs[i]->max_len((size_t)n, (size_t)m));
+        }
+    }
+    PyErr_Format(PyExc_KeyError, "max_len: no codec %s", name);
+    return NULL;
+}
+
+static PyObject* py_datauri_decode(PyObject* self, PyObject* args)
+{
+    struct modp_datauri_t uri;
+    PyObject* result = NULL;
+    Py_buffer in;
+    char* buf;
+    size_t n;
+
+    (void)self;
+    if (!PyArg_ParseTuple(args, "s*:datauri_decode", &in)) {
+        return NULL;
+    }
+    /* decoded in place, in a copy with room for the null */
+    buf = (char*)PyMem_Malloc((size_t)in.len + 1);
+    if (buf == NULL) {
+        PyBuffer_Release(&in);
+        return PyErr_NoMemory();
+    }
+    memcpy(buf, in.buf, (size_t)in.len);
+    if (in.len >= gil_threshold) {
+        Py_BEGIN_ALLOW_THREADS
+        n = modp_datauri_decode(&uri, buf, (size_t)in.len);
+        Py_END_ALLOW_THREADS
+    } else {
+        n = modp_datauri_decode(&uri, buf, (size_t)in.len);
+    }
+    if (n == (size_t)-1) {
+        PyErr_SetString(PyExc_ValueError, "datauri_decode: invalid input");
+    } else {
+        result = Py_BuildValue("(y#y#)", uri.mime, (Py_ssize_t)uri.mime_len,
+                               uri.data, (Py_ssize_t)uri.data_len);
+    }
+    PyMem_Free(buf);
+    PyBuffer_Release(&in);
+    return result;
+}
+
+static PyObject* py_utf8_validate(PyObject* self, PyObject* args)
+{
+    Py_buffer in;
+    int r;
+
+    (void)self;
+    if (!PyArg_ParseTuple(args, "s*:utf8_validate", &in)) {
+        return NULL;
+    }
+    if (in.len >= gil_threshold) {
+        Py_BEGIN_ALLOW_THREADS
+        r = modp_utf8_validate((const char*)in.buf, (size_t)in.len);
+        Py_END_ALLOW_THREADS
+    } else {
+        r = modp_utf8_validate((const char*)in.buf, (size_t)in.len);
+    }
+    PyBuffer_Release(&in);
+    return PyLong_FromLong(r);
+}
+
+static PyObject* py_gil_threshold(PyObject* self, PyObject* args)
+{
+    Py_ssize_t n = -1;
+    Py_ssize_t old = gil_threshold;
+
+    (void)self;
+    if (!PyArg_ParseTuple(args, "|n:gil_threshold", &n)) {
+        return NULL;
+    }
+    if (n >= 0) {
+        gil_threshold = n;
+    }
+    return PyLong_FromSsize_t(old);
+}
+
+#define CODEC_DOC(name, what) \
+    #name "(data, out=None)\n--\n\n" what "\n\n" \
+    "data is a bytes-like object or a str (as UTF-8).  Returns bytes, or\n" \
+    "with out, a writable buffer of at least max_len(\"" #name "\", len(data))\n" \
+    "bytes, writes the output there and returns its length."
+
+#define ENCODE_DOC(name, what) CODEC_DOC(name, what)
+#define DECODE_DOC(name, what) CODEC_DOC(name, what "  Raises ValueError on bad input.")
+
+#define METHOD(name, doc) \
+    { #name, (PyCFunction)(void (*)(void))py_##name, METH_FASTCALL | METH_KEYWORDS, doc }
+
+static PyMethodDef methods[] = {
+    METHOD(b2_encode, ENCODE_DOC(b2_encode, "Binary (\"0\" and \"1\") encode.")),
+    METHOD(b2_decode, DECODE_DOC(b2_decode, "Binary decode.")),
+    METHOD(b16_encode, ENCODE_DOC(b16_encode, "Hex encode, upper case.")),
+    METHOD(b16_decode, DECODE_DOC(b16_decode, "Hex decode.")),
+    METHOD(b64_encode, ENCODE_DOC(b64_encode, "Base64 encode, standard alphabet.")),
+    METHOD(b64_decode, DECODE_DOC(b64_decode, "Base64 decode, standard alphabet.")),
+    METHOD(b64w_encode, ENCODE_DOC(b64w_encode, "Base64 encode, web alphabet.")),
+    METHOD(b64w_decode, DECODE_DOC(b64w_decode, "Base64 decode, web alphabet.")),
+    METHOD(b64r_encode, ENCODE_DOC(b64r_encode, "Base64 encode, RFC 4648 url safe alphabet.")),
+    METHOD(b64r_decode, DECODE_DOC(b64r_decode, "Base64 decode, RFC 4648 url safe alphabet.")),
+    METHOD(b85_encode, ENCODE_DOC(b85_encode, "Base85 encode, len(data) a multiple of 4.")),
+    METHOD(b85_decode, DECODE_DOC(b85_decode, "Base85 decode.")),
+    METHOD(burl_encode, ENCODE_DOC(burl_encode, "Url (form) escape, like urllib.parse.quote_plus.")),
+    METHOD(burl_min_encode, ENCODE_DOC(burl_min_encode, "Url escape only what must be.")),
+    METHOD(burl_decode, DECODE_DOC(burl_decode, "Url (form) unescape, + is a space.")),
+    METHOD(burl_decode_raw, DECODE_DOC(burl_decode_raw, "Url unescape, + is kept.")),
+    METHOD(bjavascript_encode, ENCODE_DOC(bjavascript_encode, "Javascript string escape.")),
+    METHOD(bjavascript_decode, DECODE_DOC(bjavascript_decode, "Javascript string unescape.")),
+    METHOD(bjavascript_uencode,
+           "bjavascript_uencode(data, out=None, *, flags=JS_ESCAPE_HTML)\n--\n\n"
+           "Javascript string escape of UTF-8, flags are JS_ESCAPE_ values or-ed\n"
+           "together.  Otherwise as bjavascript_encode."),
+    METHOD(json_string, ENCODE_DOC(json_string, "JSON string escape, quotes included.\n"
+                                        "Bytes over 0x7f are written as \\u00XX.")),
+    METHOD(datauri_encode,
+           "datauri_encode(data, out=None, *, mime=b\"\")\n--\n\n"
+           "A base64 data URI of data with the media type mime.  With out, it\n"
+           "needs max_len(\"datauri_encode\", len(data), len(mime)) bytes.\n"
+           "Otherwise as b64_encode."),
+    METHOD(xml_encode, ENCODE_DOC(xml_encode, "XML escape.")),
+    METHOD(xml_decode, DECODE_DOC(xml_decode, "XML unescape, entities as UTF-8.")),
+    METHOD(qp_encode, ENCODE_DOC(qp_encode, "Quoted-printable encode.")),
+    METHOD(qp_decode, DECODE_DOC(qp_decode, "Quoted-printable decode.")),
+    METHOD(encword_encode, ENCODE_DOC(encword_encode, "RFC 2047 encoded word encode.")),
+    METHOD(encword_decode, DECODE_DOC(encword_decode, "RFC 2047 encoded word decode.")),
+    METHOD(punycode_encode, ENCODE_DOC(punycode_encode, "Punycode encode of UTF-8.")),
+    METHOD(punycode_decode, DECODE_DOC(punycode_decode, "Punycode decode to UTF-8.")),
+    { "datauri_decode", py_datauri_decode, METH_VARARGS,
+      "datauri_decode(data)\n--\n\n"
+      "Parse a data URI, returns (mime, payload) as bytes.  mime is b\"\" if\n"
+      "none was given.  Raises ValueError on bad input." },
+    { "utf8_validate", py_utf8_validate, METH_VARARGS,
+      "utf8_validate(data)\n--\n\n"
+      "UTF8_OK if data is valid UTF-8, else UTF8_SHORT, UTF8_INVALID,\n"
+      "UTF8_OVERLONG or UTF8_CODEPOINT for the first error." },
+    { "max_len", py_max_len, METH_VARARGS,
+      "max_len(name, n, m=0)\n--\n\n"
+      "The size an out buffer needs for the codec name and n input bytes,\n"
+      "and a mime of m bytes for datauri_encode." },
+    { "gil_threshold", py_gil_threshold, METH_VARARGS,
+      "gil_threshold(n=-1)\n--\n\n"
+      "Calls with at least n input bytes release the GIL (default 65536).\n"
+      "Returns the old value, n < 0 only reads it." },
+    { NULL, NULL, 0, NULL }
+};
+
+static struct PyModuleDef module = {
+    PyModuleDef_HEAD_INIT,
+    "modp",
+    "Fast string encoders and decoders from stringencoders.",
+    -1,
+    methods,
+    NULL, NULL, NULL, NULL
+};
+
+PyMODINIT_FUNC PyInit_modp(void)
+{
+    PyObject* m = PyModule_Create(&module);
+
+    if (m == NULL) {
+        return NULL;
+    }
+    if (PyModule_AddIntConstant(m, "JS_ESCAPE_LINESEP", MODP_JS_ESCAPE_LINESEP) != 0
+        || PyModule_AddIntConstant(m, "JS_ESCAPE_SCRIPT", MODP_JS_ESCAPE_SCRIPT) != 0
+        || PyModule_AddIntConstant(m, "JS_ESCAPE_NONASCII", MODP_JS_ESCAPE_NONASCII) != 0
+        || PyModule_AddIntConstant(m, "JS_ESCAPE_HTML", MODP_JS_ESCAPE_HTML) != 0
+        || PyModule_AddIntConstant(m, "UTF8_OK", MODP_UTF8_OK) != 0
+        || PyModule_AddIntConstant(m, "UTF8_SHORT", MODP_UTF8_SHORT) != 0
+        || PyModule_AddIntConstant(m, "UTF8_INVALID", MODP_UTF8_INVALID) != 0
+        || PyModule_AddIntConstant(m, "UTF8_OVERLONG", MODP_UTF8_OVERLONG) != 0
+        || PyModule_AddIntConstant(m, "UTF8_CODEPOINT", MODP_UTF8_CODEPOINT) != 0) {
+        Py_DECREF(m);
+        return NULL;
+    }
+    return m;
+}
@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+
+#
+# Builds the "modp" extension, see modpmodule.c
+#
+#   ./configure && make        (in the top directory, for src/modp_inline.h)
+#   cd python && python3 setup.py build_ext --inplace
+#   python3 test_modp.py && python3 bench.py
+#
+
+import os
+import sys
+
+from setuptools import Extension, setup
+
+here = os.path.dirname(os.path.abspath(__file__))
+src = os.path.normpath(os.path.join(here, '..', 'src'))
+
+if not os.path.exists(os.path.join(src, 'modp_inline.h')):
+    sys.exit('src/modp_inline.h is missing, run ./configure && make '
+             'in the top directory first')
+
+setup(
+    name='modp',
+    version='3.10.3',
+    description='Fast string encoders and decoders from stringencoders',
+    url='http://code.google.com/p/stringencoders/',
+    license='BSD',
+    ext_modules=[
+        Extension('modp', [os.path.join(here, 'modpmodule.c')],
+                  include_dirs=[src],
+                  extra_compile_args=['-O3']),
+    ],
+)
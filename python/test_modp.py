@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+
+#
+# Checks the modp extension against the standard library, build it
+# first with setup.py (see there)
+#
+
+import array
+import base64
+import binascii
+import json
+import mmap
+import threading
+import unittest
+import urllib.parse
+
+import modp
+
+DATA = bytes(range(256)) * 41
+
+
+class TestModp(unittest.TestCase):
+
+    def test_same_as_stdlib(self):
+        for n in (0, 1, 2, 3, 4, 100, len(DATA)):
+            d = DATA[:n]
+            self.assertEqual(modp.b64_encode(d), base64.b64encode(d))
+            self.assertEqual(modp.b64r_encode(d), base64.urlsafe_b64encode(d))
+            self.assertEqual(modp.b16_encode(d), base64.b16encode(d))
+            self.assertEqual(modp.b64_decode(base64.b64encode(d)), d)
+            self.assertEqual(modp.b16_decode(base64.b16encode(d)), d)
+            self.assertEqual(modp.burl_decode(urllib.parse.quote_plus(d)), d)
+
+    def test_round_trips(self):
+        for name in ('b2', 'b16', 'b64', 'b64w', 'b64r', 'b85', 'burl',
+                     'bjavascript', 'qp'):
+            enc = getattr(modp, name + '_encode')
+            dec = getattr(modp, name + '_decode')
+            self.assertEqual(dec(enc(DATA)), DATA, name)
+        text = 'a <b> & "c" \'d\' é€'
+        self.assertEqual(modp.xml_decode(modp.xml_encode(text)),
+                         text.encode('utf-8'))
+
+    def test_buffers(self):
+        want = base64.b64encode(DATA)
+        for obj in (bytearray(DATA), memoryview(DATA), array.array('B', DATA),
+                    memoryview(b'xx' + DATA)[2:]):
+            self.assertEqual(modp.b64_encode(obj), want)
+        m = mmap.mmap(-1, len(DATA))
+        m.write(DATA)
+        self.assertEqual(modp.b64_encode(m), want)
+        m.close()
+        self.assertEqual(modp.b64_encode('é'), b'w6k=')
+        self.assertRaises(TypeError, modp.b64_encode, 12)
+        self.assertRaises(BufferError, modp.b64_encode, memoryview(DATA)[::2])
+
+    def test_out(self):
+        out = bytearray(modp.max_len('b64_encode', len(DATA)))
+        n = modp.b64_encode(DATA, out)
+        self.assertEqual(bytes(out[:n]), base64.b64encode(DATA))
+        n = modp.b64_decode(memoryview(out)[:n], out=out)
+        self.assertEqual(bytes(out[:n]), DATA)
+        self.assertRaises(ValueError, modp.b64_encode, DATA, bytearray(10))
+        self.assertRaises(BufferError, modp.b64_encode, DATA, b'read only')
+        self.assertRaises(TypeError, modp.b64_encode)
+        self.assertRaises(TypeError, modp.b64_encode, DATA, out=None, x=1)
+        self.assertEqual(modp.b64_encode(data=b'a'), b'YQ==')
+        self.assertRaises(KeyError, modp.max_len, 'nope', 1)
+
+    def test_kw_codecs(self):
+        self.assertEqual(modp.bjavascript_uencode('</a>\u2028'),
+                         b'<\\/a>\\u2028')
+        self.assertEqual(modp.bjavascript_uencode('</a>', flags=0), b'</a>')
+        self.assertEqual(modp.bjavascript_uencode('\xe9', flags=modp.JS_ESCAPE_NONASCII),
+                         b'\\u00E9')
+        self.assertEqual(modp.datauri_encode(b'hi', mime='text/plain'),
+                         b'data:text/plain;base64,aGk=')
+        uri = modp.datauri_encode(DATA, mime=b'image/png')
+        self.assertEqual(modp.datauri_decode(uri), (b'image/png', DATA))
+        self.assertEqual(modp.datauri_decode('data:,a%20b'), (b'', b'a b'))
+        out = bytearray(modp.max_len('datauri_encode', len(DATA), 9))
+        n = modp.datauri_encode(DATA, out, mime='image/png')
+        self.assertEqual(bytes(out[:n]), uri)
+        self.assertRaises(ValueError, modp.datauri_encode, DATA, bytearray(n),
+                          mime='image/png')
+        self.assertRaises(ValueError, modp.datauri_decode, b'http://x')
+        self.assertRaises(TypeError, modp.b64_encode, DATA, flags=0)
+        self.assertRaises(TypeError, modp.bjavascript_uencode, DATA, mime=b'')
+
+    def test_json_utf8(self):
+        text = 'a "b" \\ \n \x01 \x7f'
+        self.assertEqual(json.loads(modp.json_string(text)), text)
+        self.assertEqual(modp.json_string(b'\xff'), b'"\\u00FF"')
+        self.assertEqual(modp.utf8_validate(text), modp.UTF8_OK)
+        self.assertEqual(modp.utf8_validate(b'\xe2\x82'), modp.UTF8_SHORT)
+        self.assertEqual(modp.utf8_validate(b'\xc0\x80'), modp.UTF8_OVERLONG)
+
+    def test_errors(self):
+        self.assertRaises(ValueError, modp.b64_decode, b'!!!!')
+        self.assertRaises(ValueError, modp.b85_encode, b'abc')
+        self.assertRaises(ValueError, modp.b16_decode, b'zz')
+        # bytes over 0x7f in an entity, copied as they are
+        for bad in (b'&#\x80;', b'&#x\xff;', b'&#;', b'&#x;'):
+            self.assertEqual(modp.xml_decode(bad), bad)
+        modp.xml_decode(DATA)
+
+    def test_threads(self):
+        old = modp.gil_threshold(0)
+        try:
+            want = base64.b64encode(DATA)
+            bad = []
+
+            def work():
+                for _ in range(200):
+                    if modp.b64_encode(DATA) != want:
+                        bad.append(1)
+
+            threads = [threading.Thread(target=work) for _ in range(4)]
+            for t in threads:
+                t.start()
+            for t in threads:
+                t.join()
+            self.assertEqual(bad, [])
+        finally:
+            self.assertEqual(modp.gil_threshold(old), 0)
+
+
+if __name__ == '__main__':
+    unittest.main()
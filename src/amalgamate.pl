@@ -0,0 +1,304 @@
+#!/usr/bin/env perl
+#
+# amalgamate.pl -- write modp_inline.h, the whole library as static
+# inline functions in one header
+#
+#   perl amalgamate.pl [dir ...] > modp_inline.h
+#
+# Files are looked up in each dir in turn (default "."), so the
+# generated sources (modp_b64w.c, modp_*_data.h) must exist first.
+#
+# For each module the public header is copied with every prototype
+# marked MODP_FN, then the .c file with its private headers and tables
+# pasted in.  Private names (static tables and functions, #defines in
+# the .c and data files) are renamed per module, since modp_b64,
+# modp_b64w and modp_b64r all have tables called e0 and so on.
+#
+# Copyright 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+# Released under bsd license.  See modp_b64.c for details.
+#
+
+use strict;
+use warnings;
+
+my @modules = qw(
+    b2 b16 b64 b64w b64r b85 burl bjavascript
+    numtoa qsiter xml ascii utf8 html json messagepack
+    qp encword punycode datauri fuse pipeline iov alloc stats
+);
+
+my @dirs = @ARGV ? @ARGV : ('.');
+
+# installed headers that stay as #include
+my %keep = map { $_ => 1 } qw(
+    modp_stdint.h modp_cxx.h extern_c_begin.h extern_c_end.h
+);
+
+# module headers are pasted in before any code
+my %modhdr = map { ("modp_$_.h" => 1) } @modules;
+
+# private helpers shared by several modules, pasted once
+my @shared = qw(modp_swar.h modp_probe.h modp_escape.h modp_internal.h);
+my %shared = map { $_ => 1 } @shared;
+
+my %public;
+my %defined;
+# const data defined in a module, e.g. the codecs of modp_pipeline.c
+my %data;
+
+sub slurp {
+    my ($name) = @_;
+    foreach my $d (@dirs) {
+        my $path = "$d/$name";
+        if (-f $path) {
+            open(my $fh, '<', $path) or die "amalgamate.pl: $path: $!\n";
+            local $/;
+            my $text = <$fh>;
+            close($fh);
+            return $text;
+        }
+    }
+    die "amalgamate.pl: cannot find $name\n";
+}
+
+# drop editor mode lines and the license block, the output has one
+sub strip_boilerplate {
+    my ($text) = @_;
+    $text =~ s{^/\* (?:-\*-|vi:)[^\n]*\*/\n}{}mg;
+    $text =~ s{^\s*/\*(?:(?!\*/).)*?Copyright(?:(?!\*/).)*\*/\n}{}s;
+    return $text;
+}
+
+# call $fn on each line that starts outside of a comment or macro
+sub code_lines {
+    my ($text, $fn) = @_;
+    my @out;
+    my $incomment = 0;
+    my $inmacro = 0;
+    foreach my $line (split(/\n/, $text, -1)) {
+        if (!$incomment && !$inmacro) {
+            $line = $fn->($line);
+        }
+        $inmacro = ($line =~ /\\$/) ? 1 : 0;
+        my $scan = $line;
+        $scan =~ s{"(?:[^"\\]|\\.)*"}{""}g;
+        while ($scan =~ m{(/\*|\*/)}g) {
+            $incomment = ($1 eq '/*') ? 1 : 0;
+        }
+        push(@out, $line);
+    }
+    return join("\n", @out);
+}
+
+# a top level function declaration or definition: returns the name
+sub function_name {
+    my ($line) = @_;
+    return undef if $line =~ /^(?:typedef|extern|struct|union|enum|return|namespace|template|inline|else|case)\b/;
+    return $1 if $line =~ /^[A-Za-z_][\w \t*]*?\b([A-Za-z_]\w*)\s*\(/;
+    return undef;
+}
+
+sub header {
+    my ($m) = @_;
+    my $text = strip_boilerplate(slurp("modp_$m.h"));
+    $text =~ s{^#include "([^"]+)"[^\n]*\n}{$modhdr{$1} ? '' : "#include \"$1\"\n"}mge;
+    return code_lines($text, sub {
+        my ($line) = @_;
+        my $name = function_name($line);
+        # declared but not in the library: leave it extern
+        if (defined($name) && $defined{$name} && $line !~ /^static\b/) {
+            $public{$name} = 1;
+            $line = "MODP_FN $line";
+        }
+        # data is defined static further down, C++ can not declare it
+        # ahead
+        $line = '' if $line =~ /^extern const \w+ (\w+);/ && $data{$1};
+        return $line;
+    });
+}
+
+sub paste_includes {
+    my ($text, $seen) = @_;
+    $text =~ s{^#include "([^"]+)"[^\n]*\n}{
+        my $inc = $1;
+        ($inc eq 'config.h' || $modhdr{$inc} || $shared{$inc}) ? ''
+            : $keep{$inc} ? "#include \"$inc\"\n"
+            : $seen->{$inc}++ ? ''
+            : paste_includes(strip_boilerplate(slurp($inc)), $seen) . "\n"
+    }mge;
+    return $text;
+}
+
+sub implementation {
+    my ($m) = @_;
+    my $text = paste_includes(strip_boilerplate(slurp("modp_$m.c")), {});
+    my (%macros, %statics);
+
+    # C++ has no tentative definitions: move the table up to its
+    # forward declaration
+    while ($text =~ /^(static const \w+ (\w+)\[\];)\n/m) {
+        my ($decl, $name) = ($1, $2);
+        $text =~ s/^(static const \w+ \Q$name\E\[\] = \{.*?^\};\n)//ms
+            or die "amalgamate.pl: no definition for $name\n";
+        my $table = $1;
+        $text =~ s/^\Q$decl\E\n/$table/m;
+    }
+
+    code_lines($text, sub {
+        my ($line) = @_;
+        $macros{$1} = 1 if $line =~ /^#\s*define\s+([A-Za-z_]\w*)/;
+        $statics{$1} = 1 if $line =~ /^static\b[^=;(\[]*?\b([A-Za-z_]\w*)\s*[\[=(]/;
+        return $line;
+    });
+
+    my @renamed;
+    foreach my $name (sort keys %macros) {
+        next if $name =~ /^MODP_/;
+        my $to = 'MODP_' . uc($m) . "_$name";
+        $text =~ s/\b$name\b/$to/g;
+        push(@renamed, $to);
+    }
+    foreach my $name (sort keys %statics) {
+        next if $name =~ /^modp_/;
+        my $to = "modp_${m}_$name";
+        # the static run of modp_pipeline.c is not modp_pipeline_run
+        $to = "modp_${m}_static_$name" if $defined{$to};
+        $text =~ s/\b$name\b/$to/g;
+    }
+
+    $text = code_lines($text, sub {
+        my ($line) = @_;
+        if ($line =~ /^static\b[^=;\[]*\(/) {
+            $line =~ s/^static\b/MODP_FN/;
+        } elsif ($line =~ /^const \w+ (\w+) =/ && $data{$1}) {
+            $line = "static $line";
+        } elsif ($line !~ /^static\b/) {
+            my $name = function_name($line);
+            # the _impl of modp_b64w.c and modp_b64r.c are not declared
+            $line = "MODP_FN $line" if defined($name) &&
+                ($public{$name} || ($name =~ /_impl$/ && $line !~ /;\s*$/));
+        }
+        return $line;
+    });
+
+    $text .= "\n" . join('', map { "#undef $_\n" } @renamed);
+    return $text;
+}
+
+# a shared helper's functions are used by several modules, and the
+# uncounted entry points of modp_internal.h are declared once
+sub shared {
+    my ($name) = @_;
+    return code_lines(strip_boilerplate(slurp($name)), sub {
+        my ($line) = @_;
+        my $fn = function_name($line);
+        if ($line =~ /^static\b[^=;\[]*\(/) {
+            $line =~ s/^static\b/MODP_FN/;
+        } elsif (defined($fn) && $defined{$fn}) {
+            $public{$fn} = 1;
+            $line = "MODP_FN $line";
+        }
+        return $line;
+    });
+}
+
+foreach my $m (@modules) {
+    code_lines(slurp("modp_$m.c"), sub {
+        my ($line) = @_;
+        my $name = function_name($line);
+        $defined{$name} = 1 if defined($name) && $line !~ /;\s*$/;
+        $data{$1} = 1 if $line =~ /^const \w+ (\w+) =/;
+        return $line;
+    });
+}
+
+my $out = '';
+$out .= "/* ---- modp_$_.h ---- */\n" . header($_) . "\n" foreach @modules;
+$out .= "/* ---- $_ ---- */\n" . shared($_) . "\n" foreach @shared;
+$out .= "/* ---- modp_$_.c ---- */\n" . implementation($_) . "\n" foreach @modules;
+$out =~ s/\bWORDS_BIGENDIAN\b/MODP_WORDS_BIGENDIAN/g;
+$out =~ s/\bHAVE_(PTHREAD|UNISTD)_H\b/MODP_HAVE_$1_H/g;
+
+my $includes = join('', map { "#include \"modp_$_.h\"\n" } @modules);
+
+print <<"EOF";
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/* Generated by amalgamate.pl, do not edit */
+
+/**
+ * \\file modp_inline.h
+ * \\brief every stringencoders function in one header, optionally inline
+ *
+ * Without MODP_INLINE this header only includes the module headers,
+ * and the functions come from the library as usual.
+ *
+ * With MODP_INLINE defined before including it, every function is a
+ * static inline definition with its tables, and no library is needed
+ * (numtoa uses libm).  Calls with short or constant length inputs can
+ * then be inlined and constant folded.  Each translation unit gets
+ * its own copy of anything it uses.
+ *
+ * \\code
+ * #define MODP_INLINE
+ * #include "modp_inline.h"
+ * \\endcode
+ *
+ * The byte order comes from WORDS_BIGENDIAN if defined, else from
+ * __BYTE_ORDER__.
+ *
+ * modp_pipeline_run starts its worker threads only with
+ * MODP_INLINE_PTHREAD defined (link with -lpthread), else it codes on
+ * the calling thread.  modp_pipeline_fd needs unistd.h.
+ */
+
+/*
+ * <PRE>
+ * Copyright &copy; 2005-2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_INLINE
+#define COM_MODP_STRINGENCODERS_INLINE
+
+#ifndef MODP_INLINE
+
+$includes
+#else
+
+#if defined(__cplusplus) || (defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L)
+#define MODP_FN static inline
+#elif defined(__GNUC__) || defined(_MSC_VER)
+#define MODP_FN static __inline
+#else
+#define MODP_FN static
+#endif
+
+#if defined(WORDS_BIGENDIAN) || \\
+    (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define MODP_WORDS_BIGENDIAN 1
+#endif
+
+#ifdef MODP_INLINE_PTHREAD
+#define MODP_HAVE_PTHREAD_H 1
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#define MODP_HAVE_UNISTD_H 1
+#endif
+
+$out
+#undef MODP_FN
+#undef MODP_WORDS_BIGENDIAN
+#undef MODP_HAVE_PTHREAD_H
+#undef MODP_HAVE_UNISTD_H
+
+#endif  /* MODP_INLINE */
+
+#endif  /* COM_MODP_STRINGENCODERS_INLINE */
+EOF
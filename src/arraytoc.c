@@ -3,6 +3,7 @@
 
 #include "arraytoc.h"
 #include <stdio.h>
+#include <string.h>
 
 /* dump uint32_t as hex digits */
 void uint32_array_to_c_hex(const uint32_t* ary, size_t sz, const char* name)
@@ -84,3 +85,50 @@ void uint32_array_to_c(const uint32_t* ary, size_t sz, const char* name)
     }
     printf("\n};\n\n");
 }
+
+/**
+ * prints the two tables of an escaper for modp_escape.h: name##Len,
+ * the bytes each byte is written as (0 for as-is), and name##Esc,
+ * what they are.  esc[i] is NULL if byte i is copied as-is.
+ */
+void escape_array_to_c(const char* const* esc, const char* name)
+{
+    const char* e;
+    char tmp[2];
+    size_t i;
+    size_t n;
+
+    printf("static const uint8_t %sLen[256] = {\n", name);
+    for (i = 0; i < 256; ++i) {
+        n = esc[i] ? strlen(esc[i]) : 0;
+        printf("%u%s", (unsigned)n,
+               (i == 255) ? "\n" : (i % 16 == 15) ? ",\n" : ", ");
+    }
+    printf("};\n\n");
+
+    /*
+     * octal escapes, a hex one would run into a following digit, and
+     * no '?' for trigraphs
+     */
+    printf("static const char %sEsc[256][8] = {\n", name);
+    for (i = 0; i < 256; ++i) {
+        /* as-is bytes are themselves, so the whole word can be stored */
+        e = esc[i];
+        if (e == NULL) {
+            tmp[0] = (char) i;
+            tmp[1] = '\0';
+            e = tmp;
+        }
+        printf("\"");
+        for (; *e; ++e) {
+            if (*e >= ' ' && *e <= '~' && *e != '"' && *e != '\\' &&
+                *e != '?') {
+                printf("%c", *e);
+            } else {
+                printf("\\%03o", (unsigned)(uint8_t)*e);
+            }
+        }
+        printf("\"%s", (i == 255) ? "\n" : (i % 6 == 5) ? ",\n" : ", ");
+    }
+    printf("};\n\n");
+}
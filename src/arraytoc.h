@@ -43,4 +43,12 @@ void uint32_array_to_c_hex(const uint32_t* ary, size_t size, const char* name);
  */
 void char_array_to_c(const char* ary, size_t size, const char* name);
 
+/** \brief output the tables of an escaper, see modp_escape.h
+ *
+ * \param[in] esc 256 strings, what each byte is written as, or NULL
+ *   if it is copied as-is.  At most 7 chars each.
+ * \param[in] name the prefix of the two table names
+ */
+void escape_array_to_c(const char* const* esc, const char* name);
+
 #endif
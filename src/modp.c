@@ -0,0 +1,574 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/** \file modp.c
+ *
+ * Copyright 2026, Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ *
+ * modp, encode or decode a file or stdin with one of the codecs.
+ *
+ *   modp b64 < in > out
+ *   modp -d url -o out in
+ *
+ * A regular file is mmap-ed and cut into blocks (--block, 1M by
+ * default) which are encoded on -j threads at once, a round of one
+ * block per thread at a time, and written out in order.  A pipe goes
+ * through modp_pipeline_fd, which reads, codes and writes blocks on
+ * their own threads.  Either way the codec is called once per block
+ * and the output goes out in one write per block.
+ *
+ * Blocks are cut where the codec can start again: on a group boundary
+ * for the base-N codecs (3 bytes for b64 encode, 4 chars for decode,
+ * ...), and before an unfinished escape or UTF-8 sequence for the
+ * others.
+ *
+ * The output has no trailing newline.  The base-N decoders ignore one
+ * trailing newline on their input, so "echo ... | modp -d b64" works,
+ * but do not accept line wrapped input.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "config.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+#include "modp_b2.h"
+#include "modp_b16.h"
+#include "modp_b64.h"
+#include "modp_b64w.h"
+#include "modp_b64r.h"
+#include "modp_b85.h"
+#include "modp_burl.h"
+#include "modp_bjavascript.h"
+#include "modp_json.h"
+#include "modp_xml.h"
+#include "modp_pipeline.h"
+
+#define MAX_THREADS 64
+
+struct codec {
+    const char* name;
+    const char* desc;
+    const modp_pipeline_codec* enc;
+    /* NULL if the codec can not decode */
+    const modp_pipeline_codec* dec;
+};
+
+/*
+ * cut functions
+ */
+
+/* the decoders keep 2 chars back for a trailing newline */
+#define CUT_GROUP(name, n) \
+    static size_t name(const char* src, size_t len) \
+    { \
+        (void)src; \
+        return len < 2 ? 0 : (len - 2) / n * n; \
+    }
+
+CUT_GROUP(cut_2nl, 2)
+CUT_GROUP(cut_4nl, 4)
+CUT_GROUP(cut_5nl, 5)
+CUT_GROUP(cut_8nl, 8)
+
+/* before a UTF-8 sequence that is not complete */
+static size_t cut_utf8(const char* src, size_t len)
+{
+    const unsigned char* s = (const unsigned char*)src;
+    size_t i, need;
+
+    for (i = len; i > 0 && len - i < 4; --i) {
+        if ((s[i - 1] & 0xC0) != 0x80) {
+            /* the last lead or ascii byte */
+            need = (s[i - 1] >= 0xF0) ? 4 : (s[i - 1] >= 0xE0) ? 3 :
+                (s[i - 1] >= 0xC0) ? 2 : 1;
+            return (len - (i - 1) < need) ? i - 1 : len;
+        }
+    }
+    return len;
+}
+
+/*
+ * before the first '&' after the last ';'.  modp_xml_decode looks for
+ * the ';' of an '&' as far as it goes, and a numeric entity can have
+ * any number of leading zeros, so there is no limit on how far back.
+ */
+static size_t cut_xml(const char* src, size_t len)
+{
+    size_t i = len;
+    size_t amp = len;
+
+    while (i > 0 && src[i - 1] != ';') {
+        --i;
+        if (src[i] == '&') {
+            amp = i;
+        }
+    }
+    return amp;
+}
+
+static int is_hex(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+/*
+ * length of the javascript escape at src[0] == '\\', 0 if it runs past
+ * the end.  A high surrogate takes the low one with it.
+ */
+static size_t js_escape_len(const char* src, size_t len)
+{
+    size_t n;
+
+    if (len < 2) {
+        return 0;
+    }
+    switch (src[1]) {
+    case 'x':
+        return (len < 4) ? 0 : 4;
+    case '\r':
+        return (len < 3) ? 0 : (src[2] == '\n') ? 3 : 2;
+    case 'u':
+        if (len < 3) {
+            return 0;
+        }
+        if (src[2] == '{') {
+            for (n = 3; n < len && n < 16; ++n) {
+                if (src[n] == '}') {
+                    return n + 1;
+                }
+            }
+            return (n == len) ? 0 : 3;
+        }
+        if (len < 6) {
+            return 0;
+        }
+        if ((src[2] == 'd' || src[2] == 'D') &&
+            (src[3] == '8' || src[3] == '9' || src[3] == 'a' || src[3] == 'A' ||
+             src[3] == 'b' || src[3] == 'B') && is_hex(src[4]) && is_hex(src[5])) {
+            if (len < 8) {
+                return 0;
+            }
+            if (src[6] == '\\' && src[7] == 'u') {
+                return (len < 12) ? 0 : 12;
+            }
+        }
+        return 6;
+    default:
+        return 2;
+    }
+}
+
+/*
+ * before an escape that is not complete.  A backslash that does not
+ * follow a backslash always starts an escape, as no escape has a
+ * backslash after its first char, so parsing can start at the first
+ * such backslash near the end.  A run of backslashes is pairs of
+ * escapes from its start, so one reaching the last 64 bytes is parsed
+ * from there, however long it is.
+ */
+static size_t cut_js(const char* src, size_t len)
+{
+    size_t i = (len < 64) ? 0 : len - 64;
+    size_t n;
+
+    while (i > 0 && src[i - 1] == '\\') {
+        --i;
+    }
+
+    while (i < len && !(src[i] == '\\' && (i == 0 || src[i - 1] != '\\'))) {
+        ++i;
+    }
+    while (i < len) {
+        if (src[i] != '\\') {
+            ++i;
+            continue;
+        }
+        n = js_escape_len(src + i, len - i);
+        if (n == 0) {
+            return i;
+        }
+        i += n;
+    }
+    return len;
+}
+
+/*
+ * codecs that are not a plain library call
+ */
+
+static size_t strip_nl(const char* src, size_t len)
+{
+    if (len > 0 && src[len - 1] == '\n') {
+        --len;
+        if (len > 0 && src[len - 1] == '\r') {
+            --len;
+        }
+    }
+    return len;
+}
+
+/* the last block of a base-N decode, without a trailing newline */
+#define LAST_NL(name) \
+    static size_t name##_last(char* dest, const char* src, size_t len) \
+    { \
+        return modp_##name(dest, src, strip_nl(src, len)); \
+    }
+
+LAST_NL(b64_decode)
+LAST_NL(b64w_decode)
+LAST_NL(b64r_decode)
+LAST_NL(b16_decode)
+LAST_NL(b85_decode)
+LAST_NL(b2_decode)
+
+static size_t js_encode(char* dest, const char* src, size_t len)
+{
+    return modp_bjavascript_uencode(dest, src, len, 0);
+}
+
+/*
+ * the contents of a JSON string, without the quotes.  modp_json writes
+ * bytes over 0x7F as \u00XX, so this is not undone by "js -d" for
+ * UTF-8 input and there is no decoder.
+ */
+static size_t json_encode(char* dest, const char* src, size_t len)
+{
+    modp_json_ctx ctx;
+    size_t n;
+
+    modp_json_init(&ctx, dest);
+    modp_json_add_string(&ctx, src, len);
+    n = modp_json_end(&ctx) - 2;
+    memmove(dest, dest + 1, n);
+    return n;
+}
+
+/*
+ * the base-N decoders allow a trailing newline, the encoders and
+ * modp_pipeline_burl_decode are those of modp_pipeline.h
+ */
+static const modp_pipeline_codec b64_dec = { modp_b64_decode, b64_decode_last, cut_4nl, 4, 3 };
+static const modp_pipeline_codec b64w_dec = { modp_b64w_decode, b64w_decode_last, cut_4nl, 4, 3 };
+static const modp_pipeline_codec b64r_dec = { modp_b64r_decode, b64r_decode_last, cut_4nl, 4, 3 };
+static const modp_pipeline_codec b16_dec = { modp_b16_decode, b16_decode_last, cut_2nl, 2, 1 };
+static const modp_pipeline_codec b85_dec = { modp_b85_decode, b85_decode_last, cut_5nl, 5, 4 };
+static const modp_pipeline_codec b2_dec = { modp_b2_decode, b2_decode_last, cut_8nl, 8, 1 };
+static const modp_pipeline_codec js_enc = { js_encode, NULL, cut_utf8, 1, 4 };
+static const modp_pipeline_codec js_dec = { modp_bjavascript_decode, NULL, cut_js, 1, 1 };
+static const modp_pipeline_codec json_enc = { json_encode, NULL, NULL, 1, 6 };
+static const modp_pipeline_codec xml_enc = { modp_xml_encode, NULL, NULL, 1, 6 };
+static const modp_pipeline_codec xml_dec = { modp_xml_decode, NULL, cut_xml, 1, 1 };
+
+static const struct codec codecs[] = {
+    { "b64", "base64, RFC 4648 alphabet", &modp_pipeline_b64_encode, &b64_dec },
+    { "b64w", "base64, web alphabet (configure --with-b64wchars)",
+      &modp_pipeline_b64w_encode, &b64w_dec },
+    { "b64r", "base64, RFC 4648 url safe alphabet", &modp_pipeline_b64r_encode, &b64r_dec },
+    { "b16", "hex", &modp_pipeline_b16_encode, &b16_dec },
+    { "b85", "base85, input a multiple of 4 bytes", &modp_pipeline_b85_encode, &b85_dec },
+    { "b2", "binary, \"0\" and \"1\"", &modp_pipeline_b2_encode, &b2_dec },
+    { "url", "url (form) escaping", &modp_pipeline_burl_encode, &modp_pipeline_burl_decode },
+    { "js", "javascript string escaping, UTF-8 kept", &js_enc, &js_dec },
+    { "json", "JSON string escaping, without the quotes, encode only", &json_enc, NULL },
+    { "xml", "XML escaping", &xml_enc, &xml_dec }
+};
+
+#define NCODECS (sizeof(codecs) / sizeof(codecs[0]))
+
+static const char* outname = "stdout";
+
+static size_t out_size(const modp_pipeline_codec* d, size_t len)
+{
+    return (len + d->group - 1) / d->group * d->group_out + 3;
+}
+
+static int write_all(int fd, const char* buf, size_t len)
+{
+    ssize_t n;
+
+    while (len > 0) {
+        n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror(outname);
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+/* one block of a round */
+struct job {
+    const modp_pipeline_codec* d;
+    const char* src;
+    size_t len;
+    char* out;
+    size_t outlen;
+    int last;
+#ifdef HAVE_PTHREAD_H
+    pthread_t thread;
+#endif
+};
+
+static void* run_job(void* arg)
+{
+    struct job* j = (struct job*)arg;
+    modp_pipeline_fn fn = (j->last && j->d->last) ? j->d->last : j->d->fn;
+    j->outlen = fn(j->out, j->src, j->len);
+    return NULL;
+}
+
+/* code all of src, nthreads blocks at a time */
+static int code_mapped(const modp_pipeline_codec* d, const char* src, size_t len,
+                       size_t block, size_t nthreads, int fd)
+{
+    struct job jobs[MAX_THREADS];
+    size_t i, k, n, pos = 0;
+    int rc = 0;
+
+    for (i = 0; i < nthreads; ++i) {
+        jobs[i].d = d;
+        jobs[i].out = (char*)malloc(out_size(d, block));
+        if (jobs[i].out == NULL) {
+            fprintf(stderr, "modp: out of memory\n");
+            nthreads = i;
+            rc = -1;
+        }
+    }
+
+    while (rc == 0 && pos < len) {
+        for (k = 0; k < nthreads && pos < len; ++k) {
+            n = len - pos;
+            if (n > block) {
+                n = d->cut ? d->cut(src + pos, block) : block / d->group * d->group;
+                if (n == 0) {
+                    n = block;
+                }
+            }
+            jobs[k].src = src + pos;
+            jobs[k].len = n;
+            jobs[k].last = (pos + n == len);
+            pos += n;
+        }
+#ifdef HAVE_PTHREAD_H
+        for (i = 1; i < k; ++i) {
+            if (pthread_create(&jobs[i].thread, NULL, run_job, &jobs[i]) != 0) {
+                /* do it here instead */
+                jobs[i].thread = pthread_self();
+            }
+        }
+        run_job(&jobs[0]);
+        for (i = 1; i < k; ++i) {
+            if (pthread_equal(jobs[i].thread, pthread_self())) {
+                run_job(&jobs[i]);
+            } else {
+                pthread_join(jobs[i].thread, NULL);
+            }
+        }
+#else
+        for (i = 0; i < k; ++i) {
+            run_job(&jobs[i]);
+        }
+#endif
+        for (i = 0; rc == 0 && i < k; ++i) {
+            if (jobs[i].outlen == (size_t)-1) {
+                fprintf(stderr, "modp: invalid input near byte %lu\n",
+                        (unsigned long)(jobs[i].src - src));
+                rc = 1;
+            } else if (write_all(fd, jobs[i].out, jobs[i].outlen) != 0) {
+                rc = -1;
+            }
+        }
+    }
+    for (i = 0; i < nthreads; ++i) {
+        free(jobs[i].out);
+    }
+    return rc;
+}
+
+/* code a pipe on nthreads workers */
+static int code_stream(const modp_pipeline_codec* d, int in, const char* inname,
+                       size_t block, size_t nthreads, int fd)
+{
+    size_t at = 0;
+
+    switch (modp_pipeline_fd(d, in, fd, block, nthreads, &at)) {
+    case MODP_PIPELINE_OK:
+        return 0;
+    case MODP_PIPELINE_EREAD:
+        perror(inname);
+        break;
+    case MODP_PIPELINE_EWRITE:
+        perror(outname);
+        break;
+    case MODP_PIPELINE_EINPUT:
+        fprintf(stderr, "modp: invalid input near byte %lu\n", (unsigned long)at);
+        break;
+    default:
+        fprintf(stderr, "modp: out of memory\n");
+        break;
+    }
+    return 1;
+}
+
+static size_t parse_size(const char* s)
+{
+    char* end;
+    double v = strtod(s, &end);
+    switch (*end) {
+    case 'k': case 'K': v *= 1024.0; break;
+    case 'm': case 'M': v *= 1024.0 * 1024.0; break;
+    case 'g': case 'G': v *= 1024.0 * 1024.0 * 1024.0; break;
+    default: break;
+    }
+    return (size_t)v;
+}
+
+static size_t cpus(void)
+{
+#ifdef _SC_NPROCESSORS_ONLN
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (size_t)n : 1;
+#else
+    return 1;
+#endif
+}
+
+static void usage(void)
+{
+    size_t i;
+
+    printf("usage: modp [options] CODEC [FILE]\n"
+           "encode (or decode) FILE, or stdin, to stdout\n"
+           "  -d, --decode       decode\n"
+           "  -o FILE            write to FILE\n"
+           "  -j N               threads (default: the cpus)\n"
+           "  --block=N          bytes coded per call, K/M suffixes allowed\n"
+           "                     (default 1M)\n"
+           "  -l, --list         list the codecs\n"
+           "codecs:\n");
+    for (i = 0; i < NCODECS; ++i) {
+        printf("  %-6s %s\n", codecs[i].name, codecs[i].desc);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const struct codec* c = NULL;
+    const modp_pipeline_codec* d;
+    const char* inname = NULL;
+    const char* a;
+    size_t i, block = (size_t)1 << 20, nthreads = 0;
+    int decode = 0, in = 0, out = 1, rc;
+    struct stat st;
+    void* map;
+
+    for (i = 1; i < (size_t)argc; ++i) {
+        a = argv[i];
+        if (strcmp(a, "-d") == 0 || strcmp(a, "--decode") == 0) {
+            decode = 1;
+        } else if (strcmp(a, "-h") == 0 || strcmp(a, "--help") == 0) {
+            usage();
+            return 0;
+        } else if (strcmp(a, "-l") == 0 || strcmp(a, "--list") == 0) {
+            for (i = 0; i < NCODECS; ++i) {
+                printf("%s\n", codecs[i].name);
+            }
+            return 0;
+        } else if (strcmp(a, "-o") == 0 && i + 1 < (size_t)argc) {
+            outname = argv[++i];
+        } else if (strcmp(a, "-j") == 0 && i + 1 < (size_t)argc) {
+            nthreads = (size_t)atoi(argv[++i]);
+        } else if (strncmp(a, "--block=", 8) == 0) {
+            block = parse_size(a + 8);
+        } else if (a[0] == '-' && a[1] != '\0') {
+            fprintf(stderr, "modp: unknown option %s\n", a);
+            return 2;
+        } else if (c == NULL) {
+            for (c = codecs; c < codecs + NCODECS && strcmp(c->name, a) != 0; ++c) {
+            }
+            if (c == codecs + NCODECS) {
+                fprintf(stderr, "modp: unknown codec %s, see modp --list\n", a);
+                return 2;
+            }
+        } else if (inname == NULL) {
+            inname = a;
+        } else {
+            fprintf(stderr, "modp: more than one input file\n");
+            return 2;
+        }
+    }
+    if (c == NULL) {
+        usage();
+        return 2;
+    }
+    d = decode ? c->dec : c->enc;
+    if (d == NULL) {
+        fprintf(stderr, "modp: %s can not decode\n", c->name);
+        return 2;
+    }
+    if (block < 4096) {
+        block = 4096;
+    }
+    if (nthreads == 0) {
+        nthreads = cpus();
+    }
+    if (nthreads > MAX_THREADS) {
+        nthreads = MAX_THREADS;
+    }
+
+    if (inname != NULL && strcmp(inname, "-") != 0) {
+        in = open(inname, O_RDONLY);
+        if (in < 0) {
+            perror(inname);
+            return 1;
+        }
+    } else {
+        inname = "stdin";
+    }
+    if (strcmp(outname, "stdout") != 0 && strcmp(outname, "-") != 0) {
+        out = open(outname, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if (out < 0) {
+            perror(outname);
+            return 1;
+        }
+    } else {
+        outname = "stdout";
+    }
+
+    if (fstat(in, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+        (map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, in, 0)) != MAP_FAILED) {
+        posix_madvise(map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+        rc = code_mapped(d, (const char*)map, (size_t)st.st_size, block, nthreads, out);
+        munmap(map, (size_t)st.st_size);
+    } else {
+        rc = code_stream(d, in, inname, block, nthreads, out);
+    }
+    if (out != 1 && close(out) != 0) {
+        perror(outname);
+        rc = -1;
+    }
+    return rc != 0;
+}
@@ -0,0 +1,201 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+/**
+ * \file modp_alloc.c
+ * <PRE>
+ * MODP_ALLOC - allocator hooks and bump arena
+ * http://code.google.com/p/stringencoders/
+ *
+ * Copyright &copy; 2026  Nick Galbreath -- nickg [at] modp [dot] com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the modp.com nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This is the standard "new" BSD license:
+ * http://www.opensource.org/licenses/bsd-license.php
+ * </PRE>
+ */
+
+#include "config.h"
+#include "modp_alloc.h"
+#include <stdlib.h>
+
+/* header of each block from the parent, the data follows */
+struct modp_arena_block {
+    struct modp_arena_block* next;
+    size_t size;
+};
+
+#define BLOCK_HEADER sizeof(struct modp_arena_block)
+
+void* modp_allocate(const modp_allocator_t* a, size_t size, size_t align)
+{
+    if (a != NULL) {
+        return a->allocate(a->state, size, align);
+    }
+    return malloc(size ? size : 1);
+}
+
+void modp_deallocate(const modp_allocator_t* a, void* ptr, size_t size,
+                     size_t align)
+{
+    if (a != NULL) {
+        a->deallocate(a->state, ptr, size, align);
+    } else {
+        free(ptr);
+    }
+}
+
+void modp_arena_init(modp_arena_t* arena, void* buf, size_t buflen,
+                     const modp_allocator_t* parent)
+{
+    arena->buf = (char*)buf;
+    arena->buflen = buf ? buflen : 0;
+    arena->cur = arena->buf;
+    arena->end = arena->buf + arena->buflen;
+    arena->blocks = NULL;
+    arena->spare = NULL;
+    arena->parent = parent;
+    arena->used = 0;
+}
+
+/* make the current block one with at least need free bytes */
+static int arena_grow(modp_arena_t* arena, size_t need)
+{
+    struct modp_arena_block* b = arena->spare;
+    size_t total;
+
+    if (need > (size_t)-1 - BLOCK_HEADER) {
+        return 0;
+    }
+    total = need + BLOCK_HEADER;
+    if (total < MODP_ARENA_BLOCK_SIZE) {
+        total = MODP_ARENA_BLOCK_SIZE;
+    }
+
+    if (b != NULL && b->size >= total) {
+        arena->spare = NULL;
+    } else {
+        b = (struct modp_arena_block*)modp_allocate(arena->parent, total,
+                                                    sizeof(void*));
+        if (b == NULL) {
+            return 0;
+        }
+        b->size = total;
+    }
+    b->next = arena->blocks;
+    arena->blocks = b;
+    arena->cur = (char*)b + BLOCK_HEADER;
+    arena->end = (char*)b + b->size;
+    return 1;
+}
+
+void* modp_arena_alloc(modp_arena_t* arena, size_t size, size_t align)
+{
+    size_t pad;
+    size_t avail;
+    char* p;
+
+    if (align == 0) {
+        align = 1;
+    }
+
+    for (;;) {
+        if (arena->cur != NULL) {
+            pad = (0 - (size_t)arena->cur) & (align - 1);
+            avail = (size_t)(arena->end - arena->cur);
+            if (avail >= pad && avail - pad >= size) {
+                p = arena->cur + pad;
+                arena->cur = p + size;
+                arena->used += pad + size;
+                return p;
+            }
+        }
+        if (size > (size_t)-1 - align || !arena_grow(arena, size + align - 1)) {
+            return NULL;
+        }
+    }
+}
+
+void modp_arena_reset(modp_arena_t* arena)
+{
+    struct modp_arena_block* b = arena->blocks;
+    struct modp_arena_block* next;
+
+    while (b != NULL) {
+        next = b->next;
+        if (arena->spare == NULL && b->size == MODP_ARENA_BLOCK_SIZE) {
+            arena->spare = b;
+        } else {
+            modp_deallocate(arena->parent, b, b->size, sizeof(void*));
+        }
+        b = next;
+    }
+    arena->blocks = NULL;
+    arena->cur = arena->buf;
+    arena->end = arena->buf + arena->buflen;
+    arena->used = 0;
+}
+
+void modp_arena_destroy(modp_arena_t* arena)
+{
+    modp_arena_reset(arena);
+    if (arena->spare != NULL) {
+        modp_deallocate(arena->parent, arena->spare, arena->spare->size,
+                        sizeof(void*));
+        arena->spare = NULL;
+    }
+}
+
+size_t modp_arena_used(const modp_arena_t* arena)
+{
+    return arena->used;
+}
+
+static void* arena_allocate(void* state, size_t size, size_t align)
+{
+    return modp_arena_alloc((modp_arena_t*)state, size, align);
+}
+
+static void arena_deallocate(void* state, void* ptr, size_t size,
+                             size_t align)
+{
+    (void)state;
+    (void)ptr;
+    (void)size;
+    (void)align;
+}
+
+modp_allocator_t modp_arena_allocator(modp_arena_t* arena)
+{
+    modp_allocator_t a;
+    a.allocate = arena_allocate;
+    a.deallocate = arena_deallocate;
+    a.state = arena;
+    return a;
+}
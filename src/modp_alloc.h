@@ -0,0 +1,282 @@
+/* -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_alloc.h
+ * \brief pluggable allocators and a bump arena
+ *
+ * The C functions in this library never allocate, the caller passes
+ * the output buffer (sized with the _len macros).  Memory is only
+ * allocated by the caller, and by the C++ wrappers and writers.  This
+ * header lets both come from the same place:
+ *
+ * - modp_allocator_t is a C allocator: two function pointers and a
+ *   state pointer.  Anywhere one is taken, NULL means malloc and free.
+ *
+ * - modp_arena_t is a bump allocator for per-request memory.  Each
+ *   allocation is a pointer increment, nothing is freed on its own,
+ *   and modp_arena_reset drops everything at once.  It starts in an
+ *   optional caller buffer (e.g. on the stack) and gets more blocks
+ *   from a parent modp_allocator_t when that is used up.
+ *
+ * - In C++17, modp::arena and modp::allocator_resource are
+ *   std::pmr::memory_resource objects, so they work with std::pmr
+ *   containers, the codec overloads that return a std::pmr::string,
+ *   and modp::pmr::JsonWriter / modp::pmr::MsgpackWriter.
+ *
+ * \code
+ * char stack[4096];
+ * modp_arena_t arena;
+ * modp_arena_init(&arena, stack, sizeof(stack), NULL);
+ * for (each request) {
+ *     char* out = modp_arena_alloc(&arena, modp_b64_encode_len(len), 1);
+ *     modp_b64_encode(out, src, len);
+ *     ...
+ *     modp_arena_reset(&arena);
+ * }
+ * modp_arena_destroy(&arena);
+ * \endcode
+ *
+ * An arena is not thread safe, use one per thread or per request.
+ */
+
+/*
+ * <PRE>
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_ALLOC
+#define COM_MODP_STRINGENCODERS_ALLOC
+
+#include "modp_stdint.h"
+#include "extern_c_begin.h"
+
+/**
+ * \brief a C allocator
+ *
+ * allocate returns size bytes aligned to align (a power of 2), or
+ * NULL.  deallocate gets back the same size and align.  state is
+ * passed to both.
+ */
+typedef struct modp_allocator {
+    void* (*allocate)(void* state, size_t size, size_t align);
+    void (*deallocate)(void* state, void* ptr, size_t size, size_t align);
+    void* state;
+} modp_allocator_t;
+
+/**
+ * \brief allocate from a modp_allocator_t
+ *
+ * \param[in] a the allocator, or NULL for malloc.  malloc supports
+ *   alignment up to that of any standard type.
+ * \return the memory, or NULL
+ */
+void* modp_allocate(const modp_allocator_t* a, size_t size, size_t align);
+
+/**
+ * \brief return memory from modp_allocate
+ * \param[in] a the same allocator, or NULL for free
+ */
+void modp_deallocate(const modp_allocator_t* a, void* ptr, size_t size,
+                     size_t align);
+
+/**
+ * Size of the blocks an arena gets from its parent.  Larger requests
+ * get a block of their own.
+ */
+#define MODP_ARENA_BLOCK_SIZE 8192
+
+struct modp_arena_block;
+
+/**
+ * \brief bump arena state
+ *
+ * The fields are private, use the modp_arena functions.
+ */
+typedef struct modp_arena {
+    char* cur;
+    char* end;
+    char* buf;
+    size_t buflen;
+    struct modp_arena_block* blocks;
+    struct modp_arena_block* spare;
+    const modp_allocator_t* parent;
+    size_t used;
+} modp_arena_t;
+
+/**
+ * \brief set up an arena
+ *
+ * \param[out] arena the arena
+ * \param[in] buf memory to use first, or NULL.  It is not freed.
+ * \param[in] buflen size of buf
+ * \param[in] parent where more blocks come from, NULL for malloc
+ */
+void modp_arena_init(modp_arena_t* arena, void* buf, size_t buflen,
+                     const modp_allocator_t* parent);
+
+/**
+ * \brief allocate from an arena
+ *
+ * \param[in] arena the arena
+ * \param[in] size bytes needed, may be 0
+ * \param[in] align alignment, a power of 2
+ * \return the memory, or NULL if the parent allocator failed
+ */
+void* modp_arena_alloc(modp_arena_t* arena, size_t size, size_t align);
+
+/**
+ * \brief free everything allocated from an arena
+ *
+ * One block of MODP_ARENA_BLOCK_SIZE is kept for reuse, so an arena
+ * that is reset once per request and stays under that size (plus the
+ * caller buffer) settles at no parent calls at all.
+ */
+void modp_arena_reset(modp_arena_t* arena);
+
+/**
+ * \brief return all blocks to the parent allocator
+ *
+ * The arena can be used again after modp_arena_init.
+ */
+void modp_arena_destroy(modp_arena_t* arena);
+
+/**
+ * \brief bytes handed out since the last reset, including padding
+ */
+size_t modp_arena_used(const modp_arena_t* arena);
+
+/**
+ * \brief a modp_allocator_t that allocates from an arena
+ *
+ * deallocate does nothing, memory comes back on modp_arena_reset.
+ * The arena must outlive any use of the result.
+ */
+modp_allocator_t modp_arena_allocator(modp_arena_t* arena);
+
+#include "extern_c_end.h"
+
+#ifdef __cplusplus
+#include <new>
+#include "modp_cxx.h"
+
+namespace modp {
+
+    /**
+     * \brief RAII owner of a modp_arena_t
+     *
+     * In C++17 this is a std::pmr::memory_resource:
+     *
+     * \code
+     * modp::arena a;
+     * std::pmr::string s = modp::b64_encode(input, &a);
+     * modp::pmr::JsonWriter w(&a);
+     * ...
+     * a.reset();   // s and the writer output are gone
+     * \endcode
+     *
+     * alloc throws std::bad_alloc if the parent allocator fails.
+     */
+    class arena
+#ifdef MODP_HAS_PMR
+        : public std::pmr::memory_resource
+#endif
+    {
+    public:
+        explicit arena(const modp_allocator_t* parent = NULL)
+        {
+            modp_arena_init(&a_, NULL, 0, parent);
+        }
+
+        arena(void* buf, size_t len, const modp_allocator_t* parent = NULL)
+        {
+            modp_arena_init(&a_, buf, len, parent);
+        }
+
+        ~arena() { modp_arena_destroy(&a_); }
+
+        void* alloc(size_t size, size_t align = sizeof(void*))
+        {
+            void* p = modp_arena_alloc(&a_, size, align);
+            if (p == NULL) {
+                throw std::bad_alloc();
+            }
+            return p;
+        }
+
+        void reset() { modp_arena_reset(&a_); }
+        size_t used() const { return modp_arena_used(&a_); }
+
+        /** the C arena, e.g. for modp_arena_allocator */
+        modp_arena_t* get() { return &a_; }
+
+    private:
+        arena(const arena&);
+        arena& operator=(const arena&);
+
+#ifdef MODP_HAS_PMR
+        void* do_allocate(size_t size, size_t align) override
+        {
+            return alloc(size, align);
+        }
+
+        void do_deallocate(void*, size_t, size_t) override {}
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+#endif
+
+        modp_arena_t a_;
+    };
+
+#ifdef MODP_HAS_PMR
+    /**
+     * \brief a std::pmr::memory_resource over a C modp_allocator_t
+     *
+     * The allocator must outlive the resource.  NULL uses malloc.
+     */
+    class allocator_resource : public std::pmr::memory_resource {
+    public:
+        explicit allocator_resource(const modp_allocator_t* a) : a_(a) {}
+
+    private:
+        void* do_allocate(size_t size, size_t align) override
+        {
+            void* p = modp_allocate(a_, size, align);
+            if (p == NULL) {
+                throw std::bad_alloc();
+            }
+            return p;
+        }
+
+        void do_deallocate(void* p, size_t size, size_t align) override
+        {
+            modp_deallocate(a_, p, size, align);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            const allocator_resource* o = dynamic_cast<const allocator_resource*>(&other);
+            if (o == NULL || a_ == NULL || o->a_ == NULL) {
+                return o != NULL && o->a_ == a_;
+            }
+            return o->a_->allocate == a_->allocate && o->a_->state == a_->state;
+        }
+
+        const modp_allocator_t* a_;
+    };
+#endif
+
+}       /* namespace modp */
+
+#endif  /* __cplusplus */
+
+#endif  /* COM_MODP_STRINGENCODERS_ALLOC */
@@ -43,10 +43,12 @@
  */
 #include "config.h"
 #include "modp_b16.h"
+#include "modp_stats.h"
+#include "modp_probe.h"
 #include "modp_stdint.h"
 #include "modp_b16_data.h"
 
-size_t modp_b16_encode(char* dest, const char* str, size_t len)
+static size_t b16_encode_impl(char* dest, const char* str, size_t len)
 {
     size_t i;
     const size_t buckets = len >> 2; /* i.e. i / 4 */
@@ -112,7 +114,7 @@ size_t modp_b16_encode(char* dest, const char* str, size_t len)
     return  (size_t)(p - (uint8_t*) dest);
 }
 
-size_t modp_b16_decode(char* dest, const char* str, size_t len)
+static size_t b16_decode_impl(char* dest, const char* str, size_t len)
 {
     size_t i;
     uint8_t t0,t1,t2,t3;
@@ -152,3 +154,13 @@ size_t modp_b16_decode(char* dest, const char* str, size_t len)
 
     return (size_t)(p - (uint8_t*)dest);
 }
+
+size_t modp_b16_encode(char* dest, const char* str, size_t len)
+{
+    MODP_COUNTED_SIZE(b16_encode, b16_encode_impl(dest, str, len), len);
+}
+
+size_t modp_b16_decode(char* dest, const char* str, size_t len)
+{
+    MODP_COUNTED_SIZE(b16_decode, b16_decode_impl(dest, str, len), len);
+}
@@ -71,18 +71,17 @@ size_t modp_b16_decode(char* dest, const char* src, size_t len);
 #ifdef __cplusplus
 #include <cstring>
 #include <string>
+#include "modp_cxx.h"
 
 namespace modp {
 
+    MODP_CXX_CODEC(b16_encode, modp_b16_encode, modp_b16_encode_len(len))
+    MODP_CXX_CODEC(b16_decode, modp_b16_decode, len / 2 + 1)
+
     inline std::string b16_encode(const char* s, size_t len)
     {
-        std::string x(modp_b16_encode_len(len), '\0');
-        size_t d = modp_b16_encode(const_cast<char*>(x.data()), s, len);
-        if (d == (size_t)-1) {
-            x.clear();
-        } else {
-            x.erase(d, std::string::npos);
-        }
+        std::string x;
+        b16_encode_append(x, s, len);
         return x;
     }
 
@@ -110,13 +109,8 @@ namespace modp {
 
     inline std::string b16_decode(const char* s, size_t len)
     {
-        std::string x(len / 2 + 1, '\0');
-        size_t d = modp_b16_decode(const_cast<char*>(x.data()), s, len);
-        if (d == (size_t)-1) {
-            x.clear();
-        } else {
-            x.erase(d, std::string::npos);
-        }
+        std::string x;
+        b16_decode_append(x, s, len);
         return x;
     }
 
@@ -44,11 +44,13 @@
 #include <string.h>
 #include "config.h"
 #include "modp_b2.h"
+#include "modp_stats.h"
+#include "modp_probe.h"
 #include "modp_stdint.h"
 #include "modp_b2_data.h"
 
 
-size_t modp_b2_encode(char* dest, const char* str, size_t len)
+static size_t b2_encode_impl(char* dest, const char* str, size_t len)
 {
     const uint8_t* orig = (const uint8_t*) str;
 #if 0
@@ -72,7 +74,7 @@ size_t modp_b2_encode(char* dest, const char* str, size_t len)
     return  len*8;
 }
 
-size_t modp_b2_decode(char* dest, const char* str, size_t len)
+static size_t b2_decode_impl(char* dest, const char* str, size_t len)
 {
     char d;
     size_t i;
@@ -96,3 +98,13 @@ size_t modp_b2_decode(char* dest, const char* str, size_t len)
 
     return buckets;
 }
+
+size_t modp_b2_encode(char* dest, const char* str, size_t len)
+{
+    MODP_COUNTED_SIZE(b2_encode, b2_encode_impl(dest, str, len), len);
+}
+
+size_t modp_b2_decode(char* dest, const char* str, size_t len)
+{
+    MODP_COUNTED_SIZE(b2_decode, b2_decode_impl(dest, str, len), len);
+}
@@ -68,9 +68,27 @@ size_t modp_b2_decode(char* dest, const char* src, size_t len);
 #include "extern_c_end.h"
 
 #ifdef __cplusplus
+#include <cstring>
 #include <string>
+#include "modp_cxx.h"
 
 namespace modp {
+
+    MODP_CXX_CODEC(b2_encode, modp_b2_encode, modp_b2_encode_len(len))
+    MODP_CXX_CODEC(b2_decode, modp_b2_decode, len / 8 + 1)
+
+    inline std::string b2_encode(const char* s, size_t len)
+    {
+        std::string x;
+        b2_encode_append(x, s, len);
+        return x;
+    }
+
+    inline std::string b2_encode(const char* s)
+    {
+        return b2_encode(s, strlen(s));
+    }
+
     /**
      * hex encode a string (self-modified)
      * \param[in,out] s the input string to be encoded
@@ -78,13 +96,7 @@ namespace modp {
      */
     inline std::string& b2_encode(std::string& s)
     {
-        std::string x(modp_b2_encode_len(s.size()), '\0');
-        size_t d = modp_b2_encode(const_cast<char*>(x.data()), s.data(), s.size());
-        if (d == (size_t)-1) {
-            x.clear();
-        } else {
-            x.erase(d, std::string::npos);
-        }
+        std::string x(b2_encode(s.data(), s.size()));
         s.swap(x);
         return s;
     }
@@ -96,9 +108,7 @@ namespace modp {
      */
     inline std::string b2_encode(const std::string& s)
     {
-        std::string str(s);
-        b2_encode(str);
-        return str;
+        return b2_encode(s.data(), s.size());
     }
 
     /**
@@ -119,6 +129,18 @@ namespace modp {
         return s;
     }
 
+    inline std::string b2_decode(const char* s, size_t len)
+    {
+        std::string x;
+        b2_decode_append(x, s, len);
+        return x;
+    }
+
+    inline std::string b2_decode(const char* s)
+    {
+        return b2_decode(s, strlen(s));
+    }
+
     inline std::string b2_decode(const std::string& s)
     {
         std::string x(s);
@@ -49,6 +49,9 @@
 
 /* public header */
 #include "modp_b64.h"
+#include "modp_stats.h"
+#include "modp_probe.h"
+#include "modp_internal.h"
 
 /* if on motoral, sun, ibm; uncomment this */
 /* #define WORDS_BIGENDIAN 1 */
@@ -76,7 +79,7 @@
 #define CHARPAD '\0'
 #endif
 
-size_t modp_b64_encode(char* dest, const char* str, size_t len)
+size_t modp_b64_encode_impl(char* dest, const char* str, size_t len)
 {
     size_t i = 0;
     const uint8_t* s = (const uint8_t*) str;
@@ -120,7 +123,7 @@ size_t modp_b64_encode(char* dest, const char* str, size_t len)
 }
 
 #ifdef WORDS_BIGENDIAN   /* BIG ENDIAN -- SUN / IBM / MOTOROLA */
-size_t modp_b64_decode(char* dest, const char* src, size_t len)
+size_t modp_b64_decode_impl(char* dest, const char* src, size_t len)
 {
     size_t i;
     if (len == 0) return 0;
@@ -190,7 +193,7 @@ size_t modp_b64_decode(char* dest, const char* src, size_t len)
 
 #else /* LITTLE  ENDIAN -- INTEL AND FRIENDS */
 
-size_t modp_b64_decode(char* dest, const char* src, size_t len)
+size_t modp_b64_decode_impl(char* dest, const char* src, size_t len)
 {
     size_t i;
     size_t leftover;
@@ -199,8 +202,8 @@ size_t modp_b64_decode(char* dest, const char* src, size_t len)
     uint8_t* p;
     uint32_t x;
     uint32_t* destInt;
-    const uint32_t* srcInt = (const uint32_t*) src;
-    uint32_t y = *srcInt++;
+    const uint32_t* srcInt;
+    uint32_t y;
 
     if (len == 0) return 0;
 
@@ -285,3 +288,13 @@ size_t modp_b64_decode(char* dest, const char* src, size_t len)
 }
 
 #endif  /* if bigendian / else / endif */
+
+size_t modp_b64_encode(char* dest, const char* str, size_t len)
+{
+    MODP_COUNTED_SIZE(b64_encode, modp_b64_encode_impl(dest, str, len), len);
+}
+
+size_t modp_b64_decode(char* dest, const char* src, size_t len)
+{
+    MODP_COUNTED_SIZE(b64_decode, modp_b64_decode_impl(dest, src, len), len);
+}
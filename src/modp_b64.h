@@ -135,8 +135,13 @@ size_t modp_b64_decode(char* dest, const char* src, size_t len);
 #ifdef __cplusplus
 #include <cstring>
 #include <string>
+#include "modp_cxx.h"
 
 namespace modp {
+
+    MODP_CXX_CODEC(b64_encode, modp_b64_encode, modp_b64_encode_len(len))
+    MODP_CXX_CODEC(b64_decode, modp_b64_decode, modp_b64_decode_len(len) + 1)
+
     /** \brief b64 encode a cstr with len
      *
      * \param[in] s the input string to encode
@@ -145,13 +150,8 @@ namespace modp {
      */
     inline std::string b64_encode(const char* s, size_t len)
     {
-        std::string x(modp_b64_encode_len(len), '\0');
-        size_t d = modp_b64_encode(const_cast<char*>(x.data()), s, len);
-        if (d == (size_t)-1) {
-            x.clear();
-        } else {
-            x.erase(d, std::string::npos);
-        }
+        std::string x;
+        b64_encode_append(x, s, len);
         return x;
     }
 
@@ -192,13 +192,8 @@ namespace modp {
 
     inline std::string b64_decode(const char* src, size_t len)
     {
-        std::string x(modp_b64_decode_len(len)+1, '\0');
-        size_t d = modp_b64_decode(const_cast<char*>(x.data()), src, len);
-        if (d == (size_t)-1) {
-            x.clear();
-        } else {
-            x.erase(d, std::string::npos);
-        }
+        std::string x;
+        b64_decode_append(x, src, len);
         return x;
     }
 
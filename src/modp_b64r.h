@@ -143,9 +143,13 @@ END_C
 #ifdef __cplusplus
 #include <cstring>
 #include <string>
+#include "modp_cxx.h"
 
 namespace modp {
 
+    MODP_CXX_CODEC(b64r_encode, modp_b64r_encode, modp_b64r_encode_len(len))
+    MODP_CXX_CODEC(b64r_decode, modp_b64r_decode, modp_b64r_decode_len(len) + 1)
+
     /** \brief b64r encode a cstr with len
      *
      * \param[in] s the input string to encode
@@ -154,14 +158,8 @@ namespace modp {
      */
     inline std::string b64r_encode(const char* s, size_t len)
     {
-        std::string x(modp_b64r_encode_len(len), '\0');
-        size_t d = modp_b64r_encode(const_cast<char*>(x.data()), s,
-                                 static_cast<int>(len));
-        if (d == (size_t)-1) {
-            x.clear();
-        } else {
-            x.erase(d, std::string::npos);
-        }
+        std::string x;
+        b64r_encode_append(x, s, len);
         return x;
     }
 
@@ -202,14 +200,8 @@ namespace modp {
 
     inline std::string b64r_decode(const char* src, size_t len)
     {
-        std::string x(modp_b64r_decode_len(len)+1, '\0');
-        size_t d = modp_b64r_decode(const_cast<char*>(x.data()), src,
-                                    static_cast<int>(len));
-        if (d == (size_t)-1) {
-            x.clear();
-        } else {
-            x.erase(d, std::string::npos);
-        }
+        std::string x;
+        b64r_decode_append(x, src, len);
         return x;
     }
 
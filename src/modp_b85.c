@@ -42,8 +42,11 @@
  * </pre>
  */
 
+#include "config.h"
 /* exported public header */
 #include "modp_b85.h"
+#include "modp_stats.h"
+#include "modp_probe.h"
 #include "modp_stdint.h"
 /* private header */
 #include "modp_b85_data.h"
@@ -58,7 +61,7 @@
  * you can decode IN PLACE!
  * no memory allocated
  */
-size_t modp_b85_decode(char* out, const char* data, size_t len)
+static size_t b85_decode_impl(char* out, const char* data, size_t len)
 {
     size_t i;
     int j;
@@ -90,7 +93,7 @@ size_t modp_b85_decode(char* out, const char* data, size_t len)
 /**
  * src != out
  */
-size_t modp_b85_encode(char* out, const char* src, size_t len)
+static size_t b85_encode_impl(char* out, const char* src, size_t len)
 {
     size_t i;
     uint32_t tmp;
@@ -135,3 +138,13 @@ size_t modp_b85_encode(char* out, const char* src, size_t len)
     *out = 0; /* final null */
     return buckets * 5;
 }
+
+size_t modp_b85_decode(char* out, const char* data, size_t len)
+{
+    MODP_COUNTED_SIZE(b85_decode, b85_decode_impl(out, data, len), len);
+}
+
+size_t modp_b85_encode(char* out, const char* src, size_t len)
+{
+    MODP_COUNTED_SIZE(b85_encode, b85_encode_impl(out, src, len), len);
+}
@@ -78,9 +78,13 @@ size_t modp_b85_decode(char* dest, const char* src, size_t len);
 #ifdef __cplusplus
 #include <cstring>
 #include <string>
+#include "modp_cxx.h"
 
 namespace modp {
 
+    MODP_CXX_CODEC(b85_encode, modp_b85_encode, modp_b85_encode_len(len))
+    MODP_CXX_CODEC(b85_decode, modp_b85_decode, modp_b85_decode_len(len) + 1)
+
     /**
      *
      * \param[in] s the input data
@@ -89,13 +93,8 @@ namespace modp {
      */
     inline std::string b85_encode(const char* s, size_t len)
     {
-        std::string x(modp_b85_encode_len(len), '\0');
-        size_t d = modp_b85_encode(const_cast<char*>(x.data()), s, len);
-        if (d == (size_t)-1) {
-            x.clear();
-        } else {
-            x.erase(d, std::string::npos);
-        }
+        std::string x;
+        b85_encode_append(x, s, len);
         return x;
     }
 
@@ -41,57 +41,393 @@
  * http://www.opensource.org/licenses/bsd-license.php
  * </PRE>
  */
+#include "config.h"
 #include "modp_bjavascript.h"
+#include "modp_stats.h"
+#include "modp_probe.h"
 #include "modp_stdint.h"
+#include "modp_swar.h"
+#include "modp_escape.h"
+#include "modp_xml.h"
 #include "modp_bjavascript_data.h"
 
-size_t modp_bjavascript_encode(char* dest, const char* src, size_t len)
+static size_t bjavascript_encode_impl(char* dest, const char* src, size_t len)
+{
+    size_t n = modp_escape_encode(dest, src, len, gsJavascriptEncodeLen,
+                                  gsJavascriptEncodeEsc);
+    dest[n] = '\0';
+    return n;
+}
+
+size_t modp_bjavascript_encode_strlen(const char* src, size_t len)
+{
+    return modp_escape_strlen(src, len, gsJavascriptEncodeLen);
+}
+
+/*
+ * Non-zero if a word contains a byte that is not passed through
+ * as-is by modp_bjavascript_uencode: control chars, non-ascii,
+ * quotes, backslash and '<'
+ */
+#define JS_WORD_NEEDS_WORK(w) \
+    (MODP_WORD_HASLESS(w, 0x20) | MODP_WORD_HASMORE(w, 0x7E) | \
+     MODP_WORD_HASBYTE(w, '"') | MODP_WORD_HASBYTE(w, '\'') | \
+     MODP_WORD_HASBYTE(w, '\\') | MODP_WORD_HASBYTE(w, '<'))
+
+/**
+ * Decode one UTF-8 sequence.  Rejects overlong forms, surrogates and
+ * values past U+10FFFF.
+ *
+ * \return number of bytes in the sequence, or 0 if invalid
+ */
+static size_t js_utf8_decode(const uint8_t* s, const uint8_t* srcend,
+                             uint32_t* cp)
+{
+    const size_t avail = (size_t)(srcend - s);
+    const uint32_t c = s[0];
+    uint32_t d;
+
+    if (c < 0xC2) {
+        /* continuation byte, or overlong 2-byte lead */
+        return 0;
+    } else if (c < 0xE0) {
+        if (avail < 2 || (s[1] & 0xC0) != 0x80) {
+            return 0;
+        }
+        *cp = ((c & 0x1F) << 6) | (s[1] & 0x3Fu);
+        return 2;
+    } else if (c < 0xF0) {
+        if (avail < 3 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80) {
+            return 0;
+        }
+        d = ((c & 0x0F) << 12) | ((s[1] & 0x3Fu) << 6) | (s[2] & 0x3Fu);
+        if (d < 0x0800 || (d >= 0xD800 && d <= 0xDFFF)) {
+            return 0;
+        }
+        *cp = d;
+        return 3;
+    } else if (c < 0xF5) {
+        if (avail < 4 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80 ||
+            (s[3] & 0xC0) != 0x80) {
+            return 0;
+        }
+        d = ((c & 0x07) << 18) | ((s[1] & 0x3Fu) << 12) |
+            ((s[2] & 0x3Fu) << 6) | (s[3] & 0x3Fu);
+        if (d < 0x010000 || d > 0x10FFFF) {
+            return 0;
+        }
+        *cp = d;
+        return 4;
+    }
+    return 0;
+}
+
+/**
+ * does code point cp get written as \\uXXXX given flags
+ */
+static int js_wants_uescape(uint32_t cp, int flags)
+{
+    if (flags & MODP_JS_ESCAPE_NONASCII) {
+        return 1;
+    }
+    if ((flags & MODP_JS_ESCAPE_LINESEP) && (cp == 0x2028 || cp == 0x2029)) {
+        return 1;
+    }
+    return 0;
+}
+
+static char* js_write_u16(char* dest, uint32_t u)
+{
+    dest[0] = '\\';
+    dest[1] = 'u';
+    dest[2] = (char) gsHexEncodeMap1[(u >> 8) & 0xFF];
+    dest[3] = (char) gsHexEncodeMap2[(u >> 8) & 0xFF];
+    dest[4] = (char) gsHexEncodeMap1[u & 0xFF];
+    dest[5] = (char) gsHexEncodeMap2[u & 0xFF];
+    return dest + 6;
+}
+
+static size_t bjavascript_uencode_impl(char* dest, const char* src, size_t len,
+                                       int flags)
 {
     const char* deststart = dest;
     const uint8_t* s = (const uint8_t*) src;
     const uint8_t* srcend = s + len;
+    const uint8_t* wordend;
+    modp_word_t w;
+    uint32_t cp = 0;
+    size_t n;
     uint8_t x;
     uint8_t val;
 
-    /* if 0, do nothing
-     * if 'A', hex escape
-     * else, \\ + value
-     */
     while (s < srcend) {
-        x = *s++;
-        val = gsJavascriptEncodeMap[x];
-        if (val == 0) {
-            *dest++ = (char) x;
-        } else if (val == 'A') {
-            *dest++ = '\\';
-            *dest++ = 'x';
-            *dest++ = (char)(gsHexEncodeMap1[x]);
-            *dest++ = (char)(gsHexEncodeMap2[x]);
-        } else {
-            *dest++ = '\\';
-            *dest++ = (char)val;
+        /* fast path: copy runs of 8 plain bytes at a time */
+        while (srcend - s >= MODP_WORD_SIZE) {
+            MODP_WORD_LOAD(w, s);
+            if (JS_WORD_NEEDS_WORK(w)) {
+                break;
+            }
+            memcpy(dest, s, MODP_WORD_SIZE);
+            dest += MODP_WORD_SIZE;
+            s += MODP_WORD_SIZE;
+        }
+
+        /*
+         * slow path: at least one byte in the next word needs work,
+         * do the whole word byte-by-byte before testing again
+         */
+        wordend = s + MODP_WORD_SIZE;
+        if (wordend > srcend) {
+            wordend = srcend;
+        }
+        while (s < wordend) {
+            x = *s;
+            val = gsJavascriptUnicodeEncodeMap[x];
+            if (val == 0) {
+                *dest++ = (char) x;
+                s += 1;
+            } else if (val == 'U') {
+                n = js_utf8_decode(s, srcend, &cp);
+                if (n == 0) {
+                    /* not UTF-8, treat as a binary byte */
+                    dest[0] = '\\';
+                    dest[1] = 'x';
+                    dest[2] = (char) gsHexEncodeMap1[x];
+                    dest[3] = (char) gsHexEncodeMap2[x];
+                    dest += 4;
+                    s += 1;
+                } else if (js_wants_uescape(cp, flags)) {
+                    if (cp > 0xFFFF) {
+                        cp -= 0x10000;
+                        dest = js_write_u16(dest, 0xD800 + (cp >> 10));
+                        dest = js_write_u16(dest, 0xDC00 + (cp & 0x3FF));
+                    } else {
+                        dest = js_write_u16(dest, cp);
+                    }
+                    s += n;
+                } else {
+                    memcpy(dest, s, n);
+                    dest += n;
+                    s += n;
+                }
+            } else if (val == 'A') {
+                dest[0] = '\\';
+                dest[1] = 'x';
+                dest[2] = (char) gsHexEncodeMap1[x];
+                dest[3] = (char) gsHexEncodeMap2[x];
+                dest += 4;
+                s += 1;
+            } else if (val == '<') {
+                *dest++ = '<';
+                s += 1;
+                if ((flags & MODP_JS_ESCAPE_SCRIPT) && s < srcend && *s == '/') {
+                    dest[0] = '\\';
+                    dest[1] = '/';
+                    dest += 2;
+                    s += 1;
+                }
+            } else {
+                dest[0] = '\\';
+                dest[1] = (char) val;
+                dest += 2;
+                s += 1;
+            }
         }
     }
     *dest = '\0';
     return (size_t)(dest - deststart);
 }
 
-size_t modp_bjavascript_encode_strlen(const char* src, size_t len)
+size_t modp_bjavascript_uencode_strlen(const char* src, size_t len, int flags)
 {
-    const uint8_t* s = (const uint8_t*)src;
+    const uint8_t* s = (const uint8_t*) src;
     const uint8_t* srcend = s + len;
     size_t count = 0;
+    uint32_t cp = 0;
+    size_t n;
     uint8_t val;
 
     while (s < srcend) {
-        val = gsJavascriptEncodeMap[*s++];
+        val = gsJavascriptUnicodeEncodeMap[*s];
         if (val == 0) {
-            count++;
+            count += 1;
+            s += 1;
+        } else if (val == 'U') {
+            n = js_utf8_decode(s, srcend, &cp);
+            if (n == 0) {
+                count += 4;
+                s += 1;
+            } else {
+                if (js_wants_uescape(cp, flags)) {
+                    count += (cp > 0xFFFF) ? 12 : 6;
+                } else {
+                    count += n;
+                }
+                s += n;
+            }
         } else if (val == 'A') {
             count += 4;
+            s += 1;
+        } else if (val == '<') {
+            count += 1;
+            s += 1;
+            if ((flags & MODP_JS_ESCAPE_SCRIPT) && s < srcend && *s == '/') {
+                count += 2;
+                s += 1;
+            }
         } else {
             count += 2;
+            s += 1;
         }
     }
     return count;
 }
+
+/**
+ * parse exactly n hex digits
+ * \return the value, or 0xFFFFFFFF if a non-hex char is found
+ */
+static uint32_t js_parse_hex(const uint8_t* s, size_t n)
+{
+    uint32_t val = 0;
+    uint32_t d;
+    size_t i;
+    for (i = 0; i < n; ++i) {
+        d = s[i];
+        if (d >= '0' && d <= '9') {
+            d -= '0';
+        } else if (d >= 'a' && d <= 'f') {
+            d = d - 'a' + 10;
+        } else if (d >= 'A' && d <= 'F') {
+            d = d - 'A' + 10;
+        } else {
+            return 0xFFFFFFFF;
+        }
+        val = (val << 4) | d;
+    }
+    return val;
+}
+
+static size_t bjavascript_decode_impl(char* dest, const char* src, size_t len)
+{
+    const char* deststart = dest;
+    const uint8_t* s = (const uint8_t*) src;
+    const uint8_t* srcend = s + len;
+    const uint8_t* pos;
+    uint32_t cp;
+    uint32_t lo;
+    size_t n;
+
+    while (s < srcend) {
+        /* copy everything up to the next backslash in one go */
+        pos = (const uint8_t*) memchr(s, '\\', (size_t)(srcend - s));
+        if (pos == NULL) {
+            pos = srcend;
+        }
+        n = (size_t)(pos - s);
+        if (n) {
+            /* may be in-place, dest is never ahead of s */
+            memmove(dest, s, n);
+            dest += n;
+            s = pos;
+        }
+        if (s == srcend) {
+            break;
+        }
+
+        /* s points to a backslash */
+        if (srcend - s < 2) {
+            return (size_t)-1;
+        }
+        switch (s[1]) {
+        case 'b': *dest++ = '\b'; s += 2; break;
+        case 't': *dest++ = '\t'; s += 2; break;
+        case 'n': *dest++ = '\n'; s += 2; break;
+        case 'v': *dest++ = '\v'; s += 2; break;
+        case 'f': *dest++ = '\f'; s += 2; break;
+        case 'r': *dest++ = '\r'; s += 2; break;
+        case '0': *dest++ = '\0'; s += 2; break;
+        case '\n':
+            /* line continuation */
+            s += 2;
+            break;
+        case '\r':
+            /* line continuation, maybe CRLF */
+            s += 2;
+            if (s < srcend && *s == '\n') {
+                s += 1;
+            }
+            break;
+        case 'x':
+            if (srcend - s < 4) {
+                return (size_t)-1;
+            }
+            cp = js_parse_hex(s + 2, 2);
+            if (cp > 0xFF) {
+                return (size_t)-1;
+            }
+            /* raw byte, matches what modp_bjavascript_encode emits */
+            *dest++ = (char) cp;
+            s += 4;
+            break;
+        case 'u':
+            if (srcend - s >= 3 && s[2] == '{') {
+                /* \u{X} to \u{XXXXXX} */
+                pos = (const uint8_t*) memchr(s + 3, '}', (size_t)(srcend - s - 3));
+                if (pos == NULL || pos == s + 3 || pos - (s + 3) > 6) {
+                    return (size_t)-1;
+                }
+                cp = js_parse_hex(s + 3, (size_t)(pos - (s + 3)));
+                s = pos + 1;
+            } else {
+                if (srcend - s < 6) {
+                    return (size_t)-1;
+                }
+                cp = js_parse_hex(s + 2, 4);
+                s += 6;
+                if (cp >= 0xD800 && cp <= 0xDBFF) {
+                    /* high surrogate must be followed by a low one */
+                    if (srcend - s < 6 || s[0] != '\\' || s[1] != 'u') {
+                        return (size_t)-1;
+                    }
+                    lo = js_parse_hex(s + 2, 4);
+                    if (lo < 0xDC00 || lo > 0xDFFF) {
+                        return (size_t)-1;
+                    }
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    s += 6;
+                }
+            }
+            if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+                return (size_t)-1;
+            }
+            dest += modp_xml_unicode_char_to_utf8(dest, (int) cp);
+            break;
+        default:
+            /* \\ \' \" \/ and any other char stand for themselves */
+            *dest++ = (char) s[1];
+            s += 2;
+        }
+    }
+    *dest = '\0';
+    return (size_t)(dest - deststart);
+}
+
+size_t modp_bjavascript_encode(char* dest, const char* src, size_t len)
+{
+    MODP_COUNTED_SIZE(bjavascript_encode,
+                      bjavascript_encode_impl(dest, src, len), len);
+}
+
+size_t modp_bjavascript_uencode(char* dest, const char* src, size_t len,
+                                int flags)
+{
+    MODP_COUNTED_SIZE(bjavascript_uencode,
+                      bjavascript_uencode_impl(dest, src, len, flags), len);
+}
+
+size_t modp_bjavascript_decode(char* dest, const char* src, size_t len)
+{
+    MODP_COUNTED_SIZE(bjavascript_decode,
+                      bjavascript_decode_impl(dest, src, len), len);
+}
@@ -16,7 +16,9 @@
  * The "b" in "modp_bjavascript" is due to legacy reasons.  It doesn't
  * mean anything
  *
- * There is no decoder.
+ * modp_bjavascript_uencode is a UTF-8 aware variant that can emit
+ * \\uXXXX escapes and break up "</" so the result is safe inside an
+ * inline script block.  modp_bjavascript_decode reverses either one.
  */
 
 /*
@@ -72,18 +74,109 @@ size_t modp_bjavascript_encode(char* dest, const char* str, size_t len);
  */
 size_t modp_bjavascript_encode_strlen(const char* str, size_t len);
 
+/**
+ * flag for modp_bjavascript_uencode: write U+2028 and U+2029 as
+ * \\u2028 and \\u2029.  These are line terminators in javascript
+ * (before ES2019) and end a string literal early if passed raw.
+ */
+#define MODP_JS_ESCAPE_LINESEP  0x01
+
+/**
+ * flag for modp_bjavascript_uencode: write "</" as "<\/" so the
+ * output can not close an enclosing &lt;script&gt; element.
+ */
+#define MODP_JS_ESCAPE_SCRIPT   0x02
+
+/**
+ * flag for modp_bjavascript_uencode: write every non-ascii code point
+ * as \\uXXXX (or a surrogate pair), giving 7-bit ascii output.
+ */
+#define MODP_JS_ESCAPE_NONASCII 0x04
+
+/**
+ * The flags needed to inline the output in a HTML script block.
+ */
+#define MODP_JS_ESCAPE_HTML (MODP_JS_ESCAPE_LINESEP | MODP_JS_ESCAPE_SCRIPT)
+
+/**
+ * "javascript" encode a UTF-8 string
+ *
+ * Same escaping as modp_bjavascript_encode for ascii, but valid UTF-8
+ * sequences are passed through unchanged instead of being hex
+ * escaped byte by byte, unless flags ask for a \\uXXXX escape.
+ * Bytes that are not part of a valid UTF-8 sequence are written
+ * as \\xHH.
+ *
+ * Runs of plain ascii are copied a word at a time.
+ *
+ * \param[out] dest output string, at least
+ *   modp_bjavascript_uencode_len(len) bytes
+ * \param[in] str The input string
+ * \param[in] len  The length of the input string, excluding any
+ *   final null byte.
+ * \param[in] flags zero or more MODP_JS_ESCAPE_ values or-ed together
+ * \return the strlen of the output
+ */
+size_t modp_bjavascript_uencode(char* dest, const char* str, size_t len,
+                                int flags);
+
+/**
+ * Memory needed for modp_bjavascript_uencode.  Same as
+ * modp_bjavascript_encode, every escape is at most 4 chars per input
+ * byte.
+ */
+#define modp_bjavascript_uencode_len(A) (4*A + 1)
+
+/**
+ * exact strlen of the output of modp_bjavascript_uencode
+ *
+ * \param[in] str  The input string
+ * \param[in] len  The length of the input string
+ * \param[in] flags same flags passed to modp_bjavascript_uencode
+ * \return the size of the output string, excluding the final
+ *   null byte.
+ */
+size_t modp_bjavascript_uencode_strlen(const char* str, size_t len, int flags);
+
+/**
+ * Unescape the contents of a javascript string literal
+ *
+ * Handles the single character escapes, \\xHH, \\uXXXX (including
+ * surrogate pairs), \\u{X...} and line continuations.  Code points
+ * are written as UTF-8.  \\xHH is written as the raw byte HH, so the
+ * output of both encoders round trips exactly.  Any other escaped
+ * character stands for itself.
+ *
+ * \param[out] dest output buffer, at least modp_bjavascript_decode_len(len)
+ *   bytes.  This may be the same as the input buffer.
+ * \param[in] str The escaped string, without the enclosing quotes
+ * \param[in] len The length of the input string
+ * \return the strlen of the output, or -1 if an escape is malformed,
+ *   or is a lone surrogate.
+ */
+size_t modp_bjavascript_decode(char* dest, const char* str, size_t len);
+
+/**
+ * Memory needed to decode a string of length A, no escape grows
+ */
+#define modp_bjavascript_decode_len(A) (A + 1)
+
 #include "extern_c_end.h"
 
 #ifdef __cplusplus
 #include <cstring>
 #include <string>
+#include "modp_cxx.h"
+
 namespace modp {
 
+    MODP_CXX_CODEC(javascript_encode, modp_bjavascript_encode, modp_bjavascript_encode_len(len))
+    MODP_CXX_CODEC(javascript_decode, modp_bjavascript_decode, modp_bjavascript_decode_len(len))
+
     inline std::string javascript_encode(const char* s, size_t len)
     {
-        std::string x(modp_bjavascript_encode_len(len), '\0');
-        size_t d = modp_bjavascript_encode(const_cast<char*>(x.data()), s, len);
-        x.erase(d, std::string::npos);
+        std::string x;
+        javascript_encode_append(x, s, len);
         return x;
     }
 
@@ -104,6 +197,124 @@ namespace modp {
         return javascript_encode(s.data(), s.size());
     }
 
+    /**
+     * UTF-8 aware javascript escape into a caller buffer
+     * \return strlen of the output, or -1 if destlen is too small
+     */
+    inline size_t javascript_uencode(char* dest, size_t destlen,
+                                     const char* s, size_t len,
+                                     int flags = MODP_JS_ESCAPE_HTML)
+    {
+        if (destlen < modp_bjavascript_uencode_len(len)) {
+            return (size_t)-1;
+        }
+        return modp_bjavascript_uencode(dest, s, len, flags);
+    }
+
+    /**
+     * UTF-8 aware javascript escape, appended to a std::string or
+     * std::vector
+     * \return number of bytes added
+     */
+    template <class Container>
+    inline size_t javascript_uencode_append(Container& out,
+                                            const char* s, size_t len,
+                                            int flags = MODP_JS_ESCAPE_HTML)
+    {
+        const size_t old = out.size();
+        size_t d;
+
+        out.resize(old + modp_bjavascript_uencode_len(len));
+        d = modp_bjavascript_uencode(reinterpret_cast<char*>(&out[0]) + old,
+                                     s, len, flags);
+        out.resize(old + d);
+        return d;
+    }
+
+    /**
+     * UTF-8 aware javascript escape into a sink, see modp_cxx.h
+     * \return number of bytes written, or -1 if the sink has no room
+     */
+    template <class Sink>
+    inline size_t javascript_uencode_to(Sink& sink, const char* s, size_t len,
+                                        int flags = MODP_JS_ESCAPE_HTML)
+    {
+        char* p = sink.prepare(modp_bjavascript_uencode_len(len));
+        size_t d;
+
+        if (p == NULL) {
+            return (size_t)-1;
+        }
+        d = modp_bjavascript_uencode(p, s, len, flags);
+        sink.commit(d);
+        return d;
+    }
+
+    template <class T, class Traits, class Alloc>
+    inline size_t javascript_uencode_to(std::basic_string<T, Traits, Alloc>& out,
+                                        const char* s, size_t len,
+                                        int flags = MODP_JS_ESCAPE_HTML)
+    {
+        return javascript_uencode_append(out, s, len, flags);
+    }
+
+    template <class T, class Alloc>
+    inline size_t javascript_uencode_to(std::vector<T, Alloc>& out,
+                                        const char* s, size_t len,
+                                        int flags = MODP_JS_ESCAPE_HTML)
+    {
+        return javascript_uencode_append(out, s, len, flags);
+    }
+
+    inline std::string javascript_uencode(const char* s, size_t len,
+                                          int flags = MODP_JS_ESCAPE_HTML)
+    {
+        std::string x;
+        javascript_uencode_append(x, s, len, flags);
+        return x;
+    }
+
+    inline std::string javascript_uencode(const std::string& s,
+                                          int flags = MODP_JS_ESCAPE_HTML)
+    {
+        return javascript_uencode(s.data(), s.size(), flags);
+    }
+
+    /**
+     * Unescape a javascript string literal (self-modifing).
+     * This function does not allocate memory.
+     *
+     * \param[in,out] s the string to be decoded
+     * \return a reference to the input string, empty if error
+     */
+    inline std::string& javascript_decode(std::string& s)
+    {
+        size_t d = modp_bjavascript_decode(const_cast<char*>(s.data()), s.data(), s.size());
+        if (d == (size_t)-1) {
+            s.clear();
+        } else {
+            s.erase(d, std::string::npos);
+        }
+        return s;
+    }
+
+    inline std::string javascript_decode(const char* s, size_t len)
+    {
+        std::string x(s, len);
+        return javascript_decode(x);
+    }
+
+    inline std::string javascript_decode(const char* s)
+    {
+        return javascript_decode(s, strlen(s));
+    }
+
+    inline std::string javascript_decode(const std::string& s)
+    {
+        std::string x(s);
+        return javascript_decode(x);
+    }
+
 }       /* namespace modp */
 #endif  /* __cplusplus */
 
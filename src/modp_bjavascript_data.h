@@ -1,30 +1,95 @@
-static const uint8_t gsJavascriptEncodeMap[256] = {
+static const uint8_t gsJavascriptEncodeLen[256] = {
+4, 4, 4, 4, 4, 4, 4, 4, 2, 2, 2, 2, 2, 2, 4, 4,
+4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+0, 0, 2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4,
+4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4
+};
+
+static const char gsJavascriptEncodeEsc[256][8] = {
+"\134x00", "\134x01", "\134x02", "\134x03", "\134x04", "\134x05",
+"\134x06", "\134x07", "\134b", "\134t", "\134n", "\134v",
+"\134f", "\134r", "\134x0E", "\134x0F", "\134x10", "\134x11",
+"\134x12", "\134x13", "\134x14", "\134x15", "\134x16", "\134x17",
+"\134x18", "\134x19", "\134x1A", "\134x1B", "\134x1C", "\134x1D",
+"\134x1E", "\134x1F", " ", "!", "\134\042", "#",
+"$", "%", "&", "\134'", "(", ")",
+"*", "+", ",", "-", ".", "/",
+"0", "1", "2", "3", "4", "5",
+"6", "7", "8", "9", ":", ";",
+"<", "=", ">", "\077", "@", "A",
+"B", "C", "D", "E", "F", "G",
+"H", "I", "J", "K", "L", "M",
+"N", "O", "P", "Q", "R", "S",
+"T", "U", "V", "W", "X", "Y",
+"Z", "[", "\134\134", "]", "^", "_",
+"`", "a", "b", "c", "d", "e",
+"f", "g", "h", "i", "j", "k",
+"l", "m", "n", "o", "p", "q",
+"r", "s", "t", "u", "v", "w",
+"x", "y", "z", "{", "|", "}",
+"~", "\134x7F", "\134x80", "\134x81", "\134x82", "\134x83",
+"\134x84", "\134x85", "\134x86", "\134x87", "\134x88", "\134x89",
+"\134x8A", "\134x8B", "\134x8C", "\134x8D", "\134x8E", "\134x8F",
+"\134x90", "\134x91", "\134x92", "\134x93", "\134x94", "\134x95",
+"\134x96", "\134x97", "\134x98", "\134x99", "\134x9A", "\134x9B",
+"\134x9C", "\134x9D", "\134x9E", "\134x9F", "\134xA0", "\134xA1",
+"\134xA2", "\134xA3", "\134xA4", "\134xA5", "\134xA6", "\134xA7",
+"\134xA8", "\134xA9", "\134xAA", "\134xAB", "\134xAC", "\134xAD",
+"\134xAE", "\134xAF", "\134xB0", "\134xB1", "\134xB2", "\134xB3",
+"\134xB4", "\134xB5", "\134xB6", "\134xB7", "\134xB8", "\134xB9",
+"\134xBA", "\134xBB", "\134xBC", "\134xBD", "\134xBE", "\134xBF",
+"\134xC0", "\134xC1", "\134xC2", "\134xC3", "\134xC4", "\134xC5",
+"\134xC6", "\134xC7", "\134xC8", "\134xC9", "\134xCA", "\134xCB",
+"\134xCC", "\134xCD", "\134xCE", "\134xCF", "\134xD0", "\134xD1",
+"\134xD2", "\134xD3", "\134xD4", "\134xD5", "\134xD6", "\134xD7",
+"\134xD8", "\134xD9", "\134xDA", "\134xDB", "\134xDC", "\134xDD",
+"\134xDE", "\134xDF", "\134xE0", "\134xE1", "\134xE2", "\134xE3",
+"\134xE4", "\134xE5", "\134xE6", "\134xE7", "\134xE8", "\134xE9",
+"\134xEA", "\134xEB", "\134xEC", "\134xED", "\134xEE", "\134xEF",
+"\134xF0", "\134xF1", "\134xF2", "\134xF3", "\134xF4", "\134xF5",
+"\134xF6", "\134xF7", "\134xF8", "\134xF9", "\134xFA", "\134xFB",
+"\134xFC", "\134xFD", "\134xFE", "\134xFF"
+};
+
+static const uint8_t gsJavascriptUnicodeEncodeMap[256] = {
  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'b',  't',
  'n',  'v',  'f',  'r',  'A',  'A',  'A',  'A',  'A',  'A',
  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',
  'A',  'A', '\0', '\0',  '"', '\0', '\0', '\0', '\0', '\'',
 '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
 '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
+ '<', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
 '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
 '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
 '\0', '\0', '\\', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
 '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
 '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-'\0', '\0', '\0', '\0', '\0', '\0', '\0',  'A',  'A',  'A',
- 'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',
- 'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',
- 'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',
- 'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',
- 'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',
- 'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',
- 'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',
- 'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',
- 'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',
- 'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',
- 'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',
- 'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',  'A',
- 'A',  'A',  'A',  'A',  'A',  'A'
+'\0', '\0', '\0', '\0', '\0', '\0', '\0',  'A',  'U',  'U',
+ 'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',
+ 'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',
+ 'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',
+ 'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',
+ 'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',
+ 'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',
+ 'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',
+ 'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',
+ 'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',
+ 'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',
+ 'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',
+ 'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',  'U',
+ 'U',  'U',  'U',  'U',  'U',  'U'
 };
 
 static const uint8_t gsHexEncodeMap1[256] = {
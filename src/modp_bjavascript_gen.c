@@ -18,6 +18,33 @@ static void hexencodemap(void)
     char_array_to_c(hexEncode2, sizeof(hexEncode2), "gsHexEncodeMap2");
 }
 
+/*
+ * a map entry of 0 is as-is, 'A' is written as \xHH, anything else
+ * as a backslash and the entry
+ */
+static void jsescapes(const char* map, const char* name)
+{
+    static const char sHexChars[] = "0123456789ABCDEF";
+    static char buf[256][5];
+    const char* esc[256];
+    int i;
+
+    for (i = 0; i < 256; ++i) {
+        esc[i] = buf[i];
+        buf[i][0] = '\\';
+        if (map[i] == 0) {
+            esc[i] = NULL;
+        } else if (map[i] == 'A') {
+            buf[i][1] = 'x';
+            buf[i][2] = sHexChars[i >> 4];
+            buf[i][3] = sHexChars[i & 0x0f];
+        } else {
+            buf[i][1] = map[i];
+        }
+    }
+    escape_array_to_c(esc, name);
+}
+
 static void jsencodemap(void)
 {
     int i;
@@ -47,12 +74,48 @@ static void jsencodemap(void)
     jsEncodeMap[0x22] = '"';   /* dquote gets escaped */
     jsEncodeMap[0x27] = '\'';  /* squote gets escaped */
 
-    char_array_to_c(jsEncodeMap, sizeof(jsEncodeMap), "gsJavascriptEncodeMap");
+    jsescapes(jsEncodeMap, "gsJavascriptEncode");
+}
+
+/*
+ * Same as above except bytes that can start or continue a UTF-8
+ * sequence are marked with 'U' instead of being hex escaped, and '<'
+ * is marked so "</" can be broken up.
+ */
+static void jsuencodemap(void)
+{
+    int i;
+    char jsEncodeMap[256];
+
+    for (i = 0; i < 256; ++i) {
+        jsEncodeMap[i] = 0;
+    }
+    for (i = 0; i < 32; ++i) {
+        jsEncodeMap[i] = 'A';
+    }
+    jsEncodeMap[127] = 'A';
+    for (i = 128; i < 256; ++i) {
+        jsEncodeMap[i] = 'U';
+    }
+
+    jsEncodeMap[0x08] = 'b';
+    jsEncodeMap[0x09] = 't';
+    jsEncodeMap[0x0a] = 'n';
+    jsEncodeMap[0x0b] = 'v';
+    jsEncodeMap[0x0c] = 'f';
+    jsEncodeMap[0x0d] = 'r';
+    jsEncodeMap[0x5c] = '\\';
+    jsEncodeMap[0x22] = '"';
+    jsEncodeMap[0x27] = '\'';
+    jsEncodeMap[0x3c] = '<';   /* maybe "</" */
+
+    char_array_to_c(jsEncodeMap, sizeof(jsEncodeMap), "gsJavascriptUnicodeEncodeMap");
 }
 
 int main(void)
 {
     jsencodemap();
+    jsuencodemap();
     hexencodemap();
     return 0;
 }
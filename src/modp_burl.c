@@ -41,82 +41,33 @@
  * </PRE>
  */
 
+#include "config.h"
 #include "modp_stdint.h"
 #include "modp_burl.h"
+#include "modp_stats.h"
+#include "modp_probe.h"
+#include "modp_internal.h"
+#include "modp_escape.h"
 #include "modp_burl_data.h"
 
-size_t modp_burl_encode(char* dest, const char* src, size_t len)
+static size_t burl_encode_impl(char* dest, const char* src, size_t len)
 {
-
-    const char* deststart = dest;
-    const uint8_t* s = (const uint8_t*)src;
-    const uint8_t* srcend = s + len;
-    char c;
-    uint8_t x;
-
-    if (len == 0) {
-        *dest = '\0';
-        return (size_t) 0;
-    }
-
-    while (s < srcend) {
-        x = *s++;
-        c = (char)gsUrlEncodeMap[x];
-        if (c) {
-            *dest++ = c;
-        } else {
-            *dest++ = '%';
-            *dest++ = (char)gsHexEncodeMap1[x];
-            *dest++ = (char)gsHexEncodeMap2[x];
-            /*
-              is the equiv of this
-              static const char sHexChars[] = "0123456789ABCDEF";
-              *dest++ = (char)sHexChars[x >> 4];
-              *dest++ = (char)sHexChars[x & 0x0F];
-              */
-        }
-    }
-    *dest = '\0';
-    return (size_t)(dest - deststart); /* compute "strlen" of dest. */
+    size_t n = modp_escape_encode(dest, src, len,
+                                  gsUrlEncodeLen, gsUrlEncodeEsc);
+    dest[n] = '\0';
+    return n;
 }
 
 /**
- * The implementation is identical except it uses a
- * different array
+ * The implementation is identical except it uses
+ * different tables
  */
-size_t modp_burl_min_encode(char* dest, const char* src, size_t len)
+static size_t burl_min_encode_impl(char* dest, const char* src, size_t len)
 {
-
-    const char* deststart = dest;
-    const uint8_t* s = (const uint8_t*)src;
-    const uint8_t* srcend = s + len;
-    char c;
-    uint8_t x;
-
-    if (len == 0) {
-        *dest = '\0';
-        return (size_t) 0;
-    }
-
-    while (s < srcend) {
-        x = *s++;
-        c = (char)(gsUrlEncodeMinMap[x]); /** CHANGE HERE **/
-        if (c) {
-            *dest++ = c;
-        } else {
-            *dest++ = '%';
-            *dest++ = (char) gsHexEncodeMap1[x];
-            *dest++ = (char)(gsHexEncodeMap2[x]);
-            /*
-              is the equiv of this
-              static const char sHexChars[] = "0123456789ABCDEF";
-              *dest++ = sHexChars[x >> 4];
-              *dest++ = sHexChars[x & 0x0F];
-              */
-        }
-    }
-    *dest = '\0';
-    return (size_t)(dest - deststart); /* compute "strlen" of dest. */
+    size_t n = modp_escape_encode(dest, src, len,
+                                  gsUrlEncodeMinLen, gsUrlEncodeMinEsc);
+    dest[n] = '\0';
+    return n;
 }
 
 /**
@@ -125,21 +76,7 @@ size_t modp_burl_min_encode(char* dest, const char* src, size_t len)
  */
 size_t modp_burl_encode_strlen(const char* src, const size_t len)
 {
-    size_t count = 0;
-    const char* srcend = src + len;
-
-    if (len == 0) {
-        return (size_t) 0;
-    }
-
-    while (src < srcend) {
-        if (gsUrlEncodeMap[ (uint8_t) *src++]) {
-            count++;
-        } else {
-            count += 3;
-        }
-    }
-    return count;
+    return modp_escape_strlen(src, len, gsUrlEncodeLen);
 }
 
 /**
@@ -148,24 +85,10 @@ size_t modp_burl_encode_strlen(const char* src, const size_t len)
  */
 size_t modp_burl_min_encode_strlen(const char* src, const size_t len)
 {
-    size_t count = 0;
-    const char* srcend = src + len;
-
-    if (len == 0) {
-        return (size_t) 0;
-    }
-
-    while (src < srcend) {
-        if (gsUrlEncodeMinMap[ (uint8_t) *src++]) {
-            count++;
-        } else {
-            count += 3;
-        }
-    }
-    return count;
+    return modp_escape_strlen(src, len, gsUrlEncodeMinLen);
 }
 
-size_t modp_burl_decode(char* dest, const char* s, size_t len)
+size_t modp_burl_decode_impl(char* dest, const char* s, size_t len)
 {
     uint32_t d = 0; /* used for decoding %XX */
     const uint8_t* src = (const uint8_t*) s;
@@ -219,7 +142,7 @@ size_t modp_burl_decode(char* dest, const char* s, size_t len)
     return (size_t)(dest - deststart); /* compute "strlen" of dest. */
 }
 
-size_t modp_burl_decode_raw(char* dest, const char* s, size_t len)
+size_t modp_burl_decode_raw_impl(char* dest, const char* s, size_t len)
 {
     uint32_t d = 0; /* used for decoding %XX */
     const uint8_t* src = (const uint8_t*) s;
@@ -259,3 +182,25 @@ size_t modp_burl_decode_raw(char* dest, const char* s, size_t len)
     *dest = '\0';
     return (size_t)(dest - deststart); /* compute "strlen" of dest. */
 }
+
+size_t modp_burl_encode(char* dest, const char* src, size_t len)
+{
+    MODP_COUNTED_SIZE(burl_encode, burl_encode_impl(dest, src, len), len);
+}
+
+size_t modp_burl_min_encode(char* dest, const char* src, size_t len)
+{
+    MODP_COUNTED_SIZE(burl_min_encode,
+                      burl_min_encode_impl(dest, src, len), len);
+}
+
+size_t modp_burl_decode(char* dest, const char* s, size_t len)
+{
+    MODP_COUNTED_SIZE(burl_decode, modp_burl_decode_impl(dest, s, len), len);
+}
+
+size_t modp_burl_decode_raw(char* dest, const char* s, size_t len)
+{
+    MODP_COUNTED_SIZE(burl_decode_raw,
+                      modp_burl_decode_raw_impl(dest, s, len), len);
+}
@@ -136,14 +136,19 @@ MODP_C_END_DECLS
 #ifdef __cplusplus
 #include <cstring>
 #include <string>
+#include "modp_cxx.h"
 
 namespace modp {
 
+    MODP_CXX_CODEC(url_encode, modp_burl_encode, modp_burl_encode_len(len))
+    MODP_CXX_CODEC(url_min_encode, modp_burl_min_encode, modp_burl_encode_len(len))
+    MODP_CXX_CODEC(url_decode, modp_burl_decode, modp_burl_decode_len(len))
+    MODP_CXX_CODEC(url_decode_raw, modp_burl_decode_raw, modp_burl_decode_len(len))
+
     inline std::string url_encode(const char* s, size_t len)
     {
-        std::string x(modp_burl_encode_len(len), '\0');
-        size_t d = modp_burl_encode(const_cast<char*>(x.data()), s, len);
-        x.erase(d, std::string::npos);
+        std::string x;
+        url_encode_append(x, s, len);
         return x;
     }
 
@@ -170,6 +175,18 @@ namespace modp {
         return s;
     }
 
+    inline std::string url_min_encode(const char* s, size_t len)
+    {
+        std::string x;
+        url_min_encode_append(x, s, len);
+        return x;
+    }
+
+    inline std::string url_min_encode(const char* s)
+    {
+        return url_min_encode(s, strlen(s));
+    }
+
     /**
      * Minimal Url Encoding
      *
@@ -178,19 +195,14 @@ namespace modp {
      */
     inline std::string& url_min_encode(std::string& s)
     {
-        std::string x(modp_burl_encode_len(s.size()), '\0');
-        size_t d = modp_burl_min_encode(const_cast<char*>(x.data()), s.data(), s.size());
-        x.erase(d, std::string::npos);
+        std::string x(url_min_encode(s.data(), s.size()));
         s.swap(x);
         return s;
     }
 
     inline std::string url_min_encode(const std::string& s)
     {
-        std::string x(modp_burl_encode_len(s.size()), '\0');
-        size_t d = modp_burl_min_encode(const_cast<char*>(x.data()), s.data(), s.size());
-        x.erase(d, std::string::npos);
-        return x;
+        return url_min_encode(s.data(), s.size());
     }
 
     /**
@@ -3,19 +3,30 @@
 
 #include "arraytoc.h"
 
-static void hexencodemap(void)
+/*
+ * a map entry of 0 is written as %XX, otherwise as the entry
+ */
+static void urlescapes(const char* map, const char* name)
 {
     static const char sHexChars[] = "0123456789ABCDEF";
+    static char buf[256][4];
+    const char* esc[256];
     int i;
-    char hexEncode1[256];
-    char hexEncode2[256];
+
     for (i = 0; i < 256; ++i) {
-        hexEncode1[i] = sHexChars[i >> 4];
-        hexEncode2[i] = sHexChars[i & 0x0f];
+        if (map[i] == 0) {
+            buf[i][0] = '%';
+            buf[i][1] = sHexChars[i >> 4];
+            buf[i][2] = sHexChars[i & 0x0f];
+            esc[i] = buf[i];
+        } else if (map[i] == (char) i) {
+            esc[i] = NULL;
+        } else {
+            buf[i][0] = map[i];
+            esc[i] = buf[i];
+        }
     }
-
-    char_array_to_c(hexEncode1, sizeof(hexEncode1), "gsHexEncodeMap1");
-    char_array_to_c(hexEncode2, sizeof(hexEncode2), "gsHexEncodeMap2");
+    escape_array_to_c(esc, name);
 }
 
 static void urlencodemap(void)
@@ -47,7 +58,7 @@ static void urlencodemap(void)
     /* space is special */
     urlEncodeMap[(int)' '] = '+';
 
-    char_array_to_c(urlEncodeMap, sizeof(urlEncodeMap), "gsUrlEncodeMap");
+    urlescapes(urlEncodeMap, "gsUrlEncode");
 }
 
 static void urlencodeminmap(void)
@@ -86,7 +97,7 @@ static void urlencodeminmap(void)
     }
 
 
-    char_array_to_c(urlEncodeMap, sizeof(urlEncodeMap), "gsUrlEncodeMinMap");
+    urlescapes(urlEncodeMap, "gsUrlEncodeMin");
 }
 
 static void hexdecodemap(void)
@@ -120,6 +131,5 @@ int main(void)
     urlencodemap();
     urlencodeminmap();
     hexdecodemap();
-    hexencodemap();
     return 0;
 }
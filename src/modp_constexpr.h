@@ -0,0 +1,547 @@
+/* -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_constexpr.h
+ * \brief compile time base64, base16 and url encoding for C++14 and up
+ *
+ * The codecs here are constexpr versions of modp_b64, modp_b64w,
+ * modp_b64r, modp_b16 and modp_burl_encode, with the same output.
+ * They are plain loops, not the table driven code of the library,
+ * and are meant for constants: tokens, header values, keys.
+ *
+ * \code
+ * constexpr auto auth = modp::ct::b64_encode("user:secret");
+ * static_assert(auth.size() == 16, "");
+ * send(auth.c_str(), auth.size());   // no encoding at run time
+ * \endcode
+ *
+ * Literal versions return a modp::ct::fixed_string sized for the
+ * worst case.  The (dest, src, len) versions can be called from other
+ * constexpr functions.
+ *
+ * The table builders return the same tables as the *_gen programs,
+ * so C++ code can make them without the generator step.  b64w uses
+ * the default "-_." alphabet, not the --with-b64w-chars setting.
+ */
+
+/*
+ * <PRE>
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_CONSTEXPR
+#define COM_MODP_STRINGENCODERS_CONSTEXPR
+
+#if !defined(__cplusplus) || __cplusplus < 201402L
+#error "modp_constexpr.h needs C++14 or later"
+#endif
+
+#include <cstddef>
+#include <string>
+#include "modp_b16.h"
+#include "modp_b64.h"
+#include "modp_burl.h"
+
+namespace modp {
+namespace ct {
+
+    /**
+     * A null terminated string of at most N chars, usable as a
+     * constant.  ok() is false if a decode failed.
+     */
+    template <size_t N>
+    struct fixed_string {
+        char buf[N + 1];
+        size_t len;
+        bool valid;
+
+        constexpr fixed_string() : buf(), len(0), valid(true) {}
+
+        constexpr size_t size() const { return len; }
+        constexpr size_t capacity() const { return N; }
+        constexpr bool ok() const { return valid; }
+        constexpr const char* data() const { return buf; }
+        constexpr const char* c_str() const { return buf; }
+        constexpr char operator[](size_t i) const { return buf[i]; }
+
+        std::string str() const { return std::string(buf, len); }
+
+#ifdef MODP_HAS_STRING_VIEW
+        constexpr operator std::string_view() const
+        {
+            return std::string_view(buf, len);
+        }
+#endif
+    };
+
+    /**
+     * A 256 entry lookup table, as written by the *_gen programs
+     */
+    template <class T>
+    struct table {
+        T v[256];
+
+        constexpr table() : v() {}
+        constexpr T operator[](size_t i) const { return v[i]; }
+    };
+
+    /**
+     * The last two chars and the padding of a base64 alphabet.  A pad
+     * of '\0' means no padding.
+     */
+    struct b64_alphabet {
+        char c62;
+        char c63;
+        char pad;
+    };
+
+    constexpr b64_alphabet b64_std = { '+', '/', '=' };
+    constexpr b64_alphabet b64_web = { '-', '_', '.' };
+    constexpr b64_alphabet b64_rfc = { '-', '_', '=' };
+
+namespace detail {
+
+    constexpr char b64_char(unsigned i, b64_alphabet a)
+    {
+        return static_cast<char>(i < 26 ? 'A' + i
+                                 : i < 52 ? 'a' + (i - 26)
+                                 : i < 62 ? '0' + (i - 52)
+                                 : i == 62 ? static_cast<unsigned char>(a.c62)
+                                 : static_cast<unsigned char>(a.c63));
+    }
+
+    /** value of a base64 char, or 64 if not in the alphabet */
+    constexpr unsigned b64_value(char c, b64_alphabet a)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<unsigned>(c - 'A')
+            : (c >= 'a' && c <= 'z') ? static_cast<unsigned>(c - 'a' + 26)
+            : (c >= '0' && c <= '9') ? static_cast<unsigned>(c - '0' + 52)
+            : (c == a.c62) ? 62u
+            : (c == a.c63) ? 63u
+            : 64u;
+    }
+
+    /** value of a hex digit, either case, or 16 */
+    constexpr unsigned hex_value(char c)
+    {
+        return (c >= '0' && c <= '9') ? static_cast<unsigned>(c - '0')
+            : (c >= 'A' && c <= 'F') ? static_cast<unsigned>(c - 'A' + 10)
+            : (c >= 'a' && c <= 'f') ? static_cast<unsigned>(c - 'a' + 10)
+            : 16u;
+    }
+
+    constexpr char hex_char(unsigned i)
+    {
+        return static_cast<char>(i < 10 ? '0' + i : 'A' + (i - 10));
+    }
+
+    constexpr bool url_safe(unsigned char c)
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+            (c >= '0' && c <= '9') || c == '.' || c == '-' || c == '_';
+    }
+
+    constexpr size_t b64_encode(char* dest, const char* src, size_t len,
+                                b64_alphabet a)
+    {
+        size_t i = 0;
+        size_t j = 0;
+        unsigned t0 = 0;
+        unsigned t1 = 0;
+        unsigned t2 = 0;
+
+        for (; i + 2 < len; i += 3) {
+            t0 = static_cast<unsigned char>(src[i]);
+            t1 = static_cast<unsigned char>(src[i + 1]);
+            t2 = static_cast<unsigned char>(src[i + 2]);
+            dest[j++] = b64_char(t0 >> 2, a);
+            dest[j++] = b64_char(((t0 & 0x03) << 4) | (t1 >> 4), a);
+            dest[j++] = b64_char(((t1 & 0x0F) << 2) | (t2 >> 6), a);
+            dest[j++] = b64_char(t2 & 0x3F, a);
+        }
+
+        if (len - i == 1) {
+            t0 = static_cast<unsigned char>(src[i]);
+            dest[j++] = b64_char(t0 >> 2, a);
+            dest[j++] = b64_char((t0 & 0x03) << 4, a);
+            if (a.pad) {
+                dest[j++] = a.pad;
+                dest[j++] = a.pad;
+            }
+        } else if (len - i == 2) {
+            t0 = static_cast<unsigned char>(src[i]);
+            t1 = static_cast<unsigned char>(src[i + 1]);
+            dest[j++] = b64_char(t0 >> 2, a);
+            dest[j++] = b64_char(((t0 & 0x03) << 4) | (t1 >> 4), a);
+            dest[j++] = b64_char((t1 & 0x0F) << 2, a);
+            if (a.pad) {
+                dest[j++] = a.pad;
+            }
+        }
+        dest[j] = '\0';
+        return j;
+    }
+
+    constexpr size_t b64_decode(char* dest, const char* src, size_t len,
+                                b64_alphabet a)
+    {
+        size_t i = 0;
+        size_t j = 0;
+        unsigned x = 0;
+        unsigned v = 0;
+        size_t n = 0;
+
+        if (len == 0) {
+            return 0;
+        }
+        if (a.pad) {
+            /* same rules as modp_b64_decode */
+            if (len < 4 || len % 4 != 0) {
+                return (size_t)-1;
+            }
+            if (src[len - 1] == a.pad) {
+                --len;
+                if (src[len - 1] == a.pad) {
+                    --len;
+                }
+            }
+        }
+
+        for (i = 0; i < len; ++i) {
+            v = b64_value(src[i], a);
+            if (v > 63) {
+                return (size_t)-1;
+            }
+            x = (x << 6) | v;
+            if (++n == 4) {
+                dest[j++] = static_cast<char>((x >> 16) & 0xFF);
+                dest[j++] = static_cast<char>((x >> 8) & 0xFF);
+                dest[j++] = static_cast<char>(x & 0xFF);
+                x = 0;
+                n = 0;
+            }
+        }
+
+        if (n == 1) {
+            dest[j++] = static_cast<char>(x & 0xFF);
+        } else if (n == 2) {
+            dest[j++] = static_cast<char>((x >> 4) & 0xFF);
+        } else if (n == 3) {
+            dest[j++] = static_cast<char>((x >> 10) & 0xFF);
+            dest[j++] = static_cast<char>((x >> 2) & 0xFF);
+        }
+        return j;
+    }
+
+    template <size_t N>
+    constexpr fixed_string<modp_b64_encode_strlen((N - 1))>
+    b64_encode(const char (&s)[N], b64_alphabet a)
+    {
+        fixed_string<modp_b64_encode_strlen((N - 1))> x;
+        x.len = b64_encode(x.buf, s, N - 1, a);
+        return x;
+    }
+
+    template <size_t N>
+    constexpr fixed_string<modp_b64_decode_len((N - 1))>
+    b64_decode(const char (&s)[N], b64_alphabet a)
+    {
+        fixed_string<modp_b64_decode_len((N - 1))> x;
+        size_t d = b64_decode(x.buf, s, N - 1, a);
+        if (d == (size_t)-1) {
+            x.valid = false;
+        } else {
+            x.len = d;
+            x.buf[d] = '\0';
+        }
+        return x;
+    }
+
+}   /* namespace detail */
+
+    /**
+     * \brief base64 encode, see modp_b64_encode
+     */
+    constexpr size_t b64_encode(char* dest, const char* src, size_t len)
+    {
+        return detail::b64_encode(dest, src, len, b64_std);
+    }
+
+    /**
+     * \brief base64 decode, see modp_b64_decode
+     */
+    constexpr size_t b64_decode(char* dest, const char* src, size_t len)
+    {
+        return detail::b64_decode(dest, src, len, b64_std);
+    }
+
+    constexpr size_t b64w_encode(char* dest, const char* src, size_t len)
+    {
+        return detail::b64_encode(dest, src, len, b64_web);
+    }
+
+    constexpr size_t b64w_decode(char* dest, const char* src, size_t len)
+    {
+        return detail::b64_decode(dest, src, len, b64_web);
+    }
+
+    constexpr size_t b64r_encode(char* dest, const char* src, size_t len)
+    {
+        return detail::b64_encode(dest, src, len, b64_rfc);
+    }
+
+    constexpr size_t b64r_decode(char* dest, const char* src, size_t len)
+    {
+        return detail::b64_decode(dest, src, len, b64_rfc);
+    }
+
+    /**
+     * \brief base16 encode, upper case, see modp_b16_encode
+     */
+    constexpr size_t b16_encode(char* dest, const char* src, size_t len)
+    {
+        size_t i = 0;
+        unsigned x = 0;
+
+        for (i = 0; i < len; ++i) {
+            x = static_cast<unsigned char>(src[i]);
+            dest[2 * i] = detail::hex_char(x >> 4);
+            dest[2 * i + 1] = detail::hex_char(x & 0x0F);
+        }
+        dest[2 * len] = '\0';
+        return 2 * len;
+    }
+
+    /**
+     * \brief base16 decode, either case, see modp_b16_decode
+     */
+    constexpr size_t b16_decode(char* dest, const char* src, size_t len)
+    {
+        size_t i = 0;
+        unsigned hi = 0;
+        unsigned lo = 0;
+
+        if (len % 2 != 0) {
+            return (size_t)-1;
+        }
+        for (i = 0; i < len; i += 2) {
+            hi = detail::hex_value(src[i]);
+            lo = detail::hex_value(src[i + 1]);
+            if (hi > 15 || lo > 15) {
+                return (size_t)-1;
+            }
+            dest[i / 2] = static_cast<char>((hi << 4) | lo);
+        }
+        return len / 2;
+    }
+
+    /**
+     * \brief url encode, see modp_burl_encode
+     */
+    constexpr size_t url_encode(char* dest, const char* src, size_t len)
+    {
+        size_t i = 0;
+        size_t j = 0;
+        unsigned char c = 0;
+
+        for (i = 0; i < len; ++i) {
+            c = static_cast<unsigned char>(src[i]);
+            if (detail::url_safe(c)) {
+                dest[j++] = static_cast<char>(c);
+            } else if (c == ' ') {
+                dest[j++] = '+';
+            } else {
+                dest[j++] = '%';
+                dest[j++] = detail::hex_char(c >> 4);
+                dest[j++] = detail::hex_char(c & 0x0F);
+            }
+        }
+        dest[j] = '\0';
+        return j;
+    }
+
+    /* literal versions */
+
+    template <size_t N>
+    constexpr fixed_string<modp_b64_encode_strlen((N - 1))>
+    b64_encode(const char (&s)[N])
+    {
+        return detail::b64_encode(s, b64_std);
+    }
+
+    template <size_t N>
+    constexpr fixed_string<modp_b64_decode_len((N - 1))>
+    b64_decode(const char (&s)[N])
+    {
+        return detail::b64_decode(s, b64_std);
+    }
+
+    template <size_t N>
+    constexpr fixed_string<modp_b64_encode_strlen((N - 1))>
+    b64w_encode(const char (&s)[N])
+    {
+        return detail::b64_encode(s, b64_web);
+    }
+
+    template <size_t N>
+    constexpr fixed_string<modp_b64_decode_len((N - 1))>
+    b64w_decode(const char (&s)[N])
+    {
+        return detail::b64_decode(s, b64_web);
+    }
+
+    template <size_t N>
+    constexpr fixed_string<modp_b64_encode_strlen((N - 1))>
+    b64r_encode(const char (&s)[N])
+    {
+        return detail::b64_encode(s, b64_rfc);
+    }
+
+    template <size_t N>
+    constexpr fixed_string<modp_b64_decode_len((N - 1))>
+    b64r_decode(const char (&s)[N])
+    {
+        return detail::b64_decode(s, b64_rfc);
+    }
+
+    template <size_t N>
+    constexpr fixed_string<modp_b16_encode_strlen((N - 1))>
+    b16_encode(const char (&s)[N])
+    {
+        fixed_string<modp_b16_encode_strlen((N - 1))> x;
+        x.len = b16_encode(x.buf, s, N - 1);
+        return x;
+    }
+
+    template <size_t N>
+    constexpr fixed_string<(N - 1) / 2>
+    b16_decode(const char (&s)[N])
+    {
+        fixed_string<(N - 1) / 2> x;
+        size_t d = b16_decode(x.buf, s, N - 1);
+        if (d == (size_t)-1) {
+            x.valid = false;
+        } else {
+            x.len = d;
+            x.buf[d] = '\0';
+        }
+        return x;
+    }
+
+    template <size_t N>
+    constexpr fixed_string<3 * (N - 1)>
+    url_encode(const char (&s)[N])
+    {
+        fixed_string<3 * (N - 1)> x;
+        x.len = url_encode(x.buf, s, N - 1);
+        return x;
+    }
+
+    /* table builders */
+
+    /**
+     * modp_b64_gen encode tables: which is 0, 1 or 2 for e0, e1, e2
+     */
+    constexpr table<uint8_t> b64_encode_table(int which, b64_alphabet a = b64_std)
+    {
+        table<uint8_t> t;
+        unsigned i = 0;
+
+        for (i = 0; i < 256; ++i) {
+            t.v[i] = static_cast<uint8_t>(detail::b64_char(which == 0 ? (i >> 2) & 0x3F
+                                                           : i & 0x3F, a));
+        }
+        return t;
+    }
+
+    /**
+     * modp_b64_gen decode tables: which is 0 to 3 for d0 to d3.  The
+     * layout depends on the byte order, as with WORDS_BIGENDIAN.
+     */
+    constexpr table<uint32_t> b64_decode_table(int which, bool big_endian,
+                                               b64_alphabet a = b64_std)
+    {
+        table<uint32_t> t;
+        unsigned i = 0;
+        uint32_t x = 0;
+
+        for (i = 0; i < 256; ++i) {
+            t.v[i] = 0x01FFFFFF;
+        }
+        for (i = 0; i < 64; ++i) {
+            if (big_endian) {
+                x = i << (18 - 6 * which);
+            } else if (which == 0) {
+                x = i << 2;
+            } else if (which == 1) {
+                x = ((i & 0x30) >> 4) | ((i & 0x0F) << 12);
+            } else if (which == 2) {
+                x = ((i & 0x03) << 22) | ((i & 0x3C) << 6);
+            } else {
+                x = i << 16;
+            }
+            t.v[static_cast<unsigned char>(detail::b64_char(i, a))] = x;
+        }
+        return t;
+    }
+
+    /**
+     * hex encode tables: high is true for the high nibble char
+     * (gsHexEncodeC1), false for the low one (gsHexEncodeC2)
+     */
+    constexpr table<uint8_t> hex_encode_table(bool high)
+    {
+        table<uint8_t> t;
+        unsigned i = 0;
+
+        for (i = 0; i < 256; ++i) {
+            t.v[i] = static_cast<uint8_t>(detail::hex_char(high ? i >> 4 : i & 0x0F));
+        }
+        return t;
+    }
+
+    /**
+     * hex decode tables, 256 for a bad char: shifted is false for
+     * gsHexDecodeMap, true for gsHexDecodeD2
+     */
+    constexpr table<uint32_t> hex_decode_table(bool shifted)
+    {
+        table<uint32_t> t;
+        unsigned i = 0;
+        unsigned x = 0;
+
+        for (i = 0; i < 256; ++i) {
+            x = detail::hex_value(static_cast<char>(i));
+            t.v[i] = (x > 15) ? 256u : (shifted ? x << 4 : x);
+        }
+        return t;
+    }
+
+    /**
+     * the url map of modp_burl_gen.c: the char itself if safe, '+'
+     * for space, 0 if it needs a %XX escape
+     */
+    constexpr table<uint8_t> url_encode_table()
+    {
+        table<uint8_t> t;
+        unsigned i = 0;
+
+        for (i = 0; i < 256; ++i) {
+            t.v[i] = detail::url_safe(static_cast<unsigned char>(i))
+                ? static_cast<uint8_t>(i) : 0;
+        }
+        t.v[static_cast<unsigned char>(' ')] = '+';
+        return t;
+    }
+
+}   /* namespace ct */
+}   /* namespace modp */
+
+#endif  /* COM_MODP_STRINGENCODERS_CONSTEXPR */
@@ -0,0 +1,427 @@
+/* -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_cxx.h
+ * \brief support for the C++ wrappers in namespace modp
+ *
+ * Every codec header uses MODP_CXX_CODEC to get a common set of
+ * overloads that avoid a temporary std::string:
+ *
+ * \code
+ * // write into a caller buffer, -1 if destlen is too small
+ * size_t b64_encode(char* dest, size_t destlen, const char* s, size_t len);
+ *
+ * // append to a std::string, std::vector<char> or std::vector<uint8_t>
+ * // returns bytes added, or -1 with out unchanged
+ * size_t b64_encode_append(Container& out, const char* s, size_t len);
+ * size_t b64_encode_append(Container& out, std::string_view s);  // C++17
+ *
+ * std::string b64_encode(std::string_view s);                    // C++17
+ * size_t b64_encode(std::span<char> dest, std::string_view s);   // C++20
+ * \endcode
+ *
+ * Appending to a std::string does not zero fill the new space if the
+ * library has std::string::resize_and_overwrite (C++23).
+ *
+ * With std::pmr (C++17) there is also
+ *
+ * \code
+ * std::pmr::string b64_encode(std::string_view s, std::pmr::memory_resource* mr);
+ * \endcode
+ *
+ * so results can live in a modp::arena (see modp_alloc.h).  The
+ * _append and _to overloads work with std::pmr containers as is.
+ *
+ * For other destinations each codec also has
+ *
+ * \code
+ * size_t b64_encode_to(Sink& sink, const char* s, size_t len);
+ * \endcode
+ *
+ * where Sink is a std::string, a std::vector of 1-byte elements, or
+ * any type with these two members:
+ *
+ * \code
+ * char* prepare(size_t n);   // room for at least n bytes, or NULL
+ * void commit(size_t n);     // n bytes were written, n <= the prepared size
+ * \endcode
+ *
+ * The codec writes straight into the memory from prepare, so network
+ * buffers, ropes or arenas get the output without a copy.  A NULL
+ * from prepare makes the call return -1.  modp::array_sink and
+ * modp::iterator_sink adapt fixed buffers and output iterators.
+ *
+ * This header is included by the codec headers, there is no need to
+ * include it directly.
+ */
+
+/*
+ * <PRE>
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_CXX
+#define COM_MODP_STRINGENCODERS_CXX
+
+#ifdef __cplusplus
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#define MODP_HAS_STRING_VIEW 1
+#endif
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define MODP_HAS_PMR 1
+#endif
+#endif
+
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#define MODP_HAS_SPAN 1
+#endif
+#endif
+
+namespace modp {
+namespace detail {
+
+    /** the signature shared by the C codecs */
+    typedef size_t (*codec_fn)(char* dest, const char* src, size_t len);
+
+    /**
+     * Run a codec into a caller buffer of destlen bytes, where the
+     * codec needs up to need bytes.
+     */
+    inline size_t into(char* dest, size_t destlen, codec_fn fn,
+                       const char* s, size_t len, size_t need)
+    {
+        if (destlen < need) {
+            return (size_t)-1;
+        }
+        return fn(dest, s, len);
+    }
+
+    /**
+     * Run a codec and append the output to a container with 1-byte
+     * elements and a resize method.  The container is unchanged on
+     * error.
+     */
+    template <class Container>
+    inline size_t append(Container& out, codec_fn fn,
+                         const char* s, size_t len, size_t need)
+    {
+        const size_t old = out.size();
+        char empty = '\0';
+        size_t d;
+
+        out.resize(old + need);
+        d = fn(need ? reinterpret_cast<char*>(&out[0]) + old : &empty, s, len);
+        out.resize(d == (size_t)-1 ? old : old + d);
+        return d;
+    }
+
+#ifdef __cpp_lib_string_resize_and_overwrite
+    inline size_t append(std::string& out, codec_fn fn,
+                         const char* s, size_t len, size_t need)
+    {
+        const size_t old = out.size();
+        size_t d = 0;
+
+        out.resize_and_overwrite(old + need, [&](char* p, size_t) {
+            d = fn(p + old, s, len);
+            return d == (size_t)-1 ? old : old + d;
+        });
+        return d;
+    }
+#endif
+
+    /**
+     * Run a codec into any sink with prepare/commit
+     */
+    template <class Sink>
+    inline size_t to_sink(Sink& sink, codec_fn fn,
+                          const char* s, size_t len, size_t need)
+    {
+        char* p = sink.prepare(need);
+        size_t d;
+
+        if (p == NULL) {
+            return (size_t)-1;
+        }
+        d = fn(p, s, len);
+        sink.commit(d == (size_t)-1 ? 0 : d);
+        return d;
+    }
+
+    /* standard containers are sinks too */
+
+    template <class T, class Traits, class Alloc>
+    inline size_t to_sink(std::basic_string<T, Traits, Alloc>& out, codec_fn fn,
+                          const char* s, size_t len, size_t need)
+    {
+        return append(out, fn, s, len, need);
+    }
+
+    template <class T, class Alloc>
+    inline size_t to_sink(std::vector<T, Alloc>& out, codec_fn fn,
+                          const char* s, size_t len, size_t need)
+    {
+        return append(out, fn, s, len, need);
+    }
+
+    /**
+     * Output space for the JSON and MessagePack writers: Inline bytes
+     * in the object itself, then a Buffer (std::string,
+     * std::vector<char>, ...) that doubles as needed.  take() hands
+     * over the Buffer without copying it.  An allocator given to the
+     * constructor is passed on to the Buffer.
+     */
+    template <class Buffer, size_t Inline>
+    class writer_storage {
+    public:
+        writer_storage() : heap_(false) {}
+
+        template <class Alloc>
+        explicit writer_storage(const Alloc& alloc) : buf_(alloc), heap_(false) {}
+
+#if __cplusplus >= 201103L
+        /** take over the contents of other, which is left empty */
+        writer_storage(writer_storage&& other, size_t used)
+            : buf_(std::move(other.buf_)), heap_(other.heap_)
+        {
+            if (!heap_) {
+                std::memcpy(small_, other.small_, used);
+            }
+            other.heap_ = false;
+        }
+#endif
+
+        char* base() { return heap_ ? reinterpret_cast<char*>(&buf_[0]) : small_; }
+        const char* base() const
+        {
+            return heap_ ? reinterpret_cast<const char*>(&buf_[0]) : small_;
+        }
+
+        /** room for n bytes after the first used, returns the new base */
+        char* reserve(size_t used, size_t n)
+        {
+            size_t cap = heap_ ? buf_.size() : Inline;
+            if (cap - used < n) {
+                while (cap < used + n) {
+                    cap *= 2;
+                }
+                buf_.resize(cap);
+                if (!heap_) {
+                    std::memcpy(&buf_[0], small_, used);
+                    heap_ = true;
+                }
+            }
+            return base();
+        }
+
+        /**
+         * The output as a Buffer.  It keeps the allocator of ours,
+         * e.g. the arena of a std::pmr::string.
+         */
+        Buffer take(size_t used)
+        {
+            if (heap_) {
+                buf_.resize(used);
+                heap_ = false;
+            } else {
+                buf_.assign(small_, small_ + used);
+            }
+#if __cplusplus >= 201103L
+            Buffer out(std::move(buf_));
+            buf_.clear();
+#else
+            Buffer out;
+            out.swap(buf_);
+#endif
+            return out;
+        }
+
+#if __cplusplus >= 201103L
+        /**
+         * Take over the contents of other, which is left empty.  The
+         * buffer is copied only if the allocators differ.
+         */
+        void steal(writer_storage& other, size_t used)
+        {
+            heap_ = other.heap_;
+            if (heap_) {
+                buf_ = std::move(other.buf_);
+                other.heap_ = false;
+            } else {
+                std::memcpy(small_, other.small_, used);
+            }
+        }
+#endif
+
+    private:
+        writer_storage(const writer_storage&);
+        writer_storage& operator=(const writer_storage&);
+
+        Buffer buf_;
+        bool heap_;
+        char small_[Inline];
+    };
+
+}   /* namespace detail */
+
+    /**
+     * A sink over a fixed size buffer.  Output past the end is refused
+     * (the codec returns -1), never truncated.
+     */
+    class array_sink {
+    public:
+        array_sink(char* buf, size_t cap) : buf_(buf), cap_(cap), len_(0) {}
+
+        template <size_t N>
+        explicit array_sink(char (&buf)[N]) : buf_(buf), cap_(N), len_(0) {}
+
+        template <size_t N>
+        explicit array_sink(unsigned char (&buf)[N])
+            : buf_(reinterpret_cast<char*>(buf)), cap_(N), len_(0) {}
+
+        char* prepare(size_t n)
+        {
+            return (cap_ - len_ < n) ? NULL : buf_ + len_;
+        }
+
+        void commit(size_t n) { len_ += n; }
+
+        const char* data() const { return buf_; }
+        size_t size() const { return len_; }
+        void clear() { len_ = 0; }
+
+    private:
+        char* buf_;
+        size_t cap_;
+        size_t len_;
+    };
+
+    /**
+     * A sink that copies to an output iterator, e.g.
+     * std::back_inserter or std::ostreambuf_iterator.  The codec runs
+     * into a scratch buffer that is kept and reused between calls.
+     */
+    template <class OutputIt>
+    class iterator_sink {
+    public:
+        explicit iterator_sink(OutputIt it) : it_(it) {}
+
+        char* prepare(size_t n)
+        {
+            if (scratch_.size() < n) {
+                scratch_.resize(n);
+            }
+            return n ? &scratch_[0] : NULL;
+        }
+
+        void commit(size_t n)
+        {
+            it_ = std::copy(scratch_.begin(),
+                            scratch_.begin() + static_cast<std::ptrdiff_t>(n), it_);
+        }
+
+        OutputIt base() const { return it_; }
+
+    private:
+        OutputIt it_;
+        std::vector<char> scratch_;
+    };
+
+    template <class OutputIt>
+    inline iterator_sink<OutputIt> make_iterator_sink(OutputIt it)
+    {
+        return iterator_sink<OutputIt>(it);
+    }
+
+}   /* namespace modp */
+
+#ifdef MODP_HAS_STRING_VIEW
+#define MODP_CXX_CODEC_SV(NAME)                                         \
+    inline std::string NAME(std::string_view s)                        \
+    {                                                                   \
+        std::string x;                                                  \
+        NAME##_append(x, s.data(), s.size());                           \
+        return x;                                                       \
+    }                                                                   \
+    template <class Container>                                          \
+    inline size_t NAME##_append(Container& out, std::string_view s)    \
+    {                                                                   \
+        return NAME##_append(out, s.data(), s.size());                  \
+    }
+#else
+#define MODP_CXX_CODEC_SV(NAME)
+#endif
+
+#ifdef MODP_HAS_PMR
+#define MODP_CXX_CODEC_PMR(NAME)                                        \
+    inline std::pmr::string NAME(std::string_view s,                    \
+                                 std::pmr::memory_resource* mr)         \
+    {                                                                   \
+        std::pmr::string x(mr);                                         \
+        NAME##_append(x, s.data(), s.size());                           \
+        return x;                                                       \
+    }
+#else
+#define MODP_CXX_CODEC_PMR(NAME)
+#endif
+
+#ifdef MODP_HAS_SPAN
+#define MODP_CXX_CODEC_SPAN(NAME)                                       \
+    inline size_t NAME(std::span<char> dest, std::string_view s)       \
+    {                                                                   \
+        return NAME(dest.data(), dest.size(), s.data(), s.size());      \
+    }
+#else
+#define MODP_CXX_CODEC_SPAN(NAME)
+#endif
+
+/**
+ * Declare the overloads listed above.
+ *
+ * \param NAME the C++ name, e.g. b64_encode
+ * \param FN the C function, e.g. modp_b64_encode
+ * \param NEED bytes of output space needed, an expression using len
+ */
+#define MODP_CXX_CODEC(NAME, FN, NEED)                                  \
+    inline size_t NAME(char* dest, size_t destlen,                      \
+                       const char* s, size_t len)                       \
+    {                                                                   \
+        return ::modp::detail::into(dest, destlen, FN, s, len, (NEED)); \
+    }                                                                   \
+    template <class Container>                                          \
+    inline size_t NAME##_append(Container& out, const char* s, size_t len) \
+    {                                                                   \
+        return ::modp::detail::append(out, FN, s, len, (NEED));         \
+    }                                                                   \
+    template <class Sink>                                               \
+    inline size_t NAME##_to(Sink& sink, const char* s, size_t len)     \
+    {                                                                   \
+        return ::modp::detail::to_sink(sink, FN, s, len, (NEED));       \
+    }                                                                   \
+    MODP_CXX_CODEC_SV(NAME)                                             \
+    MODP_CXX_CODEC_PMR(NAME)                                            \
+    MODP_CXX_CODEC_SPAN(NAME)
+
+#endif  /* __cplusplus */
+
+#endif  /* COM_MODP_STRINGENCODERS_CXX */
@@ -0,0 +1,148 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+/**
+ * \file modp_datauri.c
+ * <PRE>
+ * MODP_DATAURI - High performance data URI encoder/decoder
+ * http://code.google.com/p/stringencoders/
+ *
+ * Copyright &copy; 2026  Nick Galbreath -- nickg [at] modp [dot] com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the modp.com nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This is the standard "new" BSD license:
+ * http://www.opensource.org/licenses/bsd-license.php
+ * </PRE>
+ */
+
+#include "config.h"
+#include "modp_datauri.h"
+#include "modp_stats.h"
+#include "modp_probe.h"
+#include "modp_internal.h"
+#include "modp_b64.h"
+#include "modp_burl.h"
+#include "modp_stdint.h"
+
+static size_t datauri_encode_impl(char* dest, const char* mime, size_t mime_len,
+                                  const char* src, size_t len)
+{
+    char* p = dest;
+
+    memcpy(p, "data:", 5);
+    p += 5;
+    memcpy(p, mime, mime_len);
+    p += mime_len;
+    memcpy(p, ";base64,", 8);
+    p += 8;
+
+    /* writes the final null */
+    p += modp_b64_encode_impl(p, src, len);
+    return (size_t)(p - dest);
+}
+
+/* true if s[0..len) ends with ";base64", any case */
+static int datauri_has_base64(const char* s, size_t len)
+{
+    static const char sMarker[] = ";base64";
+    size_t i;
+
+    if (len < 7) {
+        return 0;
+    }
+    s += len - 7;
+    for (i = 0; i < 7; ++i) {
+        if ((s[i] | 0x20) != sMarker[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static size_t datauri_decode_impl(struct modp_datauri_t* uri, char* buf, size_t len)
+{
+    const char* comma;
+    char* data;
+    size_t n;
+    size_t d;
+
+    if (len < 6 || (buf[0] | 0x20) != 'd' || (buf[1] | 0x20) != 'a' ||
+        (buf[2] | 0x20) != 't' || (buf[3] | 0x20) != 'a' || buf[4] != ':') {
+        return (size_t)-1;
+    }
+    comma = (const char*) memchr(buf + 5, ',', len - 5);
+    if (comma == NULL) {
+        return (size_t)-1;
+    }
+
+    uri->mime = buf + 5;
+    uri->mime_len = (size_t)(comma - uri->mime);
+    uri->base64 = datauri_has_base64(uri->mime, uri->mime_len);
+    if (uri->base64) {
+        uri->mime_len -= 7;
+    }
+
+    data = buf + (comma - buf) + 1;
+    n = len - (size_t)(data - buf);
+
+    if (!uri->base64) {
+        /* null terminates */
+        d = modp_burl_decode_raw_impl(data, data, n);
+    } else {
+        if (memchr(data, '%', n) != NULL) {
+            n = modp_burl_decode_raw_impl(data, data, n);
+        }
+        /*
+         * modp_b64_decode writes each 3 bytes before reading the
+         * next 4, so it can be run in place.  An empty payload is
+         * empty data, even when padding is required.
+         */
+        d = (n == 0) ? 0 : modp_b64_decode_impl(data, data, n);
+        if (d == (size_t)-1) {
+            return d;
+        }
+        data[d] = '\0';
+    }
+
+    uri->data = data;
+    uri->data_len = d;
+    return d;
+}
+
+size_t modp_datauri_encode(char* dest, const char* mime, size_t mime_len,
+                           const char* src, size_t len)
+{
+    MODP_COUNTED_SIZE(datauri_encode,
+                      datauri_encode_impl(dest, mime, mime_len, src, len), len);
+}
+
+size_t modp_datauri_decode(struct modp_datauri_t* uri, char* buf, size_t len)
+{
+    MODP_COUNTED_SIZE(datauri_decode, datauri_decode_impl(uri, buf, len), len);
+}
@@ -0,0 +1,145 @@
+/* -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_datauri.h
+ * \brief build and parse RFC 2397 "data:" URIs
+ *
+ * The writer emits "data:<mime>;base64," followed by the
+ * modp_b64_encode output into one exactly sized buffer.
+ *
+ * The parser finds the media type and decodes the payload, either
+ * base64 or percent-encoded, in place in the caller's buffer.
+ */
+
+/*
+ * <PRE>
+ * High Performance data URI encoder / decoder
+ *
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_DATAURI
+#define COM_MODP_STRINGENCODERS_DATAURI
+
+#include "modp_stdint.h"
+#include "modp_b64.h"
+#include "extern_c_begin.h"
+
+/**
+ * \brief write a base64 data URI
+ *
+ * \param[out] dest output, must be at least
+ *   modp_datauri_encode_len(mime_len, len) bytes
+ * \param[in] mime the media type, e.g. "image/png".  Copied as-is.
+ * \param[in] mime_len length of the media type, may be 0
+ * \param[in] src the payload
+ * \param[in] len length of the payload
+ * \return strlen of the output, the output is null terminated
+ */
+size_t modp_datauri_encode(char* dest, const char* mime, size_t mime_len,
+                           const char* src, size_t len);
+
+/**
+ * Exact strlen of a data URI with a media type of M bytes and a
+ * payload of A bytes: "data:" M ";base64," and the base64 text
+ */
+#define modp_datauri_encode_strlen(M, A) (13 + (M) + modp_b64_encode_strlen((A)))
+
+/**
+ * Memory needed for modp_datauri_encode, the strlen plus the null
+ */
+#define modp_datauri_encode_len(M, A) (modp_datauri_encode_strlen((M), (A)) + 1)
+
+/**
+ * Result of parsing a data URI.  Pointers are into the caller's
+ * buffer.
+ */
+struct modp_datauri_t {
+    const char* mime;   /**< media type and parameters, not including ";base64" */
+    size_t mime_len;    /**< 0 if none was given (means text/plain;charset=US-ASCII) */
+    int base64;         /**< 1 if the payload was base64 */
+    char* data;         /**< the decoded payload, null terminated */
+    size_t data_len;    /**< length of the decoded payload */
+};
+
+/**
+ * \brief parse a data URI and decode its payload in place
+ *
+ * "data:" is matched in any case.  A base64 payload may also be
+ * percent-encoded, as happens when a URI is pasted from a browser.
+ *
+ * \param[out] uri the parsed spans
+ * \param[in,out] buf the data URI.  The payload part is overwritten
+ *   with the decoded data.  Must have room for len + 1 bytes.
+ * \param[in] len length of the data URI
+ * \return length of the decoded payload, or -1 if this is not a
+ *   data URI or the base64 is invalid.
+ */
+size_t modp_datauri_decode(struct modp_datauri_t* uri, char* buf, size_t len);
+
+#include "extern_c_end.h"
+
+#ifdef __cplusplus
+#include <cstring>
+#include <string>
+
+namespace modp {
+
+    /**
+     * \brief make a base64 data URI
+     */
+    inline std::string datauri_encode(const std::string& mime, const char* s, size_t len)
+    {
+        std::string x(modp_datauri_encode_len(mime.size(), len), '\0');
+        size_t d = modp_datauri_encode(const_cast<char*>(x.data()),
+                                       mime.data(), mime.size(), s, len);
+        x.erase(d, std::string::npos);
+        return x;
+    }
+
+    inline std::string datauri_encode(const std::string& mime, const std::string& s)
+    {
+        return datauri_encode(mime, s.data(), s.size());
+    }
+
+    /**
+     * data URI decode a string (self-modifing)
+     * This function does not allocate memory.
+     *
+     * \param[in,out] s the data URI, replaced by the payload.  Empty
+     *   if failed.
+     * \param[out] mime if not NULL, set to the media type
+     * \return a reference to the input string
+     */
+    inline std::string& datauri_decode(std::string& s, std::string* mime = NULL)
+    {
+        struct modp_datauri_t uri;
+        size_t d = modp_datauri_decode(&uri, const_cast<char*>(s.data()), s.size());
+        if (d == (size_t)-1) {
+            s.clear();
+            if (mime) {
+                mime->clear();
+            }
+            return s;
+        }
+        if (mime) {
+            mime->assign(uri.mime, uri.mime_len);
+        }
+        /* payload is always at the end of the buffer */
+        s.erase(0, (size_t)(uri.data - s.data()));
+        s.erase(d, std::string::npos);
+        return s;
+    }
+
+}       /* namespace modp */
+
+#endif  /* __cplusplus */
+
+#endif  /* COM_MODP_STRINGENCODERS_DATAURI */
@@ -0,0 +1,407 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+/**
+ * \file modp_encword.c
+ * <PRE>
+ * MODP_ENCWORD - High performance RFC 2047 encoder/decoder
+ * http://code.google.com/p/stringencoders/
+ *
+ * Copyright &copy; 2026  Nick Galbreath -- nickg [at] modp [dot] com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the modp.com nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This is the standard "new" BSD license:
+ * http://www.opensource.org/licenses/bsd-license.php
+ * </PRE>
+ */
+
+#include "config.h"
+#include "modp_encword.h"
+#include "modp_stats.h"
+#include "modp_probe.h"
+#include "modp_internal.h"
+#include "modp_b64.h"
+#include "modp_stdint.h"
+#include "modp_swar.h"
+#include "modp_encword_data.h"
+
+/* "=?UTF-8?B?" and "?=" */
+#define ENCWORD_OVERHEAD 12
+
+/* chars of encoded text that fit in one word */
+#define ENCWORD_PAYLOAD (MODP_ENCWORD_MAX - ENCWORD_OVERHEAD)
+
+/* input bytes per B word, a multiple of 3 so only the last is padded */
+#define ENCWORD_B_BYTES ((ENCWORD_PAYLOAD / 4) * 3)
+
+#define IS_UTF8_CONT(c) (((c) & 0xC0) == 0x80)
+
+#define IS_LWSP(c) ((c) == ' ' || (c) == '\t' || (c) == '\r' || (c) == '\n')
+
+/*
+ * Non-zero if a word has a byte that might stop it from being passed
+ * through as-is
+ */
+#define ENCWORD_WORD_NEEDS_WORK(w) \
+    (MODP_WORD_HASLESS(w, 0x20) | MODP_WORD_HASMORE(w, 0x7E) | \
+     MODP_WORD_HASBYTE(w, '='))
+
+/**
+ * True if the input is printable ascii with no "=?" and can be used
+ * as the header value without encoding
+ */
+static int encword_is_plain(const uint8_t* s, size_t len)
+{
+    size_t i = 0;
+    modp_word_t w;
+    uint8_t c;
+
+    for (;;) {
+        while (i + MODP_WORD_SIZE <= len) {
+            MODP_WORD_LOAD(w, s + i);
+            if (ENCWORD_WORD_NEEDS_WORK(w)) {
+                break;
+            }
+            i += MODP_WORD_SIZE;
+        }
+        if (i == len) {
+            return 1;
+        }
+        c = s[i];
+        if (c < 0x20 || c > 0x7E) {
+            return 0;
+        }
+        if (c == '=' && i + 1 < len && s[i + 1] == '?') {
+            return 0;
+        }
+        ++i;
+    }
+}
+
+/**
+ * Length of the Q encoded text, not counting per-word overhead
+ */
+static size_t encword_q_strlen(const uint8_t* s, size_t len)
+{
+    size_t i;
+    size_t count = len;
+
+    for (i = 0; i < len; ++i) {
+        if (gsQEncodeMap[s[i]] == 'E') {
+            count += 2;
+        }
+    }
+    return count;
+}
+
+static char* encword_start(char* p, int first, char enc)
+{
+    if (!first) {
+        /* fold */
+        p[0] = '\r';
+        p[1] = '\n';
+        p[2] = ' ';
+        p += 3;
+    }
+    memcpy(p, "=?UTF-8?", 8);
+    p[8] = enc;
+    p[9] = '?';
+    return p + 10;
+}
+
+static char* encword_b(char* p, const uint8_t* s, size_t len)
+{
+    size_t i = 0;
+    size_t n;
+    size_t k;
+
+    while (i < len) {
+        n = len - i;
+        if (n > ENCWORD_B_BYTES) {
+            n = ENCWORD_B_BYTES;
+            /*
+             * back up to the start of a UTF-8 char, but no more than
+             * a char's worth for input that isn't really UTF-8
+             */
+            for (k = 0; k < 3 && IS_UTF8_CONT(s[i + n - k]); ++k) {
+            }
+            if (!IS_UTF8_CONT(s[i + n - k])) {
+                n -= k;
+            }
+        }
+        p = encword_start(p, i == 0, 'B');
+        p += modp_b64_encode_impl(p, (const char*)(s + i), n);
+        p[0] = '?';
+        p[1] = '=';
+        p += 2;
+        i += n;
+    }
+    return p;
+}
+
+static char* encword_q(char* p, const uint8_t* s, size_t len)
+{
+    size_t i = 0;
+    size_t j;
+    size_t n;
+    size_t cost;
+    size_t col;
+    uint8_t c;
+
+    while (i < len) {
+        p = encword_start(p, i == 0, 'Q');
+        col = 0;
+        while (i < len) {
+            /* one whole UTF-8 char at a time */
+            n = 1;
+            while (n < 4 && i + n < len && IS_UTF8_CONT(s[i + n])) {
+                ++n;
+            }
+            cost = 0;
+            for (j = 0; j < n; ++j) {
+                cost += (gsQEncodeMap[s[i + j]] == 'E') ? 3 : 1;
+            }
+            if (col > 0 && col + cost > ENCWORD_PAYLOAD) {
+                break;
+            }
+            for (j = 0; j < n; ++j) {
+                c = s[i + j];
+                switch (gsQEncodeMap[c]) {
+                case 0:
+                    *p++ = (char) c;
+                    break;
+                case '_':
+                    *p++ = '_';
+                    break;
+                default:
+                    p[0] = '=';
+                    p[1] = (char) gsHexEncodeMap1[c];
+                    p[2] = (char) gsHexEncodeMap2[c];
+                    p += 3;
+                }
+            }
+            col += cost;
+            i += n;
+        }
+        p[0] = '?';
+        p[1] = '=';
+        p += 2;
+    }
+    return p;
+}
+
+static size_t encword_encode_impl(char* dest, const char* src, size_t len)
+{
+    const uint8_t* s = (const uint8_t*) src;
+    char* p = dest;
+
+    if (encword_is_plain(s, len)) {
+        memcpy(dest, src, len);
+        dest[len] = '\0';
+        return len;
+    }
+
+    /* pick the shorter encoding, ties go to Q since it's readable */
+    if (encword_q_strlen(s, len) <= 4 * ((len + 2) / 3)) {
+        p = encword_q(p, s, len);
+    } else {
+        p = encword_b(p, s, len);
+    }
+    *p = '\0';
+    return (size_t)(p - dest);
+}
+
+/**
+ * Parse an encoded-word at the start of s.
+ *
+ * \param[out] enc 'b' or 'q'
+ * \param[out] text offset of the encoded text
+ * \param[out] tlen length of the encoded text
+ * \return length of the whole word, or 0 if s does not start with one
+ */
+static size_t encword_parse(const uint8_t* s, size_t len, uint8_t* enc,
+                            size_t* text, size_t* tlen)
+{
+    size_t i = 2;
+
+    if (len < 2 || s[0] != '=' || s[1] != '?') {
+        return 0;
+    }
+
+    /* charset, and optional RFC 2231 language */
+    while (i < len && s[i] != '?') {
+        if (s[i] <= ' ' || s[i] >= 0x7F) {
+            return 0;
+        }
+        ++i;
+    }
+    if (i == 2 || i + 2 >= len || s[i + 2] != '?') {
+        return 0;
+    }
+    *enc = (uint8_t)(s[i + 1] | 0x20);
+    if (*enc != 'b' && *enc != 'q') {
+        return 0;
+    }
+
+    i += 3;
+    *text = i;
+    while (i < len && s[i] != '?') {
+        if (s[i] <= ' ' || s[i] >= 0x7F) {
+            return 0;
+        }
+        ++i;
+    }
+    if (i + 1 >= len || s[i + 1] != '=') {
+        return 0;
+    }
+    *tlen = i - *text;
+    return i + 2;
+}
+
+/**
+ * Decode the encoded-word at the start of s into dest.
+ *
+ * \param[out] wlen length of the word consumed
+ * \return bytes written or -1 if s does not start with a valid word
+ */
+static size_t encword_word(char* dest, const uint8_t* s, size_t len,
+                           size_t* wlen)
+{
+    uint8_t enc;
+    size_t text;
+    size_t tlen;
+    size_t i;
+    uint32_t d;
+    char* p = dest;
+
+    *wlen = encword_parse(s, len, &enc, &text, &tlen);
+    if (*wlen == 0) {
+        return (size_t)-1;
+    }
+    s += text;
+
+    if (enc == 'b') {
+        /* padding is required, which also keeps modp_b64 in bounds */
+        if (tlen % 4 != 0) {
+            return (size_t)-1;
+        }
+        return modp_b64_decode_impl(dest, (const char*) s, tlen);
+    }
+
+    i = 0;
+    while (i < tlen) {
+        if (s[i] == '_') {
+            *p++ = ' ';
+            i += 1;
+        } else if (s[i] != '=') {
+            *p++ = (char) s[i];
+            i += 1;
+        } else {
+            if (i + 2 >= tlen) {
+                return (size_t)-1;
+            }
+            d = (gsHexDecodeMap[s[i + 1]] << 4) | gsHexDecodeMap[s[i + 2]];
+            if (d >= 256) {
+                return (size_t)-1;
+            }
+            *p++ = (char) d;
+            i += 3;
+        }
+    }
+    return (size_t)(p - dest);
+}
+
+static size_t encword_decode_impl(char* dest, const char* src, size_t len)
+{
+    const uint8_t* s = (const uint8_t*) src;
+    const uint8_t* pos;
+    char* p = dest;
+    size_t i = 0;
+    size_t j;
+    size_t n;
+    size_t d;
+    int after_word = 0;
+
+    while (i < len) {
+        if (!after_word) {
+            /* plain text up to the next '=' */
+            pos = (const uint8_t*) memchr(s + i, '=', len - i);
+            n = (pos == NULL) ? len - i : (size_t)(pos - (s + i));
+            memcpy(p, s + i, n);
+            p += n;
+            i += n;
+            if (i == len) {
+                break;
+            }
+        }
+
+        if (s[i] == '=') {
+            d = encword_word(p, s + i, len - i, &n);
+            if (d != (size_t)-1) {
+                p += d;
+                i += n;
+                after_word = 1;
+                continue;
+            }
+        } else if (IS_LWSP(s[i])) {
+            /* white space between two encoded-words is dropped */
+            j = i + 1;
+            while (j < len && IS_LWSP(s[j])) {
+                ++j;
+            }
+            d = encword_word(p, s + j, len - j, &n);
+            if (d != (size_t)-1) {
+                p += d;
+                i = j + n;
+                continue;
+            }
+            memcpy(p, s + i, j - i);
+            p += j - i;
+            i = j;
+            after_word = 0;
+            continue;
+        }
+
+        *p++ = (char) s[i];
+        i += 1;
+        after_word = 0;
+    }
+    *p = '\0';
+    return (size_t)(p - dest);
+}
+
+size_t modp_encword_encode(char* dest, const char* src, size_t len)
+{
+    MODP_COUNTED_SIZE(encword_encode, encword_encode_impl(dest, src, len), len);
+}
+
+size_t modp_encword_decode(char* dest, const char* src, size_t len)
+{
+    MODP_COUNTED_SIZE(encword_decode, encword_decode_impl(dest, src, len), len);
+}
@@ -0,0 +1,131 @@
+/* -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_encword.h
+ * \brief RFC 2047 "encoded-word" encoding and decoding for mail headers
+ *
+ * Non-ascii text in headers such as Subject and From is written as
+ * one or more "=?UTF-8?B?...?=" or "=?UTF-8?Q?...?=" words.
+ *
+ * The encoder picks the B (base64) or Q (quoted-printable like)
+ * encoding, whichever is shorter for the input.  Each word is at
+ * most 75 chars, never splits a UTF-8 char, and words are folded
+ * with CRLF SPACE.  Input that is already plain printable ascii is
+ * passed through unchanged.
+ *
+ * The decoder handles any number of words mixed with plain text in
+ * one pass, dropping the white space between adjacent words.  The
+ * charset is not converted: the decoded bytes are written as-is.
+ * Malformed words are passed through as plain text.
+ *
+ * Neither function allocates memory.
+ */
+
+/*
+ * <PRE>
+ * High Performance RFC 2047 encoder / decoder
+ *
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_ENCWORD
+#define COM_MODP_STRINGENCODERS_ENCWORD
+
+#include "modp_stdint.h"
+#include "extern_c_begin.h"
+
+/**
+ * Maximum length of a single encoded-word, from the RFC
+ */
+#define MODP_ENCWORD_MAX 75
+
+/**
+ * \brief encode a UTF-8 header value as RFC 2047 encoded-words
+ *
+ * \param[out] dest output, must be at least modp_encword_encode_len(len) bytes
+ * \param[in] src UTF-8 input
+ * \param[in] len length of input
+ * \return strlen of the output, the output is null terminated
+ */
+size_t modp_encword_encode(char* dest, const char* src, size_t len);
+
+/**
+ * Memory needed to encode A bytes, a bit more than the base64 size
+ * plus the per-word overhead.
+ */
+#define modp_encword_encode_len(A) (2*(A) + 32)
+
+/**
+ * \brief decode a header value containing RFC 2047 encoded-words
+ *
+ * \param[out] dest output, must be at least modp_encword_decode_len(len)
+ *   bytes.  Must not overlap src.
+ * \param[in] src input
+ * \param[in] len length of input
+ * \return strlen of the output, the output is null terminated
+ */
+size_t modp_encword_decode(char* dest, const char* src, size_t len);
+
+/**
+ * Memory needed to decode A bytes.
+ */
+#define modp_encword_decode_len(A) ((A) + 1)
+
+#include "extern_c_end.h"
+
+#ifdef __cplusplus
+#include <cstring>
+#include <string>
+#include "modp_cxx.h"
+
+namespace modp {
+
+    MODP_CXX_CODEC(encword_encode, modp_encword_encode, modp_encword_encode_len(len))
+    MODP_CXX_CODEC(encword_decode, modp_encword_decode, modp_encword_decode_len(len))
+
+    inline std::string encword_encode(const char* s, size_t len)
+    {
+        std::string x;
+        encword_encode_append(x, s, len);
+        return x;
+    }
+
+    inline std::string encword_encode(const char* s)
+    {
+        return encword_encode(s, strlen(s));
+    }
+
+    inline std::string encword_encode(const std::string& s)
+    {
+        return encword_encode(s.data(), s.size());
+    }
+
+    inline std::string encword_decode(const char* s, size_t len)
+    {
+        std::string x;
+        encword_decode_append(x, s, len);
+        return x;
+    }
+
+    inline std::string encword_decode(const char* s)
+    {
+        return encword_decode(s, strlen(s));
+    }
+
+    inline std::string encword_decode(const std::string& s)
+    {
+        return encword_decode(s.data(), s.size());
+    }
+
+}       /* namespace modp */
+
+#endif  /* __cplusplus */
+
+#endif  /* COM_MODP_STRINGENCODERS_ENCWORD */
@@ -0,0 +1,138 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_escape.h
+ * \brief the loop shared by the escaping encoders (internal)
+ *
+ * burl, burl_min, javascript, the JSON string and xml encoders differ
+ * only in which bytes they escape and how.  Each is two tables made
+ * by its generator with escape_array_to_c (arraytoc.c), or
+ * escapearray_to_c in modp_json_gen.py:
+ *
+ *  - name##Len[256], how many bytes the byte is written as, 0 if it
+ *    is copied as-is
+ *  - name##Esc[256][8], those bytes.  An as-is byte is itself.
+ *
+ * A new escaper is a new pair of tables.
+ *
+ * Runs of as-is bytes are skipped 8 at a time by or-ing their Len
+ * entries, which works for any set of bytes, where the SWAR range
+ * tests of modp_swar.h need a set made of a few ranges.  A word with
+ * work in it is written with one 8 byte store per byte, and no
+ * branches, as long as there are 7 more bytes of input behind it to
+ * cover the overrun.
+ *
+ * This header is not installed and is not part of the public API.
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_ESCAPE
+#define COM_MODP_STRINGENCODERS_ESCAPE
+
+#include <string.h>
+#include "modp_stdint.h"
+
+/** bytes in each escape table entry, the longest escape is 7 */
+#define MODP_ESCAPE_MAX 8
+
+/** non-zero if any of the 8 bytes at s is not as-is */
+#define MODP_ESCAPE_WORD(lens, s) \
+    ((lens)[(s)[0]] | (lens)[(s)[1]] | (lens)[(s)[2]] | (lens)[(s)[3]] | \
+     (lens)[(s)[4]] | (lens)[(s)[5]] | (lens)[(s)[6]] | (lens)[(s)[7]])
+
+/**
+ * \brief escape len bytes of src, no '\\0' is added
+ *
+ * \param[out] dest at least modp_escape_strlen() bytes
+ * \param[in] lens the Len table of the escaper
+ * \param[in] esc the Esc table of the escaper
+ * \return the bytes written
+ */
+static size_t modp_escape_encode(char* dest, const char* src, size_t len,
+                                 const uint8_t* lens,
+                                 const char (*esc)[MODP_ESCAPE_MAX])
+{
+    const char* deststart = dest;
+    const uint8_t* s = (const uint8_t*) src;
+    const uint8_t* srcend = s + len;
+    const uint8_t* wordend;
+    size_t i;
+    size_t n;
+    uint8_t x;
+
+    /*
+     * with 15 bytes left each byte of the next word has 7 more
+     * behind it, written as at least 7 bytes, so storing all 8 bytes
+     * of an escape stays inside dest
+     */
+    while (srcend - s >= 2 * MODP_ESCAPE_MAX - 1) {
+        if (MODP_ESCAPE_WORD(lens, s) == 0) {
+            memcpy(dest, s, MODP_ESCAPE_MAX);
+            dest += MODP_ESCAPE_MAX;
+            s += MODP_ESCAPE_MAX;
+            continue;
+        }
+        wordend = s + MODP_ESCAPE_MAX;
+        while (s < wordend) {
+            x = *s++;
+            memcpy(dest, esc[x], MODP_ESCAPE_MAX);
+            n = lens[x];
+            dest += n + (size_t)(n == 0);
+        }
+    }
+
+    /* the same a byte at a time, while there are 7 bytes behind it */
+    while (srcend - s >= MODP_ESCAPE_MAX) {
+        x = *s++;
+        memcpy(dest, esc[x], MODP_ESCAPE_MAX);
+        n = lens[x];
+        dest += n + (size_t)(n == 0);
+    }
+
+    /* the last 7 bytes exactly */
+    while (s < srcend) {
+        x = *s++;
+        n = lens[x];
+        if (n == 0) {
+            *dest++ = (char) x;
+        } else {
+            for (i = 0; i < n; ++i) {
+                dest[i] = esc[x][i];
+            }
+            dest += n;
+        }
+    }
+    return (size_t)(dest - deststart);
+}
+
+/**
+ * \brief the exact bytes modp_escape_encode writes
+ */
+static size_t modp_escape_strlen(const char* src, size_t len,
+                                 const uint8_t* lens)
+{
+    const uint8_t* s = (const uint8_t*) src;
+    const uint8_t* srcend = s + len;
+    const uint8_t* wordend;
+    size_t count = 0;
+    size_t n;
+
+    while (s < srcend) {
+        if (srcend - s < MODP_ESCAPE_MAX) {
+            wordend = srcend;
+        } else if (MODP_ESCAPE_WORD(lens, s) == 0) {
+            count += MODP_ESCAPE_MAX;
+            s += MODP_ESCAPE_MAX;
+            continue;
+        } else {
+            wordend = s + MODP_ESCAPE_MAX;
+        }
+        while (s < wordend) {
+            n = lens[*s++];
+            count += n + (size_t)(n == 0);
+        }
+    }
+    return count;
+}
+
+#endif /* COM_MODP_STRINGENCODERS_ESCAPE */
@@ -0,0 +1,216 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_fuse.c
+ * <PRE>
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ *
+ * Each window is cut where the stages can start again, so coding the
+ * windows one after another is the same as coding all of the input:
+ *
+ *  - modp_burl_decode does not decode a '%' in the last 2 bytes of
+ *    its input, so a window never ends with one unless it is the last
+ *  - modp_utf8_validate steps over a sequence by the length its first
+ *    byte gives.  A sequence the window cuts is kept back and put in
+ *    front of the next window, or read again when there is no decode.
+ *  - the escapes are one byte at a time
+ */
+
+#include "config.h"
+
+#include <string.h>
+
+#include "modp_fuse.h"
+#include "modp_burl.h"
+#include "modp_utf8.h"
+#include "modp_probe.h"
+#include "modp_internal.h"
+#include "modp_swar.h"
+#include "modp_escape.h"
+#include "modp_xml_data.h"
+#include "modp_json_data.h"
+
+/* input bytes per window */
+#define FUSE_WINDOW 8192
+
+/* the bytes modp_utf8_validate steps over for a first byte of c */
+#define FUSE_UTF8_LEN(c) \
+    (((c) < 0x80) ? 1 : ((c) < 0xE0) ? 2 : ((c) < 0xF0) ? 3 : ((c) < 0xF8) ? 4 : 1)
+
+/*
+ * a guess at the bytes of the window before a sequence it cuts,
+ * looking back from the end.  Right for UTF-8, and checked by the
+ * caller as validating up to a cut returns MODP_UTF8_SHORT.
+ */
+static size_t fuse_utf8_guess(const char* src, size_t len)
+{
+    const uint8_t* s = (const uint8_t*) src;
+    size_t k;
+    uint8_t c;
+
+    for (k = 1; k <= 3 && k <= len; ++k) {
+        c = s[len - k];
+        if (c < 0x80) {
+            break;
+        }
+        if (c >= 0xC0) {
+            return (FUSE_UTF8_LEN(c) > k) ? len - k : len;
+        }
+    }
+    return len;
+}
+
+/*
+ * the bytes of the window that modp_utf8_validate steps over without
+ * running into its end, walking from the start like it does
+ */
+static size_t fuse_utf8_whole(const char* src, size_t len)
+{
+    const uint8_t* s = (const uint8_t*) src;
+    const uint8_t* srcend = s + len;
+    modp_word_t w;
+    size_t n;
+
+    while (s < srcend) {
+        if (srcend - s >= MODP_WORD_SIZE) {
+            MODP_WORD_LOAD(w, s);
+            if (!MODP_WORD_HASHIGH(w)) {
+                s += MODP_WORD_SIZE;
+                continue;
+            }
+        }
+        n = FUSE_UTF8_LEN(*s);
+        if (n > (size_t)(srcend - s)) {
+            break;
+        }
+        s += n;
+    }
+    return (size_t)(s - (const uint8_t*) src);
+}
+
+/*
+ * the escape stage, only counts if dest is NULL
+ */
+static size_t fuse_escape(char* dest, const char* src, size_t len, int stages)
+{
+    if (stages & MODP_FUSE_XML_ENCODE) {
+        return dest ? modp_escape_encode(dest, src, len, gsXmlEncodeLen, gsXmlEncodeEsc)
+            : modp_escape_strlen(src, len, gsXmlEncodeLen);
+    }
+    if (stages & MODP_FUSE_JSON_STRING) {
+        return dest ? modp_escape_encode(dest, src, len, gsJSONEncodeLen, gsJSONEncodeEsc)
+            : modp_escape_strlen(src, len, gsJSONEncodeLen);
+    }
+    if (dest) {
+        memcpy(dest, src, len);
+    }
+    return len;
+}
+
+static size_t fuse_impl(char* dest, const char* src, size_t len, int stages)
+{
+    /* a window, a sequence kept back and the null of modp_burl_decode */
+    char buf[FUSE_WINDOW + 8];
+    const char* s = src;
+    const char* srcend = src + len;
+    const char* win;
+    const int json = !(stages & MODP_FUSE_XML_ENCODE) && (stages & MODP_FUSE_JSON_STRING);
+    size_t count = 0;
+    size_t keep = 0;
+    size_t take;
+    size_t n;
+    size_t whole;
+    int rc;
+
+    if (json) {
+        if (dest) {
+            dest[0] = '"';
+        }
+        count = 1;
+    }
+
+    while (s < srcend) {
+        take = (size_t)(srcend - s);
+        if (take > FUSE_WINDOW) {
+            take = FUSE_WINDOW;
+        }
+        if (stages & MODP_FUSE_BURL_DECODE) {
+            if (s + take < srcend) {
+                if (s[take - 1] == '%') {
+                    take -= 1;
+                } else if (s[take - 2] == '%') {
+                    take -= 2;
+                }
+            }
+            n = keep + modp_burl_decode_impl(buf + keep, s, take);
+            win = buf;
+        } else {
+            n = take;
+            win = s;
+        }
+        s += take;
+
+        whole = n;
+        if (stages & MODP_FUSE_UTF8_VALIDATE) {
+            if (s < srcend) {
+                whole = fuse_utf8_guess(win, n);
+            }
+            rc = modp_utf8_validate_impl(win, whole);
+            if (rc == MODP_UTF8_SHORT && s < srcend) {
+                /* not UTF-8 the way it looked, walk it */
+                whole = fuse_utf8_whole(win, n);
+                rc = modp_utf8_validate_impl(win, whole);
+            }
+            if (rc != MODP_UTF8_OK) {
+                return (size_t) -1;
+            }
+        }
+
+        count += fuse_escape(dest ? dest + count : NULL, win, whole, stages);
+
+        /* a cut sequence waits for the rest of it */
+        keep = n - whole;
+        if (keep && (stages & MODP_FUSE_BURL_DECODE)) {
+            memmove(buf, buf + whole, keep);
+        } else {
+            s -= keep;
+            keep = 0;
+        }
+    }
+
+    if (json) {
+        if (dest) {
+            dest[count] = '"';
+        }
+        count += 1;
+    }
+    if (dest) {
+        dest[count] = '\0';
+    }
+    return count;
+}
+
+/*
+ * the public entry points, traced by the USDT probes of modp_probe.h
+ */
+
+size_t modp_fuse(char* dest, const char* src, size_t len, int stages)
+{
+    size_t r;
+    MODP_PROBE_ENTRY(fuse, len);
+    r = fuse_impl(dest, src, len, stages);
+    MODP_PROBE_RETURN(fuse, len, r);
+    return r;
+}
+
+size_t modp_fuse_strlen(const char* src, size_t len, int stages)
+{
+    return fuse_impl(NULL, src, len, stages);
+}
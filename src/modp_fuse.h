@@ -0,0 +1,85 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_fuse.h
+ * \brief decode, validate and escape in one pass
+ *
+ * Turning a form field into XML or JSON is usually modp_burl_decode,
+ * then modp_utf8_validate, then modp_xml_encode: three passes over
+ * the data and a buffer the size of the input between them.
+ * modp_fuse does the chosen stages a window of 8K at a time, so what
+ * one stage writes is still in cache when the next reads it, and only
+ * the input and the output go to memory.
+ *
+ * The output is the same as running the stages one after another.
+ *
+ * \code
+ * char* out = malloc(modp_fuse_len(len));
+ * size_t n = modp_fuse(out, src, len,
+ *                      MODP_FUSE_BURL_DECODE | MODP_FUSE_UTF8_VALIDATE |
+ *                      MODP_FUSE_XML_ENCODE);
+ * if (n == (size_t)-1) {
+ *     ... not UTF-8 ...
+ * }
+ * \endcode
+ *
+ * The stages are not counted by --enable-stats or traced on their
+ * own, modp_fuse has USDT probes of its own.
+ */
+
+/*
+ * <PRE>
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_FUSE
+#define COM_MODP_STRINGENCODERS_FUSE
+
+#include "modp_stdint.h"
+#include "extern_c_begin.h"
+
+/** first modp_burl_decode the input */
+#define MODP_FUSE_BURL_DECODE 0x01
+/** then fail unless modp_utf8_validate returns MODP_UTF8_OK */
+#define MODP_FUSE_UTF8_VALIDATE 0x02
+/** then modp_xml_encode */
+#define MODP_FUSE_XML_ENCODE 0x10
+/** or write a JSON string, as modp_json_add_string does, quotes included */
+#define MODP_FUSE_JSON_STRING 0x20
+
+/**
+ * \brief run the stages over src in one pass
+ *
+ * \param[out] dest output, at least modp_fuse_len(len) bytes
+ * \param[in] src input
+ * \param[in] len length of src
+ * \param[in] stages MODP_FUSE_ flags, at most one of XML_ENCODE and
+ *   JSON_STRING.  Without either the output is copied as-is.
+ * \return strlen of the output, the output is null terminated.  -1 if
+ *   MODP_FUSE_UTF8_VALIDATE is given and the text is not valid, dest
+ *   then has some of the output.
+ */
+size_t modp_fuse(char* dest, const char* src, size_t len, int stages);
+
+/**
+ * \brief the exact strlen of what modp_fuse writes, or -1 if the
+ * text is not valid
+ */
+size_t modp_fuse_strlen(const char* src, size_t len, int stages);
+
+/**
+ * Memory needed for any stages over A bytes: an escape is at most 6
+ * bytes, two quotes and the null
+ */
+#define modp_fuse_len(A) (6 * (A) + 3)
+
+#include "extern_c_end.h"
+
+#endif  /* COM_MODP_STRINGENCODERS_FUSE */
@@ -0,0 +1,37 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_internal.h
+ * \brief the uncounted codecs modules call each other with (internal)
+ *
+ * modp_datauri, modp_encword and modp_fuse code with the b64, burl
+ * and utf8 modules.  Calling the public functions would count and
+ * trace every one of those calls with --enable-stats and the USDT
+ * probes, so one call of the user's would show up as several.  These
+ * are the same functions without the counting.
+ *
+ * This header is not installed and is not part of the public API.
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_INTERNAL
+#define COM_MODP_STRINGENCODERS_INTERNAL
+
+#include "modp_stdint.h"
+
+/** modp_b64_encode, not counted */
+size_t modp_b64_encode_impl(char* dest, const char* str, size_t len);
+
+/** modp_b64_decode, not counted */
+size_t modp_b64_decode_impl(char* dest, const char* src, size_t len);
+
+/** modp_burl_decode, not counted */
+size_t modp_burl_decode_impl(char* dest, const char* s, size_t len);
+
+/** modp_burl_decode_raw, not counted */
+size_t modp_burl_decode_raw_impl(char* dest, const char* s, size_t len);
+
+/** modp_utf8_validate, not counted */
+int modp_utf8_validate_impl(const char* src_orig, size_t len);
+
+#endif /* COM_MODP_STRINGENCODERS_INTERNAL */
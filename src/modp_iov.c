@@ -0,0 +1,308 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_iov.c
+ * <PRE>
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ *
+ * Each input buffer is cut where the codec can start again, as
+ * modp_pipeline.c cuts its blocks, and coded where it lies.  The few
+ * bytes the cut leaves go to the carry, and the next buffer's first
+ * bytes are added to them until the carry can be coded too.
+ *
+ * Output goes straight into the output buffer while there is room
+ * for the most the codec can write, plus the bytes some decoders
+ * store past their output.  The end of each output buffer is filled
+ * from a small bounce buffer instead.
+ */
+
+#include "config.h"
+
+#include <string.h>
+
+#include "modp_iov.h"
+#include "modp_probe.h"
+#include "modp_escape.h"
+#include "modp_json_data.h"
+
+/* bytes for a cut group and the start of the next buffer */
+#define IOV_CARRY 64
+
+/* room kept after the most a codec writes, as modp_pipeline.c does */
+#define IOV_SLACK 16
+
+/* output bytes coded at a time at the end of an output buffer */
+#define IOV_BOUNCE 512
+
+/* the output buffers */
+struct iov_out {
+    struct iovec* iov;
+    int cnt;
+    /* the buffer being filled, and the bytes in it */
+    int i;
+    size_t at;
+    size_t total;
+};
+
+/* a JSON string without its quotes */
+static size_t json_escape(char* dest, const char* src, size_t len)
+{
+    return modp_escape_encode(dest, src, len, gsJSONEncodeLen, gsJSONEncodeEsc);
+}
+
+static const modp_pipeline_codec iov_json = { json_escape, NULL, NULL, 1, 6 };
+
+/* how many of the len bytes at src can be coded before the rest */
+static size_t iov_cut(const modp_pipeline_codec* c, const char* src, size_t len)
+{
+    return c->cut ? c->cut(src, len) : len / c->group * c->group;
+}
+
+/* the room left in the output, moving on to the next buffer when full */
+static size_t out_room(struct iov_out* o)
+{
+    while (o->i < o->cnt && o->at == o->iov[o->i].iov_len) {
+        o->i += 1;
+        o->at = 0;
+    }
+    return (o->i < o->cnt) ? o->iov[o->i].iov_len - o->at : 0;
+}
+
+/* copy out len bytes, 0 or -1 if the output is full */
+static int out_copy(struct iov_out* o, const char* src, size_t len)
+{
+    size_t n;
+
+    while (len > 0) {
+        n = out_room(o);
+        if (n == 0) {
+            return -1;
+        }
+        if (n > len) {
+            n = len;
+        }
+        memcpy((char*) o->iov[o->i].iov_base + o->at, src, n);
+        o->at += n;
+        o->total += n;
+        src += n;
+        len -= n;
+    }
+    return 0;
+}
+
+/*
+ * code all len bytes at src, which are cut where the codec can start
+ * again unless last is set.  0, or -1 if the input is bad or the
+ * output is full.
+ */
+static int code(struct iov_out* o, const modp_pipeline_codec* c,
+                const char* src, size_t len, int last)
+{
+    char bounce[IOV_BOUNCE];
+    modp_pipeline_fn fn;
+    size_t room;
+    size_t take;
+    size_t r;
+
+    while (len > 0) {
+        room = out_room(o);
+        if (room == 0) {
+            return -1;
+        }
+        take = (room > IOV_SLACK) ? (room - IOV_SLACK) / c->group_out * c->group : 0;
+        if (take >= len) {
+            take = len;
+        } else if (take > 0) {
+            take = iov_cut(c, src, take);
+        }
+        if (take == 0) {
+            /* the end of the buffer, code a little and copy it */
+            take = (IOV_BOUNCE - IOV_SLACK) / c->group_out * c->group;
+            if (take >= len) {
+                take = len;
+            } else if (iov_cut(c, src, take) > 0) {
+                take = iov_cut(c, src, take);
+            }
+        }
+
+        fn = (last && take == len && c->last) ? c->last : c->fn;
+        if (room >= (take + c->group - 1) / c->group * c->group_out + IOV_SLACK) {
+            r = fn((char*) o->iov[o->i].iov_base + o->at, src, take);
+            if (r == (size_t) -1) {
+                return -1;
+            }
+            o->at += r;
+            o->total += r;
+        } else {
+            r = fn(bounce, src, take);
+            if (r == (size_t) -1 || out_copy(o, bounce, r) != 0) {
+                return -1;
+            }
+        }
+        src += take;
+        len -= take;
+    }
+    return 0;
+}
+
+/* code all of src, 0 or -1 */
+static int iov_run(struct iov_out* o, const modp_pipeline_codec* c,
+                   const struct iovec* src, int srccnt)
+{
+    char carry[IOV_CARRY];
+    const char* s;
+    size_t have = 0;
+    size_t len;
+    size_t add;
+    size_t k;
+    int last;
+    int i;
+
+    /* the last buffer with something in it is coded with c->last */
+    last = srccnt - 1;
+    while (last >= 0 && src[last].iov_len == 0) {
+        last -= 1;
+    }
+
+    for (i = 0; i <= last; ++i) {
+        s = (const char*) src[i].iov_base;
+        len = src[i].iov_len;
+
+        if (have > 0) {
+            add = (len < IOV_CARRY - have) ? len : IOV_CARRY - have;
+            memcpy(carry + have, s, add);
+            if (i == last && add == len) {
+                have += add;
+                break;
+            }
+            k = iov_cut(c, carry, have + add);
+            if (k < have) {
+                if (add == len) {
+                    /* still not a whole group */
+                    have += add;
+                    continue;
+                }
+                k = have + add;
+            }
+            if (code(o, c, carry, k, 0) != 0) {
+                return -1;
+            }
+            s += k - have;
+            len -= k - have;
+            have = 0;
+        }
+
+        if (i == last) {
+            if (code(o, c, s, len, 1) != 0) {
+                return -1;
+            }
+        } else {
+            k = iov_cut(c, s, len);
+            if (len - k >= IOV_CARRY) {
+                /* not a codec of modp_pipeline.h, the cuts are short */
+                return -1;
+            }
+            if (code(o, c, s, k, 0) != 0) {
+                return -1;
+            }
+            memcpy(carry, s + k, len - k);
+            have = len - k;
+        }
+    }
+
+    if (have > 0 && code(o, c, carry, have, 1) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static void out_init(struct iov_out* o, struct iovec* dest, int destcnt)
+{
+    o->iov = dest;
+    o->cnt = destcnt;
+    o->i = 0;
+    o->at = 0;
+    o->total = 0;
+}
+
+/* set the lengths of the used buffers for writev */
+static size_t out_end(struct iov_out* o, int* destcnt)
+{
+    if (o->i < o->cnt && o->at > 0) {
+        o->iov[o->i].iov_len = o->at;
+        o->i += 1;
+    }
+    *destcnt = o->i;
+    return o->total;
+}
+
+static size_t iov_total(const struct iovec* src, int srccnt)
+{
+    size_t n = 0;
+    int i;
+
+    for (i = 0; i < srccnt; ++i) {
+        n += src[i].iov_len;
+    }
+    return n;
+}
+
+/*
+ * the public entry points, traced by the USDT probes of modp_probe.h
+ */
+
+size_t modp_iov_code(const modp_pipeline_codec* codec,
+                     struct iovec* dest, int* destcnt,
+                     const struct iovec* src, int srccnt)
+{
+    struct iov_out o;
+    size_t r;
+
+    MODP_PROBE_ENTRY(iov_code, iov_total(src, srccnt));
+    out_init(&o, dest, *destcnt);
+    r = (iov_run(&o, codec, src, srccnt) == 0) ? out_end(&o, destcnt) : (size_t) -1;
+    MODP_PROBE_RETURN(iov_code, iov_total(src, srccnt), r);
+    return r;
+}
+
+size_t modp_iov_len(const modp_pipeline_codec* codec,
+                    const struct iovec* src, int srccnt)
+{
+    return (iov_total(src, srccnt) + codec->group - 1) / codec->group * codec->group_out;
+}
+
+size_t modp_iov_json_string(struct iovec* dest, int* destcnt,
+                            const struct iovec* src, int srccnt)
+{
+    struct iov_out o;
+    size_t r = (size_t) -1;
+
+    MODP_PROBE_ENTRY(iov_json_string, iov_total(src, srccnt));
+    out_init(&o, dest, *destcnt);
+    if (out_copy(&o, "\"", 1) == 0 && iov_run(&o, &iov_json, src, srccnt) == 0
+        && out_copy(&o, "\"", 1) == 0) {
+        r = out_end(&o, destcnt);
+    }
+    MODP_PROBE_RETURN(iov_json_string, iov_total(src, srccnt), r);
+    return r;
+}
+
+size_t modp_iov_json_string_len(const struct iovec* src, int srccnt)
+{
+    /* and the start and end quotes */
+    size_t n = 2;
+    int i;
+
+    for (i = 0; i < srccnt; ++i) {
+        n += modp_escape_strlen((const char*) src[i].iov_base, src[i].iov_len,
+                                gsJSONEncodeLen);
+    }
+    return n;
+}
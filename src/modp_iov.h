@@ -0,0 +1,90 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_iov.h
+ * \brief code a chain of buffers into a chain of buffers
+ *
+ * Data read with readv(2), or kept as a chain of buffers, would
+ * otherwise be copied into one buffer before it is coded.
+ * modp_iov_code codes the chain in place, with any of the codecs of
+ * modp_pipeline.h, and writes into another chain ready for writev(2):
+ *
+ * \code
+ * struct iovec out[4] = { { b0, 4096 }, { b1, 4096 }, ... };
+ * int outcnt = 4;
+ * size_t n = modp_iov_code(&modp_pipeline_b64_encode, out, &outcnt,
+ *                          in, incnt);
+ * if (n != (size_t)-1) {
+ *     writev(fd, out, outcnt);
+ * }
+ * \endcode
+ *
+ * A group cut by the end of a buffer (the 3 bytes of b64 encode, a
+ * %XX of modp_burl_decode) is put together in a few bytes on the
+ * stack, all the rest is coded where it lies.  The output is the same
+ * as coding all of the input in one call.
+ *
+ * No null is added, and one output buffer is the one-shot call.
+ */
+
+/*
+ * <PRE>
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_IOV
+#define COM_MODP_STRINGENCODERS_IOV
+
+#include <sys/uio.h>
+#include "modp_stdint.h"
+#include "modp_pipeline.h"
+#include "extern_c_begin.h"
+
+/**
+ * \brief code the buffers of src into the buffers of dest
+ *
+ * \param[in] codec e.g. modp_pipeline_b64_encode, modp_pipeline_b16_decode,
+ *   modp_pipeline_burl_encode or modp_pipeline_burl_decode
+ * \param[in,out] dest the output buffers, filled in order.  The
+ *   iov_len of each used one is set to the bytes in it.
+ * \param[in,out] destcnt in, the number of dest buffers.  Out, the
+ *   number used.
+ * \param[in] src the input
+ * \param[in] srccnt the number of src buffers
+ * \return the bytes written, or -1 if the input is bad or dest is
+ *   full.  modp_iov_len bytes of dest are always enough.
+ */
+size_t modp_iov_code(const modp_pipeline_codec* codec,
+                     struct iovec* dest, int* destcnt,
+                     const struct iovec* src, int srccnt);
+
+/**
+ * \brief the most bytes modp_iov_code writes
+ */
+size_t modp_iov_len(const modp_pipeline_codec* codec,
+                    const struct iovec* src, int srccnt);
+
+/**
+ * \brief write src as a JSON string, as modp_json_add_string does,
+ * quotes included
+ *
+ * Arguments and result as modp_iov_code.
+ */
+size_t modp_iov_json_string(struct iovec* dest, int* destcnt,
+                            const struct iovec* src, int srccnt);
+
+/**
+ * \brief the exact bytes modp_iov_json_string writes
+ */
+size_t modp_iov_json_string_len(const struct iovec* src, int srccnt);
+
+#include "extern_c_end.h"
+
+#endif  /* COM_MODP_STRINGENCODERS_IOV */
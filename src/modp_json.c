@@ -42,8 +42,13 @@
  * </PRE>
  */
 
+#include "config.h"
 #include <assert.h>
 #include "modp_json.h"
+#include "modp_stats.h"
+#include "modp_probe.h"
+#include "modp_numtoa.h"
+#include "modp_escape.h"
 #include "modp_json_data.h"
 
 typedef enum {
@@ -109,7 +114,7 @@ void modp_json_init(modp_json_ctx* ctx, char* dest)
     ctx->dest = dest;
 }
 
-size_t modp_json_end(modp_json_ctx* ctx)
+static size_t json_end_impl(modp_json_ctx* ctx)
 {
     if (ctx->dest) {
         *(ctx->dest + ctx->size) = '\0';
@@ -318,6 +323,57 @@ void modp_json_add_uint32(modp_json_ctx* ctx, uint32_t uv)
     ctx->size += r;
 }
 
+void modp_json_add_double(modp_json_ctx* ctx, double d)
+{
+    char buf[64];
+    size_t n;
+
+    /* JSON has no NaN or Infinity */
+    if (d != d || d - d != 0.0) {
+        modp_json_add_null(ctx);
+        return;
+    }
+
+    n = modp_dtoa2(d, buf, 9);
+
+    modp_json_add_value(ctx);
+
+    if (ctx->dest) {
+        memcpy(ctx->dest + ctx->size, buf, n);
+    }
+    ctx->size += n;
+}
+
+void modp_json_add_int64(modp_json_ctx* ctx, int64_t val, int stringonly)
+{
+    char buf[24];
+    size_t n;
+
+    if (val >= 0) {
+        modp_json_add_uint64(ctx, (uint64_t) val, stringonly);
+        return;
+    }
+    if (val < -(1LL << 53)) {
+        stringonly = 1;
+    }
+
+    n = modp_litoa10(val, buf);
+
+    modp_json_add_value(ctx);
+
+    if (ctx->dest) {
+        char* wstr = ctx->dest + ctx->size;
+        if (stringonly) {
+            *wstr++ = '"';
+        }
+        memcpy(wstr, buf, n);
+        if (stringonly) {
+            wstr[n] = '"';
+        }
+    }
+    ctx->size += stringonly ? n + 2 : n;
+}
+
 void modp_json_add_cstring(modp_json_ctx* ctx, const char* src)
 {
     return modp_json_add_string(ctx, src, strlen(src));
@@ -336,48 +392,21 @@ void modp_json_add_string(modp_json_ctx* ctx, const char* src, size_t len)
 
 static size_t modp_bjson_encode(char* dest, const char* src, size_t len)
 {
-    static const char* hexchar = "0123456789ABCDEF";
-    const char* deststart = (const char*) dest;
-    const uint8_t* s = (const uint8_t*) src;
-    const uint8_t* srcend = s + len;
-    uint8_t x;
-    uint8_t val;
-
-    *dest++ = '"';
-
-    while (s < srcend) {
-        x = *s++;
-        val = gsJSONEncodeMap[x];
-        if (val == 'a') {
-            /* a for ascii, as-is */
-            *dest++ = (char) x;
-        } else if (val == 'u') {
-            /* u for unicode, 6 byte escape sequence */
-            dest[0] = '\\';
-            dest[1] = 'u';
-            dest[2] = '0';
-            dest[3] = '0';
-            dest[4] = hexchar[x >> 4];
-            dest[5] = hexchar[x & 0x0F];
-            dest += 6;
-        } else {
-            /* 2 byte escape sequence */
-            dest[0] = '\\';
-            dest[1] = (char)val;
-            dest += 2;
-        }
-    }
-    *dest++ = '"';
-    return (size_t)(dest - deststart);
+    size_t n;
+
+    dest[0] = '"';
+    n = modp_escape_encode(dest + 1, src, len, gsJSONEncodeLen, gsJSONEncodeEsc);
+    dest[n + 1] = '"';
+    return n + 2;
 }
 
 static size_t modp_bjson_encode_strlen(const char* src, size_t len)
 {
-    const uint8_t* s = (const uint8_t*)src;
-    const uint8_t* srcend = s + len;
-    size_t count = 2;  /* for start and end quotes */
-    while (s < srcend) {
-        count += (gsJSONEncodeLenMap[*s++]);
-    }
-    return count;
+    /* and the start and end quotes */
+    return modp_escape_strlen(src, len, gsJSONEncodeLen) + 2;
+}
+
+size_t modp_json_end(modp_json_ctx* ctx)
+{
+    MODP_COUNTED_SIZE(json_end, json_end_impl(ctx), 0);
 }
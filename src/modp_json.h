@@ -74,6 +74,10 @@ void modp_json_add_cstring(modp_json_ctx* ctx, const char*);
  */
 void modp_json_add_bool(modp_json_ctx* ctx, int val);
 
+/*
+ * Adds a number with up to 9 digits after the decimal point, using
+ * modp_dtoa2.  NaN and infinity are written as null.
+ */
 void modp_json_add_double(modp_json_ctx* ctx, double d);
 
 void modp_json_add_int32(modp_json_ctx* ctx, int val);
@@ -96,6 +100,13 @@ void modp_json_add_uint32(modp_json_ctx* ctx, uint32_t val);
 void modp_json_add_uint64(modp_json_ctx* ctx, uint64_t val,
                           int stringonly);
 
+/**
+ * Signed version of modp_json_add_uint64, formatted with modp_litoa10.
+ * Values below -2^53 are written as strings.
+ */
+void modp_json_add_int64(modp_json_ctx* ctx, int64_t val,
+                         int stringonly);
+
 /*
  * explicity add a null type
  */
@@ -103,4 +114,198 @@ void modp_json_add_null(modp_json_ctx* ctx);
 
 MODP_C_END_DECLS
 
+#ifdef __cplusplus
+#include <cstring>
+#include <string>
+#include "modp_cxx.h"
+
+namespace modp {
+
+    /**
+     * \brief JSON writer that owns a growable buffer
+     *
+     * Each add makes room for the worst case output first, so the
+     * C functions never need a dry run.  Small documents stay in
+     * Inline bytes inside the object.  Methods return *this so calls
+     * can be chained:
+     *
+     * \code
+     * modp::JsonWriter w;
+     * w.map_open().key("id").add(42).key("tags").ary_open()
+     *  .add("a").add("b").ary_close().map_close();
+     * std::string body = w.take();
+     * \endcode
+     *
+     * Nesting is limited to JSON_MAX_DEPTH - 1 levels, as with
+     * modp_json_ctx.  Buffer may be any contiguous container of chars
+     * with resize, clear, swap and assign, e.g. std::vector<char>.
+     *
+     * The writer can be moved (C++11) but not copied.
+     */
+    template <class Buffer = std::string, size_t Inline = 256>
+    class basic_json_writer {
+    public:
+        basic_json_writer() { modp_json_init(&ctx_, store_.base()); }
+
+        /**
+         * Construct the Buffer with an allocator, e.g. a
+         * std::pmr::memory_resource* for modp::pmr::JsonWriter
+         */
+        template <class Alloc>
+        explicit basic_json_writer(const Alloc& alloc) : store_(alloc)
+        {
+            modp_json_init(&ctx_, store_.base());
+        }
+
+#if __cplusplus >= 201103L
+        basic_json_writer(basic_json_writer&& other)
+            : store_(std::move(other.store_), other.ctx_.size), ctx_(other.ctx_)
+        {
+            ctx_.dest = store_.base();
+            other.clear();
+        }
+
+        basic_json_writer& operator=(basic_json_writer&& other)
+        {
+            if (this != &other) {
+                ctx_ = other.ctx_;
+                store_.steal(other.store_, other.ctx_.size);
+                ctx_.dest = store_.base();
+                other.clear();
+            }
+            return *this;
+        }
+#endif
+
+        basic_json_writer& map_open() { room(1); modp_json_map_open(&ctx_); return *this; }
+        basic_json_writer& map_close() { room(1); modp_json_map_close(&ctx_); return *this; }
+        basic_json_writer& ary_open() { room(1); modp_json_ary_open(&ctx_); return *this; }
+        basic_json_writer& ary_close() { room(1); modp_json_ary_close(&ctx_); return *this; }
+
+        basic_json_writer& add(const char* s, size_t len)
+        {
+            room(6 * len + 2);
+            modp_json_add_string(&ctx_, s, len);
+            return *this;
+        }
+
+        basic_json_writer& add(const char* s) { return add(s, strlen(s)); }
+        basic_json_writer& add(const std::string& s) { return add(s.data(), s.size()); }
+#ifdef MODP_HAS_STRING_VIEW
+        basic_json_writer& add(std::string_view s) { return add(s.data(), s.size()); }
+#endif
+
+        basic_json_writer& add(bool b)
+        {
+            room(5);
+            modp_json_add_bool(&ctx_, b ? 1 : 0);
+            return *this;
+        }
+
+        basic_json_writer& add(int v)
+        {
+            room(11);
+            modp_json_add_int32(&ctx_, v);
+            return *this;
+        }
+
+        basic_json_writer& add(unsigned int v)
+        {
+            room(10);
+            modp_json_add_uint32(&ctx_, v);
+            return *this;
+        }
+
+        /*
+         * int64_t is long or long long depending on the platform, so
+         * both are here to keep add(int64_t) unambiguous.  Large values
+         * are written as strings, see modp_json_add_uint64.
+         */
+        basic_json_writer& add(long long v, bool stringonly = false)
+        {
+            room(22);
+            modp_json_add_int64(&ctx_, (int64_t) v, stringonly ? 1 : 0);
+            return *this;
+        }
+
+        basic_json_writer& add(long v, bool stringonly = false)
+        {
+            return add((long long) v, stringonly);
+        }
+
+        basic_json_writer& add(unsigned long long v, bool stringonly = false)
+        {
+            room(22);
+            modp_json_add_uint64(&ctx_, (uint64_t) v, stringonly ? 1 : 0);
+            return *this;
+        }
+
+        basic_json_writer& add(unsigned long v, bool stringonly = false)
+        {
+            return add((unsigned long long) v, stringonly);
+        }
+
+        basic_json_writer& add(double d)
+        {
+            room(64);
+            modp_json_add_double(&ctx_, d);
+            return *this;
+        }
+
+        basic_json_writer& add_null()
+        {
+            room(4);
+            modp_json_add_null(&ctx_);
+            return *this;
+        }
+
+        /** a map key, same as add(s) */
+        template <class T>
+        basic_json_writer& key(const T& s) { return add(s); }
+
+        /** the output so far, not null terminated */
+        const char* data() const { return store_.base(); }
+        size_t size() const { return ctx_.size; }
+
+        std::string str() const { return std::string(data(), size()); }
+
+        /**
+         * Move the output out of the writer, which is then empty.  The
+         * buffer is handed over, not copied, unless the document was
+         * small enough to fit in the inline space.
+         */
+        Buffer take()
+        {
+            Buffer out = store_.take(ctx_.size);
+            modp_json_init(&ctx_, store_.base());
+            return out;
+        }
+
+        /** start over, keeping the buffer */
+        void clear() { modp_json_init(&ctx_, store_.base()); }
+
+    private:
+        basic_json_writer(const basic_json_writer&);
+        basic_json_writer& operator=(const basic_json_writer&);
+
+        /* n bytes, plus a ',' or ':' and the null from modp_json_end */
+        void room(size_t n) { ctx_.dest = store_.reserve(ctx_.size, n + 2); }
+
+        detail::writer_storage<Buffer, Inline> store_;
+        modp_json_ctx ctx_;
+    };
+
+    typedef basic_json_writer<> JsonWriter;
+
+#ifdef MODP_HAS_PMR
+    namespace pmr {
+        /** a JsonWriter whose output is a std::pmr::string */
+        typedef basic_json_writer<std::pmr::string> JsonWriter;
+    }
+#endif
+
+}       /* namespace modp */
+
+#endif  /* __cplusplus */
+
 #endif /* modp_bjson */
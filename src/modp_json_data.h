@@ -1,57 +1,65 @@
-static const uint8_t gsJSONEncodeMap[256] = {
-   'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'b',  't',
-   'n',  'u',  'f',  'r',  'u',  'u',  'u',  'u',  'u',  'u',
-   'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',
-   'u',  'u',  'a',  'a',  '"',  'a',  'a',  'a',  'a',  'a',
-   'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',
-   'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',
-   'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',
-   'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',
-   'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',
-   'a',  'a', '\\',  'a',  'a',  'a',  'a',  'a',  'a',  'a',
-   'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',
-   'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',
-   'a',  'a',  'a',  'a',  'a',  'a',  'a',  'a',  'u',  'u',
-   'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',
-   'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',
-   'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',
-   'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',
-   'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',
-   'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',
-   'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',
-   'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',
-   'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',
-   'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',
-   'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',
-   'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',  'u',
-   'u',  'u',  'u',  'u',  'u',  'u',
+static const uint8_t gsJSONEncodeLen[256] = {
+6, 6, 6, 6, 6, 6, 6, 6, 2, 2, 2, 6, 2, 2, 6, 6,
+6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6
 };
 
-static const size_t gsJSONEncodeLenMap[256] = {
-  6, 6, 6, 6, 6, 6, 6, 6, 2, 2, 
-  2, 6, 2, 2, 6, 6, 6, 6, 6, 6, 
-  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 
-  6, 6, 1, 1, 2, 1, 1, 1, 1, 1, 
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
-  1, 1, 2, 1, 1, 1, 1, 1, 1, 1, 
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 
-  1, 1, 1, 1, 1, 1, 1, 1, 6, 6, 
-  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 
-  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 
-  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 
-  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 
-  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 
-  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 
-  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 
-  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 
-  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 
-  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 
-  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 
-  6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 
-  6, 6, 6, 6, 6, 6, 
+static const char gsJSONEncodeEsc[256][8] = {
+"\134u0000", "\134u0001", "\134u0002", "\134u0003", "\134u0004", "\134u0005",
+"\134u0006", "\134u0007", "\134b", "\134t", "\134n", "\134u000B",
+"\134f", "\134r", "\134u000E", "\134u000F", "\134u0010", "\134u0011",
+"\134u0012", "\134u0013", "\134u0014", "\134u0015", "\134u0016", "\134u0017",
+"\134u0018", "\134u0019", "\134u001A", "\134u001B", "\134u001C", "\134u001D",
+"\134u001E", "\134u001F", " ", "!", "\134\042", "#",
+"$", "%", "&", "'", "(", ")",
+"*", "+", ",", "-", ".", "/",
+"0", "1", "2", "3", "4", "5",
+"6", "7", "8", "9", ":", ";",
+"<", "=", ">", "\077", "@", "A",
+"B", "C", "D", "E", "F", "G",
+"H", "I", "J", "K", "L", "M",
+"N", "O", "P", "Q", "R", "S",
+"T", "U", "V", "W", "X", "Y",
+"Z", "[", "\134\134", "]", "^", "_",
+"`", "a", "b", "c", "d", "e",
+"f", "g", "h", "i", "j", "k",
+"l", "m", "n", "o", "p", "q",
+"r", "s", "t", "u", "v", "w",
+"x", "y", "z", "{", "|", "}",
+"~", "\177", "\134u0080", "\134u0081", "\134u0082", "\134u0083",
+"\134u0084", "\134u0085", "\134u0086", "\134u0087", "\134u0088", "\134u0089",
+"\134u008A", "\134u008B", "\134u008C", "\134u008D", "\134u008E", "\134u008F",
+"\134u0090", "\134u0091", "\134u0092", "\134u0093", "\134u0094", "\134u0095",
+"\134u0096", "\134u0097", "\134u0098", "\134u0099", "\134u009A", "\134u009B",
+"\134u009C", "\134u009D", "\134u009E", "\134u009F", "\134u00A0", "\134u00A1",
+"\134u00A2", "\134u00A3", "\134u00A4", "\134u00A5", "\134u00A6", "\134u00A7",
+"\134u00A8", "\134u00A9", "\134u00AA", "\134u00AB", "\134u00AC", "\134u00AD",
+"\134u00AE", "\134u00AF", "\134u00B0", "\134u00B1", "\134u00B2", "\134u00B3",
+"\134u00B4", "\134u00B5", "\134u00B6", "\134u00B7", "\134u00B8", "\134u00B9",
+"\134u00BA", "\134u00BB", "\134u00BC", "\134u00BD", "\134u00BE", "\134u00BF",
+"\134u00C0", "\134u00C1", "\134u00C2", "\134u00C3", "\134u00C4", "\134u00C5",
+"\134u00C6", "\134u00C7", "\134u00C8", "\134u00C9", "\134u00CA", "\134u00CB",
+"\134u00CC", "\134u00CD", "\134u00CE", "\134u00CF", "\134u00D0", "\134u00D1",
+"\134u00D2", "\134u00D3", "\134u00D4", "\134u00D5", "\134u00D6", "\134u00D7",
+"\134u00D8", "\134u00D9", "\134u00DA", "\134u00DB", "\134u00DC", "\134u00DD",
+"\134u00DE", "\134u00DF", "\134u00E0", "\134u00E1", "\134u00E2", "\134u00E3",
+"\134u00E4", "\134u00E5", "\134u00E6", "\134u00E7", "\134u00E8", "\134u00E9",
+"\134u00EA", "\134u00EB", "\134u00EC", "\134u00ED", "\134u00EE", "\134u00EF",
+"\134u00F0", "\134u00F1", "\134u00F2", "\134u00F3", "\134u00F4", "\134u00F5",
+"\134u00F6", "\134u00F7", "\134u00F8", "\134u00F9", "\134u00FA", "\134u00FB",
+"\134u00FC", "\134u00FD", "\134u00FE", "\134u00FF"
 };
+
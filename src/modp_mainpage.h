@@ -11,6 +11,9 @@
  *  - modp_bXXX_decode_len(int len) -- the amount of memory needed to decode.
  *
  * The header files all include a sample C++ std::string wrapper.
+ * Codecs also have C++ overloads that write into a caller buffer or
+ * append to an existing std::string or std::vector without a
+ * temporary, see modp_cxx.h.
  *
  * In addition:
  * - modp_numtoa.h defines fast integer and float  types to char buffer converts.
@@ -76,13 +79,106 @@
  *
  * Converts a raw c-string into something that can be enbedded into
  * javascript.  This might be useful for server-generated dynamic
- * javascript.  There is no decode function provided.  This is only
- * use when generating raw "text/javascript" files.  It is <b>NOT</b>
- * safe to make javascript that will ultimately be embedded inside
- * HTML via script tags.
+ * javascript.  modp_bjavascript_encode is only for use when
+ * generating raw "text/javascript" files.  It is <b>NOT</b> safe to
+ * make javascript that will ultimately be embedded inside HTML via
+ * script tags.  For that use modp_bjavascript_uencode with
+ * MODP_JS_ESCAPE_HTML, which also passes UTF-8 through and can emit
+ * \\uXXXX escapes.  modp_bjavascript_decode unescapes either.
  *
  * See modp_bjavascript.h for details
  *
+ * \section modp_qp
+ *
+ * Quoted-printable (RFC 2045) encoding and decoding for MIME bodies,
+ * with soft line breaks at 76 chars.  Runs of plain text are copied
+ * a word at a time.  Streaming versions are included for encoding
+ * large messages in chunks.
+ *
+ * See modp_qp.h for details
+ *
+ * \section modp_encword
+ *
+ * RFC 2047 encoded-words for mail headers ("=?UTF-8?Q?...?=").  The
+ * encoder picks B or Q by size and splits long values into words on
+ * UTF-8 boundaries.  The decoder joins adjacent words in one pass.
+ *
+ * See modp_encword.h for details
+ *
+ * \section modp_punycode
+ *
+ * Punycode (RFC 3492) for internationalized domain names, and
+ * helpers that convert whole host names to and from "xn--" form.
+ * Plain ascii host names are only lowercased.  No memory is
+ * allocated.
+ *
+ * See modp_punycode.h for details
+ *
+ * \section modp_datauri
+ *
+ * Writes "data:" URIs straight into one exactly sized buffer, and
+ * parses them back, decoding the base64 or percent-encoded payload
+ * in place.
+ *
+ * See modp_datauri.h for details
+ *
+ * \section modp_constexpr
+ *
+ * C++14 constexpr base64, base16 and url encoders for encoding
+ * constants at compile time, and builders for the lookup tables
+ * that the *_gen programs write.
+ *
+ * See modp_constexpr.h for details
+ *
+ * \section modp_inline
+ *
+ * modp_inline.h is generated at build time and has every module in
+ * one header.  With MODP_INLINE defined the functions are static
+ * inline, so short or constant length calls can be inlined without
+ * linking the library.  Alternatively configure with --enable-lto.
+ *
+ * \section modp_alloc
+ *
+ * The C functions never allocate.  modp_alloc.h has a C allocator
+ * interface and a bump arena, so callers and the C++ wrappers can
+ * take per-request memory from one arena and free it all with one
+ * reset.  In C++17 the arena is a std::pmr::memory_resource.
+ *
+ * \section modp_stats
+ *
+ * Built with configure --enable-stats, the main encoders and decoders
+ * count their calls, bytes in and out, and errors in per thread
+ * counters that modp_stats.h reads back.  Without it nothing is
+ * counted and nothing is paid.
+ *
+ * The same entry points carry USDT probes, modp:b64_decode_entry and
+ * modp:b64_decode_return and so on, with the input length and the
+ * result.  They are built in with configure --enable-usdt and are a
+ * nop until bpftrace or perf attaches to them.
+ *
+ * \section modp_pipeline
+ *
+ * modp_pipeline.h codes a stream, such as a pipe, with a reader
+ * thread, worker threads calling a one-shot codec on blocks cut on the
+ * codec's group size, and the output written in order from the calling
+ * thread, in bounded memory.  The modp command line tool uses it for
+ * stdin.
+ *
+ * \section modp_fuse
+ *
+ * modp_fuse.h runs modp_burl_decode, modp_utf8_validate and the XML
+ * or JSON string escape over the input in one pass, a window at a
+ * time, with the same output as calling them one after another and
+ * no buffer in between.
+ *
+ * \section modp_iov
+ *
+ * modp_iov.h codes a chain of buffers, as read with readv, into a
+ * chain of buffers ready for writev, with the codecs of modp_pipeline.h
+ * and as a JSON string.  Groups cut by the end of a buffer are put
+ * together internally, the rest is coded where it lies, without
+ * copying the chain to one buffer first.
+ *
  * \section modp_xml
  *
  * An experimental XML decoder.
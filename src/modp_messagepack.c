@@ -1,6 +1,9 @@
 
+#include "config.h"
 #include <stddef.h>
 #include "modp_messagepack.h"
+#include "modp_stats.h"
+#include "modp_probe.h"
 
 
 void modp_msgpk_init(modp_msgpk_ctx* ctx, char* dest)
@@ -9,7 +12,7 @@ void modp_msgpk_init(modp_msgpk_ctx* ctx, char* dest)
     ctx->dest = dest;
 }
 
-size_t modp_msgpk_end(modp_msgpk_ctx* ctx)
+static size_t msgpk_end_impl(modp_msgpk_ctx* ctx)
 {
   return ctx->size;
 }
@@ -77,6 +80,18 @@ void modp_msgpk_add_uint32(modp_msgpk_ctx* ctx, uint32_t val)
    modp_msgpk_raw_uint32(ctx, val);
 }
 
+void modp_msgpk_add_int64(modp_msgpk_ctx* ctx, int64_t val)
+{
+   modp_msgpk_raw_byte(ctx, 0xD3);
+   modp_msgpk_raw_bytes(ctx, (const void*)(&val), (size_t)8);
+}
+
+void modp_msgpk_add_uint64(modp_msgpk_ctx* ctx, uint64_t val)
+{
+   modp_msgpk_raw_byte(ctx, 0xCF);
+   modp_msgpk_raw_bytes(ctx, (const void*)(&val), (size_t)8);
+}
+
 void modp_msgpk_add_string(modp_msgpk_ctx* ctx, const char* s, size_t len)
 {
   if (len < 32) {
@@ -126,3 +141,8 @@ void modp_msgpk_ary_open(modp_msgpk_ctx* ctx, size_t count)
   }
   /* ASSERT */
 }
+
+size_t modp_msgpk_end(modp_msgpk_ctx* ctx)
+{
+  MODP_COUNTED_SIZE(msgpk_end, msgpk_end_impl(ctx), 0);
+}
@@ -27,10 +27,13 @@ typedef struct {
 
 void modp_msgpk_init(modp_msgpk_ctx* ctx, char* dest);
 size_t modp_msgpk_end(modp_msgpk_ctx* ctx);
+void modp_msgpk_add_null(modp_msgpk_ctx* ctx);
 void modp_msgpk_add_bool(modp_msgpk_ctx* ctx, int32_t val);
 void modp_msgpk_add_double(modp_msgpk_ctx* ctx, double d);
 void modp_msgpk_add_int32(modp_msgpk_ctx* ctx, int32_t val);
 void modp_msgpk_add_uint32(modp_msgpk_ctx* ctx, uint32_t val);
+void modp_msgpk_add_int64(modp_msgpk_ctx* ctx, int64_t val);
+void modp_msgpk_add_uint64(modp_msgpk_ctx* ctx, uint64_t val);
 
 void modp_msgpk_add_string(modp_msgpk_ctx* ctx, const char*, size_t);
 void modp_msgpk_add_cstring(modp_msgpk_ctx* ctx, const char*);
@@ -48,4 +51,178 @@ void modp_msgpk_ary_open(modp_msgpk_ctx* ctx, size_t count);
 
 MODP_C_END_DECLS
 
+#ifdef __cplusplus
+#include <cstring>
+#include <string>
+#include "modp_cxx.h"
+
+namespace modp {
+
+    /**
+     * \brief MessagePack writer that owns a growable buffer
+     *
+     * The MessagePack version of modp::basic_json_writer.  Maps and
+     * arrays are opened with their element count and need no close.
+     *
+     * \code
+     * modp::MsgpackWriter w;
+     * w.map_open(2).add("id").add(42).add("ok").add(true);
+     * std::string packed = w.take();
+     * \endcode
+     */
+    template <class Buffer = std::string, size_t Inline = 256>
+    class basic_msgpack_writer {
+    public:
+        basic_msgpack_writer() { modp_msgpk_init(&ctx_, store_.base()); }
+
+        /**
+         * Construct the Buffer with an allocator, e.g. a
+         * std::pmr::memory_resource* for modp::pmr::MsgpackWriter
+         */
+        template <class Alloc>
+        explicit basic_msgpack_writer(const Alloc& alloc) : store_(alloc)
+        {
+            modp_msgpk_init(&ctx_, store_.base());
+        }
+
+#if __cplusplus >= 201103L
+        basic_msgpack_writer(basic_msgpack_writer&& other)
+            : store_(std::move(other.store_), other.ctx_.size), ctx_(other.ctx_)
+        {
+            ctx_.dest = store_.base();
+            other.clear();
+        }
+
+        basic_msgpack_writer& operator=(basic_msgpack_writer&& other)
+        {
+            if (this != &other) {
+                ctx_ = other.ctx_;
+                store_.steal(other.store_, other.ctx_.size);
+                ctx_.dest = store_.base();
+                other.clear();
+            }
+            return *this;
+        }
+#endif
+
+        basic_msgpack_writer& map_open(size_t count)
+        {
+            room(5);
+            modp_msgpk_map_open(&ctx_, count);
+            return *this;
+        }
+
+        basic_msgpack_writer& ary_open(size_t count)
+        {
+            room(5);
+            modp_msgpk_ary_open(&ctx_, count);
+            return *this;
+        }
+
+        basic_msgpack_writer& add(const char* s, size_t len)
+        {
+            room(len + 5);
+            modp_msgpk_add_string(&ctx_, s, len);
+            return *this;
+        }
+
+        basic_msgpack_writer& add(const char* s) { return add(s, strlen(s)); }
+        basic_msgpack_writer& add(const std::string& s) { return add(s.data(), s.size()); }
+#ifdef MODP_HAS_STRING_VIEW
+        basic_msgpack_writer& add(std::string_view s) { return add(s.data(), s.size()); }
+#endif
+
+        basic_msgpack_writer& add(bool b)
+        {
+            room(1);
+            modp_msgpk_add_bool(&ctx_, b ? 1 : 0);
+            return *this;
+        }
+
+        basic_msgpack_writer& add(int v)
+        {
+            room(5);
+            modp_msgpk_add_int32(&ctx_, v);
+            return *this;
+        }
+
+        basic_msgpack_writer& add(unsigned int v)
+        {
+            room(5);
+            modp_msgpk_add_uint32(&ctx_, v);
+            return *this;
+        }
+
+        /* one of these is int64_t, the other keeps add(int64_t) unambiguous */
+        basic_msgpack_writer& add(long long v)
+        {
+            room(9);
+            modp_msgpk_add_int64(&ctx_, (int64_t) v);
+            return *this;
+        }
+
+        basic_msgpack_writer& add(long v) { return add((long long) v); }
+
+        basic_msgpack_writer& add(unsigned long long v)
+        {
+            room(9);
+            modp_msgpk_add_uint64(&ctx_, (uint64_t) v);
+            return *this;
+        }
+
+        basic_msgpack_writer& add(unsigned long v) { return add((unsigned long long) v); }
+
+        basic_msgpack_writer& add(double d)
+        {
+            room(9);
+            modp_msgpk_add_double(&ctx_, d);
+            return *this;
+        }
+
+        basic_msgpack_writer& add_null()
+        {
+            room(1);
+            modp_msgpk_add_null(&ctx_);
+            return *this;
+        }
+
+        const char* data() const { return store_.base(); }
+        size_t size() const { return ctx_.size; }
+
+        std::string str() const { return std::string(data(), size()); }
+
+        /** move the output out of the writer, see basic_json_writer::take */
+        Buffer take()
+        {
+            Buffer out = store_.take(ctx_.size);
+            modp_msgpk_init(&ctx_, store_.base());
+            return out;
+        }
+
+        /** start over, keeping the buffer */
+        void clear() { modp_msgpk_init(&ctx_, store_.base()); }
+
+    private:
+        basic_msgpack_writer(const basic_msgpack_writer&);
+        basic_msgpack_writer& operator=(const basic_msgpack_writer&);
+
+        void room(size_t n) { ctx_.dest = store_.reserve(ctx_.size, n); }
+
+        detail::writer_storage<Buffer, Inline> store_;
+        modp_msgpk_ctx ctx_;
+    };
+
+    typedef basic_msgpack_writer<> MsgpackWriter;
+
+#ifdef MODP_HAS_PMR
+    namespace pmr {
+        /** a MsgpackWriter whose output is a std::pmr::string */
+        typedef basic_msgpack_writer<std::pmr::string> MsgpackWriter;
+    }
+#endif
+
+}       /* namespace modp */
+
+#endif  /* __cplusplus */
+
 #endif
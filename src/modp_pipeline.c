@@ -0,0 +1,460 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_pipeline.c
+ * <PRE>
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ *
+ * The blocks live in a ring of 2 * nthreads slots.  Block number k
+ * uses slot k % nslots, so the reader fills, the workers take and the
+ * writer writes the slots in the same order, and each only has to
+ * wait for the slot it wants next to reach the state it needs:
+ *
+ *   FREE -> (reader) FILLED -> (a worker) DONE -> (writer) FREE
+ *
+ * One mutex guards the states and counters.  It is only held to move
+ * a slot on, never while reading, coding or writing, and with blocks
+ * of a megabyte or so it is taken a few thousand times a second.
+ *
+ * The bytes at the end of a block that the cut leaves behind are
+ * copied to the front of the next one by the reader.  A slot's input
+ * is not written again until the reader comes round to it, so this
+ * reads it while a worker may be reading it too.
+ */
+
+#include "config.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+#include "modp_pipeline.h"
+#include "modp_b2.h"
+#include "modp_b16.h"
+#include "modp_b64.h"
+#include "modp_b64w.h"
+#include "modp_b64r.h"
+#include "modp_b85.h"
+#include "modp_burl.h"
+
+const modp_pipeline_codec modp_pipeline_b2_encode = { modp_b2_encode, NULL, NULL, 1, 8 };
+const modp_pipeline_codec modp_pipeline_b2_decode = { modp_b2_decode, NULL, NULL, 8, 1 };
+const modp_pipeline_codec modp_pipeline_b16_encode = { modp_b16_encode, NULL, NULL, 1, 2 };
+const modp_pipeline_codec modp_pipeline_b16_decode = { modp_b16_decode, NULL, NULL, 2, 1 };
+const modp_pipeline_codec modp_pipeline_b64_encode = { modp_b64_encode, NULL, NULL, 3, 4 };
+const modp_pipeline_codec modp_pipeline_b64_decode = { modp_b64_decode, NULL, NULL, 4, 3 };
+const modp_pipeline_codec modp_pipeline_b64w_encode = { modp_b64w_encode, NULL, NULL, 3, 4 };
+const modp_pipeline_codec modp_pipeline_b64w_decode = { modp_b64w_decode, NULL, NULL, 4, 3 };
+const modp_pipeline_codec modp_pipeline_b64r_encode = { modp_b64r_encode, NULL, NULL, 3, 4 };
+const modp_pipeline_codec modp_pipeline_b64r_decode = { modp_b64r_decode, NULL, NULL, 4, 3 };
+const modp_pipeline_codec modp_pipeline_b85_encode = { modp_b85_encode, NULL, NULL, 4, 5 };
+const modp_pipeline_codec modp_pipeline_b85_decode = { modp_b85_decode, NULL, NULL, 5, 4 };
+const modp_pipeline_codec modp_pipeline_burl_encode = { modp_burl_encode, NULL, NULL, 1, 3 };
+
+/* before a '%' that has not got its two hex chars */
+static size_t cut_url(const char* src, size_t len)
+{
+    size_t i;
+    for (i = (len < 2) ? 0 : len - 2; i < len; ++i) {
+        if (src[i] == '%') {
+            return i;
+        }
+    }
+    return len;
+}
+
+const modp_pipeline_codec modp_pipeline_burl_decode = { modp_burl_decode, NULL, cut_url, 1, 1 };
+
+enum { SLOT_FREE, SLOT_FILLED, SLOT_DONE };
+
+struct slot {
+    char* in;
+    char* out;
+    /* bytes in in, of which len are coded */
+    size_t have;
+    size_t len;
+    size_t outlen;
+    /* input offset of in[0] */
+    size_t offset;
+    int last;
+    int state;
+};
+
+struct pipeline {
+    const modp_pipeline_codec* codec;
+    modp_pipeline_read_fn rd;
+    void* arg;
+    size_t block;
+    struct slot* slots;
+    size_t nslots;
+    /* blocks filled, taken by a worker, and written */
+    size_t nread;
+    size_t nwork;
+    size_t nwrite;
+    int eof;
+    int rc;
+    size_t offset;
+#ifdef HAVE_PTHREAD_H
+    pthread_mutex_t lock;
+    pthread_cond_t can_fill;
+    pthread_cond_t can_work;
+    pthread_cond_t can_write;
+#endif
+};
+
+/*
+ * read the next block into s, after the bytes left over in prev.
+ * Returns 0 or MODP_PIPELINE_EREAD.
+ */
+static int fill(struct pipeline* p, struct slot* s, const struct slot* prev)
+{
+    const modp_pipeline_codec* c = p->codec;
+    size_t carry = 0, n;
+
+    if (prev != NULL) {
+        carry = prev->have - prev->len;
+        memcpy(s->in, prev->in + prev->len, carry);
+        s->offset = prev->offset + prev->len;
+    } else {
+        s->offset = 0;
+    }
+    s->have = carry;
+    s->last = 0;
+    while (s->have < p->block) {
+        n = p->rd(p->arg, s->in + s->have, p->block - s->have);
+        if (n == (size_t)-1) {
+            return MODP_PIPELINE_EREAD;
+        }
+        if (n == 0) {
+            s->last = 1;
+            break;
+        }
+        s->have += n;
+    }
+    if (s->last) {
+        s->len = s->have;
+    } else {
+        s->len = c->cut ? c->cut(s->in, s->have) : s->have / c->group * c->group;
+        if (s->len == 0) {
+            s->len = s->have;
+        }
+    }
+    return 0;
+}
+
+static void code(const modp_pipeline_codec* c, struct slot* s)
+{
+    modp_pipeline_fn fn = (s->last && c->last) ? c->last : c->fn;
+    s->outlen = fn(s->out, s->in, s->len);
+}
+
+/* the writer's part, 0 or an error */
+static int flush(struct pipeline* p, struct slot* s, modp_pipeline_write_fn wr)
+{
+    if (s->outlen == (size_t)-1) {
+        return MODP_PIPELINE_EINPUT;
+    }
+    if (wr(p->arg, s->out, s->outlen) != 0) {
+        return MODP_PIPELINE_EWRITE;
+    }
+    p->offset = s->offset + s->len;
+    return 0;
+}
+
+#ifdef HAVE_PTHREAD_H
+
+static void* reader_main(void* arg)
+{
+    struct pipeline* p = (struct pipeline*)arg;
+    struct slot* s;
+    struct slot* prev = NULL;
+    int rc;
+
+    for (;;) {
+        s = &p->slots[p->nread % p->nslots];
+        pthread_mutex_lock(&p->lock);
+        while (s->state != SLOT_FREE && p->rc == 0) {
+            pthread_cond_wait(&p->can_fill, &p->lock);
+        }
+        if (p->rc != 0) {
+            pthread_mutex_unlock(&p->lock);
+            break;
+        }
+        pthread_mutex_unlock(&p->lock);
+
+        rc = fill(p, s, prev);
+
+        pthread_mutex_lock(&p->lock);
+        if (rc != 0) {
+            if (p->rc == 0) {
+                p->rc = rc;
+            }
+        } else {
+            s->state = SLOT_FILLED;
+            p->nread += 1;
+            p->eof = s->last;
+        }
+        pthread_cond_broadcast(&p->can_work);
+        pthread_cond_broadcast(&p->can_write);
+        pthread_mutex_unlock(&p->lock);
+        if (rc != 0 || s->last) {
+            break;
+        }
+        prev = s;
+    }
+    return NULL;
+}
+
+static void* worker_main(void* arg)
+{
+    struct pipeline* p = (struct pipeline*)arg;
+    struct slot* s;
+
+    for (;;) {
+        pthread_mutex_lock(&p->lock);
+        while (p->nwork == p->nread && !p->eof && p->rc == 0) {
+            pthread_cond_wait(&p->can_work, &p->lock);
+        }
+        if (p->rc != 0 || p->nwork == p->nread) {
+            pthread_mutex_unlock(&p->lock);
+            break;
+        }
+        s = &p->slots[p->nwork % p->nslots];
+        p->nwork += 1;
+        pthread_mutex_unlock(&p->lock);
+
+        code(p->codec, s);
+
+        pthread_mutex_lock(&p->lock);
+        s->state = SLOT_DONE;
+        pthread_cond_broadcast(&p->can_write);
+        pthread_mutex_unlock(&p->lock);
+    }
+    return NULL;
+}
+
+/* write the blocks in order in this thread */
+static void writer(struct pipeline* p, modp_pipeline_write_fn wr)
+{
+    struct slot* s;
+    int rc;
+
+    for (;;) {
+        s = &p->slots[p->nwrite % p->nslots];
+        pthread_mutex_lock(&p->lock);
+        while (s->state != SLOT_DONE && !(p->eof && p->nwrite == p->nread) &&
+               p->rc == 0) {
+            pthread_cond_wait(&p->can_write, &p->lock);
+        }
+        if (p->rc != 0 || s->state != SLOT_DONE) {
+            pthread_mutex_unlock(&p->lock);
+            break;
+        }
+        pthread_mutex_unlock(&p->lock);
+
+        rc = flush(p, s, wr);
+
+        pthread_mutex_lock(&p->lock);
+        if (rc != 0) {
+            p->rc = rc;
+        } else {
+            s->state = SLOT_FREE;
+            p->nwrite += 1;
+        }
+        pthread_cond_broadcast(&p->can_fill);
+        pthread_cond_broadcast(&p->can_work);
+        pthread_mutex_unlock(&p->lock);
+        if (rc != 0) {
+            break;
+        }
+    }
+}
+
+static void run(struct pipeline* p, modp_pipeline_write_fn wr, size_t nthreads)
+{
+    pthread_t reader;
+    pthread_t* workers;
+    size_t i, started = 0;
+
+    workers = (pthread_t*)malloc(nthreads * sizeof(pthread_t));
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->can_fill, NULL);
+    pthread_cond_init(&p->can_work, NULL);
+    pthread_cond_init(&p->can_write, NULL);
+
+    if (workers == NULL || pthread_create(&reader, NULL, reader_main, p) != 0) {
+        p->rc = MODP_PIPELINE_ENOMEM;
+    } else {
+        for (i = 0; i < nthreads; ++i) {
+            if (pthread_create(&workers[i], NULL, worker_main, p) != 0) {
+                break;
+            }
+            ++started;
+        }
+        if (started == 0) {
+            pthread_mutex_lock(&p->lock);
+            p->rc = MODP_PIPELINE_ENOMEM;
+            pthread_cond_broadcast(&p->can_fill);
+            pthread_mutex_unlock(&p->lock);
+        } else {
+            writer(p, wr);
+        }
+        /* after an error the others see rc and stop */
+        pthread_mutex_lock(&p->lock);
+        pthread_cond_broadcast(&p->can_fill);
+        pthread_cond_broadcast(&p->can_work);
+        pthread_mutex_unlock(&p->lock);
+        for (i = 0; i < started; ++i) {
+            pthread_join(workers[i], NULL);
+        }
+        pthread_join(reader, NULL);
+    }
+
+    pthread_cond_destroy(&p->can_write);
+    pthread_cond_destroy(&p->can_work);
+    pthread_cond_destroy(&p->can_fill);
+    pthread_mutex_destroy(&p->lock);
+    free(workers);
+}
+
+#else
+
+/* no threads, the same steps one after the other */
+static void run(struct pipeline* p, modp_pipeline_write_fn wr, size_t nthreads)
+{
+    struct slot* prev = NULL;
+    struct slot* s;
+
+    (void)nthreads;
+    while (p->rc == 0) {
+        s = &p->slots[p->nread % p->nslots];
+        p->rc = fill(p, s, prev);
+        if (p->rc != 0) {
+            break;
+        }
+        p->nread += 1;
+        code(p->codec, s);
+        p->rc = flush(p, s, wr);
+        if (s->last) {
+            break;
+        }
+        prev = s;
+    }
+}
+
+#endif
+
+int modp_pipeline_run(const modp_pipeline_codec* codec,
+                      modp_pipeline_read_fn rd, modp_pipeline_write_fn wr,
+                      void* arg, size_t block, size_t nthreads, size_t* offset)
+{
+    struct pipeline p;
+    size_t i, outsize;
+
+    if (block == 0) {
+        block = (size_t)1 << 20;
+    }
+    if (nthreads == 0) {
+        nthreads = 1;
+    }
+    /* a whole number of groups, and room for a cut to leave some */
+    block = (block + codec->group - 1) / codec->group * codec->group;
+    if (block < 4 * codec->group) {
+        block = 4 * codec->group;
+    }
+    outsize = block / codec->group * codec->group_out + 16;
+
+    memset(&p, 0, sizeof(p));
+    p.codec = codec;
+    p.rd = rd;
+    p.arg = arg;
+    p.block = block;
+    p.nslots = 2 * nthreads;
+    p.slots = (struct slot*)calloc(p.nslots, sizeof(struct slot));
+    if (p.slots == NULL) {
+        p.rc = MODP_PIPELINE_ENOMEM;
+    }
+    for (i = 0; p.rc == 0 && i < p.nslots; ++i) {
+        p.slots[i].in = (char*)malloc(block);
+        p.slots[i].out = (char*)malloc(outsize);
+        if (p.slots[i].in == NULL || p.slots[i].out == NULL) {
+            p.rc = MODP_PIPELINE_ENOMEM;
+        }
+    }
+
+    if (p.rc == 0) {
+        run(&p, wr, nthreads);
+    }
+    if (offset != NULL) {
+        *offset = p.offset;
+    }
+    for (i = 0; p.slots != NULL && i < p.nslots; ++i) {
+        free(p.slots[i].out);
+        free(p.slots[i].in);
+    }
+    free(p.slots);
+    return p.rc;
+}
+
+#ifdef HAVE_UNISTD_H
+
+struct fds {
+    int in;
+    int out;
+};
+
+static size_t fd_read(void* arg, char* buf, size_t len)
+{
+    const struct fds* f = (const struct fds*)arg;
+    ssize_t n;
+
+    do {
+        n = read(f->in, buf, len);
+    } while (n < 0 && errno == EINTR);
+    return (n < 0) ? (size_t)-1 : (size_t)n;
+}
+
+static int fd_write(void* arg, const char* buf, size_t len)
+{
+    const struct fds* f = (const struct fds*)arg;
+    ssize_t n;
+
+    while (len > 0) {
+        n = write(f->out, buf, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+int modp_pipeline_fd(const modp_pipeline_codec* codec, int in, int out,
+                     size_t block, size_t nthreads, size_t* offset)
+{
+    struct fds f;
+    f.in = in;
+    f.out = out;
+    return modp_pipeline_run(codec, fd_read, fd_write, &f, block, nthreads, offset);
+}
+
+#endif
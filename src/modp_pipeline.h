@@ -0,0 +1,138 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_pipeline.h
+ * \brief code a stream on several threads, in order
+ *
+ * For input that can not be mapped, a pipe or a socket, where a
+ * read, code, write loop keeps only one core busy.  A reader thread
+ * reads blocks, worker threads call the one-shot codec on them, and
+ * the calling thread writes the results in input order.
+ *
+ * Blocks are cut where the codec can start again: on a multiple of
+ * the codec's group (3 bytes for b64 encode, 4 for b85, 1 for b16),
+ * or where the codec's cut function says for codecs with escapes.  So
+ * the output is the same as coding all the input in one call.
+ *
+ * There are at most 2 blocks per worker in flight, so the memory used
+ * is about 2 * nthreads * (block + its output), whatever the length of
+ * the stream.
+ *
+ * \code
+ * size_t at;
+ * int rc = modp_pipeline_fd(&modp_pipeline_b64_encode, 0, 1,
+ *                           1 << 20, 4, &at);
+ * \endcode
+ *
+ * Without pthreads the same thing is done in the calling thread.
+ */
+
+/*
+ * <PRE>
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_PIPELINE
+#define COM_MODP_STRINGENCODERS_PIPELINE
+
+#include "modp_stdint.h"
+#include "extern_c_begin.h"
+
+/**
+ * a one-shot codec, e.g. modp_b64_encode.  Returns the output length,
+ * or -1 if the input is bad.
+ */
+typedef size_t (*modp_pipeline_fn)(char* dest, const char* src, size_t len);
+
+/**
+ * how many of the len bytes at src can be coded without seeing what
+ * follows them.  Not called on the last block.
+ */
+typedef size_t (*modp_pipeline_cut_fn)(const char* src, size_t len);
+
+/**
+ * read up to len bytes into buf.  Returns the bytes read, 0 at the
+ * end of the input, or -1 on an error.
+ */
+typedef size_t (*modp_pipeline_read_fn)(void* arg, char* buf, size_t len);
+
+/**
+ * write len bytes.  Returns 0, or -1 on an error.
+ */
+typedef int (*modp_pipeline_write_fn)(void* arg, const char* buf, size_t len);
+
+/**
+ * A codec for the pipeline
+ */
+typedef struct modp_pipeline_codec {
+    /** codes a block */
+    modp_pipeline_fn fn;
+    /** codes the last block, NULL to use fn */
+    modp_pipeline_fn last;
+    /** NULL to cut blocks on a multiple of group */
+    modp_pipeline_cut_fn cut;
+    /** input bytes per group */
+    size_t group;
+    /** the most output bytes of a group */
+    size_t group_out;
+} modp_pipeline_codec;
+
+/** the base-N codecs, the decoders do not allow whitespace */
+extern const modp_pipeline_codec modp_pipeline_b2_encode;
+extern const modp_pipeline_codec modp_pipeline_b2_decode;
+extern const modp_pipeline_codec modp_pipeline_b16_encode;
+extern const modp_pipeline_codec modp_pipeline_b16_decode;
+extern const modp_pipeline_codec modp_pipeline_b64_encode;
+extern const modp_pipeline_codec modp_pipeline_b64_decode;
+extern const modp_pipeline_codec modp_pipeline_b64w_encode;
+extern const modp_pipeline_codec modp_pipeline_b64w_decode;
+extern const modp_pipeline_codec modp_pipeline_b64r_encode;
+extern const modp_pipeline_codec modp_pipeline_b64r_decode;
+extern const modp_pipeline_codec modp_pipeline_b85_encode;
+extern const modp_pipeline_codec modp_pipeline_b85_decode;
+extern const modp_pipeline_codec modp_pipeline_burl_encode;
+/** cuts blocks before a '%' without its two hex chars */
+extern const modp_pipeline_codec modp_pipeline_burl_decode;
+
+/** the results of modp_pipeline_run */
+#define MODP_PIPELINE_OK 0
+#define MODP_PIPELINE_EREAD -1
+#define MODP_PIPELINE_EWRITE -2
+#define MODP_PIPELINE_EINPUT -3
+#define MODP_PIPELINE_ENOMEM -4
+
+/**
+ * \brief code all of a stream
+ *
+ * \param[in] codec the codec
+ * \param[in] rd reads the input, called from one thread at a time
+ * \param[in] wr writes the output, called from the calling thread
+ * \param[in] arg passed to rd and wr
+ * \param[in] block input bytes per block, rounded up to a group, 0 for 1M
+ * \param[in] nthreads worker threads, 0 for 1
+ * \param[out] offset if not NULL, the input bytes coded and written.
+ *   After MODP_PIPELINE_EINPUT, the start of the block that failed.
+ * \return MODP_PIPELINE_OK or one of the errors
+ */
+int modp_pipeline_run(const modp_pipeline_codec* codec,
+                      modp_pipeline_read_fn rd, modp_pipeline_write_fn wr,
+                      void* arg, size_t block, size_t nthreads, size_t* offset);
+
+/**
+ * \brief modp_pipeline_run from one file descriptor to another
+ *
+ * Uses read(2) and write(2), retrying after EINTR and short writes.
+ */
+int modp_pipeline_fd(const modp_pipeline_codec* codec, int in, int out,
+                     size_t block, size_t nthreads, size_t* offset);
+
+#include "extern_c_end.h"
+
+#endif  /* COM_MODP_STRINGENCODERS_PIPELINE */
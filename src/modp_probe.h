@@ -0,0 +1,55 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_probe.h
+ * \brief USDT static tracepoints on the codec entry points (internal)
+ *
+ * Each entry point listed in modp_stats.h has a pair of probes in the
+ * "modp" provider, named after the function without "modp_":
+ *
+ *  - <id>_entry, arg0 is the input length
+ *  - <id>_return, arg0 is the input length, arg1 the result
+ *
+ * The result is what the function returns, so (size_t)-1 on an error,
+ * or a MODP_UTF8_ code for utf8_validate.  json_end and msgpk_end have
+ * no input and give a length of 0.
+ *
+ * The probes come from <sys/sdt.h> (systemtap-sdt-dev) and are built
+ * with configure --enable-usdt.  An unattached probe is a single nop,
+ * the tracer patches it when attached, so a library built with them
+ * does not need rebuilding to be traced.  Otherwise they are not
+ * compiled at all.  modp_inline.h never has probes.
+ *
+ * \code
+ * bpftrace -e 'usdt:/usr/local/lib/libmodpbase64.so:modp:b64_decode_entry
+ *     { @len = hist(arg0); }'
+ * \endcode
+ *
+ * This header is not installed and is not part of the public API.
+ */
+
+/*
+ * <PRE>
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_PROBE
+#define COM_MODP_STRINGENCODERS_PROBE
+
+#if defined(MODP_USDT) && !defined(MODP_INLINE)
+#include <sys/sdt.h>
+#define MODP_PROBE_ENTRY(id, len) DTRACE_PROBE1(modp, id##_entry, (len))
+#define MODP_PROBE_RETURN(id, len, r) DTRACE_PROBE2(modp, id##_return, (len), (r))
+#else
+#define MODP_PROBE_ENTRY(id, len) ((void)0)
+#define MODP_PROBE_RETURN(id, len, r) ((void)0)
+#endif
+
+#endif  /* COM_MODP_STRINGENCODERS_PROBE */
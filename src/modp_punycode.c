@@ -0,0 +1,422 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+/**
+ * \file modp_punycode.c
+ * <PRE>
+ * MODP_PUNYCODE - High performance Punycode and IDNA conversion
+ * http://code.google.com/p/stringencoders/
+ *
+ * Copyright &copy; 2026  Nick Galbreath -- nickg [at] modp [dot] com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the modp.com nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This is the standard "new" BSD license:
+ * http://www.opensource.org/licenses/bsd-license.php
+ * </PRE>
+ */
+
+#include "config.h"
+#include "modp_punycode.h"
+#include "modp_stats.h"
+#include "modp_probe.h"
+#include "modp_ascii.h"
+#include "modp_xml.h"
+#include "modp_stdint.h"
+#include "modp_swar.h"
+
+/* RFC 3492 section 5, parameter values for Punycode */
+#define PC_BASE 36u
+#define PC_TMIN 1u
+#define PC_TMAX 26u
+#define PC_SKEW 38u
+#define PC_DAMP 700u
+#define PC_INITIAL_BIAS 72u
+#define PC_INITIAL_N 0x80u
+
+#define PC_MAXINT 0xFFFFFFFFu
+
+/**
+ * Decode one UTF-8 char.  Rejects overlong forms, surrogates and
+ * values past U+10FFFF.
+ *
+ * \return number of bytes used, or 0 if invalid
+ */
+static size_t pc_utf8_decode(const uint8_t* s, size_t avail, uint32_t* cp)
+{
+    const uint32_t c = s[0];
+    uint32_t d;
+
+    if (c < 0x80) {
+        *cp = c;
+        return 1;
+    } else if (c < 0xC2) {
+        return 0;
+    } else if (c < 0xE0) {
+        if (avail < 2 || (s[1] & 0xC0) != 0x80) {
+            return 0;
+        }
+        *cp = ((c & 0x1F) << 6) | (s[1] & 0x3Fu);
+        return 2;
+    } else if (c < 0xF0) {
+        if (avail < 3 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80) {
+            return 0;
+        }
+        d = ((c & 0x0F) << 12) | ((s[1] & 0x3Fu) << 6) | (s[2] & 0x3Fu);
+        if (d < 0x0800 || (d >= 0xD800 && d <= 0xDFFF)) {
+            return 0;
+        }
+        *cp = d;
+        return 3;
+    } else if (c < 0xF5) {
+        if (avail < 4 || (s[1] & 0xC0) != 0x80 || (s[2] & 0xC0) != 0x80 ||
+            (s[3] & 0xC0) != 0x80) {
+            return 0;
+        }
+        d = ((c & 0x07) << 18) | ((s[1] & 0x3Fu) << 12) |
+            ((s[2] & 0x3Fu) << 6) | (s[3] & 0x3Fu);
+        if (d < 0x010000 || d > 0x10FFFF) {
+            return 0;
+        }
+        *cp = d;
+        return 4;
+    }
+    return 0;
+}
+
+/**
+ * True if every byte is 7-bit ascii, checked a word at a time
+ */
+static int pc_is_ascii(const uint8_t* s, size_t len)
+{
+    size_t i = 0;
+    modp_word_t w;
+
+    for (; i + MODP_WORD_SIZE <= len; i += MODP_WORD_SIZE) {
+        MODP_WORD_LOAD(w, s + i);
+        if (MODP_WORD_HASHIGH(w)) {
+            return 0;
+        }
+    }
+    for (; i < len; ++i) {
+        if (s[i] & 0x80) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* 0-25 is a-z, 26-35 is 0-9 */
+static char pc_encode_digit(uint32_t d)
+{
+    return (char)(d < 26 ? 'a' + d : '0' + (d - 26));
+}
+
+/* returns PC_BASE if not a digit, upper or lower case is allowed */
+static uint32_t pc_decode_digit(uint8_t c)
+{
+    if (c >= '0' && c <= '9') {
+        return (uint32_t)(c - '0') + 26;
+    }
+    if (c >= 'a' && c <= 'z') {
+        return (uint32_t)(c - 'a');
+    }
+    if (c >= 'A' && c <= 'Z') {
+        return (uint32_t)(c - 'A');
+    }
+    return PC_BASE;
+}
+
+static uint32_t pc_threshold(uint32_t k, uint32_t bias)
+{
+    if (k <= bias) {
+        return PC_TMIN;
+    }
+    if (k >= bias + PC_TMAX) {
+        return PC_TMAX;
+    }
+    return k - bias;
+}
+
+/* RFC 3492 section 6.1 */
+static uint32_t pc_adapt(uint32_t delta, uint32_t numpoints, int firsttime)
+{
+    uint32_t k = 0;
+
+    delta = firsttime ? delta / PC_DAMP : delta / 2;
+    delta += delta / numpoints;
+    while (delta > ((PC_BASE - PC_TMIN) * PC_TMAX) / 2) {
+        delta /= PC_BASE - PC_TMIN;
+        k += PC_BASE;
+    }
+    return k + (PC_BASE - PC_TMIN + 1) * delta / (delta + PC_SKEW);
+}
+
+static size_t punycode_encode_impl(char* dest, const char* src, size_t len)
+{
+    const uint8_t* s = (const uint8_t*) src;
+    uint32_t cps[MODP_PUNYCODE_MAX];
+    char* p = dest;
+    size_t ncp = 0;
+    size_t i = 0;
+    size_t j;
+    size_t n;
+    uint32_t c, m, q, k, t;
+    uint32_t cpn = PC_INITIAL_N;
+    uint32_t delta = 0;
+    uint32_t bias = PC_INITIAL_BIAS;
+    uint32_t h, b;
+
+    /* to code points, copying the basic ones to the output */
+    while (i < len) {
+        if (ncp == MODP_PUNYCODE_MAX) {
+            return (size_t)-1;
+        }
+        n = pc_utf8_decode(s + i, len - i, &c);
+        if (n == 0) {
+            return (size_t)-1;
+        }
+        if (c < 0x80) {
+            *p++ = (char) c;
+        }
+        cps[ncp++] = c;
+        i += n;
+    }
+
+    h = b = (uint32_t)(p - dest);
+    if (b > 0) {
+        *p++ = '-';
+    }
+
+    while (h < ncp) {
+        /* the smallest code point not yet handled */
+        m = PC_MAXINT;
+        for (j = 0; j < ncp; ++j) {
+            if (cps[j] >= cpn && cps[j] < m) {
+                m = cps[j];
+            }
+        }
+        if (m - cpn > (PC_MAXINT - delta) / (h + 1)) {
+            return (size_t)-1;
+        }
+        delta += (m - cpn) * (h + 1);
+        cpn = m;
+
+        for (j = 0; j < ncp; ++j) {
+            c = cps[j];
+            if (c < cpn) {
+                if (++delta == 0) {
+                    return (size_t)-1;
+                }
+            } else if (c == cpn) {
+                /* delta as a variable-length integer */
+                q = delta;
+                for (k = PC_BASE; ; k += PC_BASE) {
+                    t = pc_threshold(k, bias);
+                    if (q < t) {
+                        break;
+                    }
+                    *p++ = pc_encode_digit(t + (q - t) % (PC_BASE - t));
+                    q = (q - t) / (PC_BASE - t);
+                }
+                *p++ = pc_encode_digit(q);
+                bias = pc_adapt(delta, h + 1, h == b);
+                delta = 0;
+                ++h;
+            }
+        }
+        ++delta;
+        ++cpn;
+    }
+
+    *p = '\0';
+    return (size_t)(p - dest);
+}
+
+static size_t punycode_decode_impl(char* dest, const char* src, size_t len)
+{
+    const uint8_t* s = (const uint8_t*) src;
+    uint32_t cps[MODP_PUNYCODE_MAX];
+    char* p = dest;
+    size_t ncp = 0;
+    size_t b = 0;
+    size_t in;
+    size_t j;
+    uint32_t digit, w, k, t, oldi;
+    uint32_t i = 0;
+    uint32_t cpn = PC_INITIAL_N;
+    uint32_t bias = PC_INITIAL_BIAS;
+
+    /* basic code points are everything before the last delimiter */
+    for (j = len; j > 0; --j) {
+        if (s[j - 1] == '-') {
+            b = j - 1;
+            break;
+        }
+    }
+    if (b > MODP_PUNYCODE_MAX) {
+        return (size_t)-1;
+    }
+    for (j = 0; j < b; ++j) {
+        if (s[j] >= 0x80) {
+            return (size_t)-1;
+        }
+        cps[ncp++] = s[j];
+    }
+
+    in = (b > 0) ? b + 1 : 0;
+    while (in < len) {
+        oldi = i;
+        w = 1;
+        for (k = PC_BASE; ; k += PC_BASE) {
+            if (in >= len) {
+                return (size_t)-1;
+            }
+            digit = pc_decode_digit(s[in++]);
+            if (digit >= PC_BASE || digit > (PC_MAXINT - i) / w) {
+                return (size_t)-1;
+            }
+            i += digit * w;
+            t = pc_threshold(k, bias);
+            if (digit < t) {
+                break;
+            }
+            if (w > PC_MAXINT / (PC_BASE - t)) {
+                return (size_t)-1;
+            }
+            w *= PC_BASE - t;
+        }
+
+        bias = pc_adapt(i - oldi, (uint32_t)(ncp + 1), oldi == 0);
+        if (i / (ncp + 1) > PC_MAXINT - cpn) {
+            return (size_t)-1;
+        }
+        cpn += i / (uint32_t)(ncp + 1);
+        i %= (uint32_t)(ncp + 1);
+
+        if (cpn < 0x80 || cpn > 0x10FFFF || (cpn >= 0xD800 && cpn <= 0xDFFF)) {
+            return (size_t)-1;
+        }
+        if (ncp == MODP_PUNYCODE_MAX) {
+            return (size_t)-1;
+        }
+        memmove(cps + i + 1, cps + i, (ncp - i) * sizeof(uint32_t));
+        cps[i++] = cpn;
+        ++ncp;
+    }
+
+    for (j = 0; j < ncp; ++j) {
+        p += modp_xml_unicode_char_to_utf8(p, (int) cps[j]);
+    }
+    *p = '\0';
+    return (size_t)(p - dest);
+}
+
+size_t modp_idna_label_to_ascii(char* dest, const char* src, size_t len)
+{
+    size_t d;
+
+    if (pc_is_ascii((const uint8_t*) src, len)) {
+        modp_tolower_copy(dest, src, len);
+        return len;
+    }
+
+    memcpy(dest, "xn--", 4);
+    d = modp_punycode_encode(dest + 4, src, len);
+    if (d == (size_t)-1) {
+        return d;
+    }
+    /* the digits are already lowercase, this gets the basic chars */
+    modp_tolower(dest + 4, d);
+    return d + 4;
+}
+
+size_t modp_idna_label_to_unicode(char* dest, const char* src, size_t len)
+{
+    if (len >= 4 && (src[0] | 0x20) == 'x' && (src[1] | 0x20) == 'n' &&
+        src[2] == '-' && src[3] == '-') {
+        return modp_punycode_decode(dest, src + 4, len - 4);
+    }
+    modp_tolower_copy(dest, src, len);
+    return len;
+}
+
+/**
+ * Apply fn to each '.' separated label of a host name
+ */
+static size_t pc_host_map(char* dest, const char* src, size_t len,
+                          size_t (*fn)(char*, const char*, size_t))
+{
+    const char* end = src + len;
+    const char* dot;
+    char* p = dest;
+    size_t d;
+
+    for (;;) {
+        dot = (const char*) memchr(src, '.', (size_t)(end - src));
+        d = fn(p, src, (size_t)((dot ? dot : end) - src));
+        if (d == (size_t)-1) {
+            return d;
+        }
+        p += d;
+        if (dot == NULL) {
+            break;
+        }
+        *p++ = '.';
+        src = dot + 1;
+    }
+    *p = '\0';
+    return (size_t)(p - dest);
+}
+
+size_t modp_idna_host_to_ascii(char* dest, const char* src, size_t len)
+{
+    /* fast path, nothing to convert */
+    if (pc_is_ascii((const uint8_t*) src, len)) {
+        modp_tolower_copy(dest, src, len);
+        return len;
+    }
+    return pc_host_map(dest, src, len, modp_idna_label_to_ascii);
+}
+
+size_t modp_idna_host_to_unicode(char* dest, const char* src, size_t len)
+{
+    return pc_host_map(dest, src, len, modp_idna_label_to_unicode);
+}
+
+size_t modp_punycode_encode(char* dest, const char* src, size_t len)
+{
+    MODP_COUNTED_SIZE(punycode_encode,
+                      punycode_encode_impl(dest, src, len), len);
+}
+
+size_t modp_punycode_decode(char* dest, const char* src, size_t len)
+{
+    MODP_COUNTED_SIZE(punycode_decode,
+                      punycode_decode_impl(dest, src, len), len);
+}
@@ -0,0 +1,248 @@
+/* -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_punycode.h
+ * \brief Punycode (RFC 3492) and IDNA host name conversion
+ *
+ * modp_punycode_encode and modp_punycode_decode convert a single
+ * label between UTF-8 and Punycode.
+ *
+ * The modp_idna functions work on whole labels or host names: labels
+ * that are plain ascii are only lowercased (using modp_tolower), the
+ * rest are converted to or from "xn--" Punycode.  No nameprep or
+ * UTS 46 mapping is done on non-ascii text, and only '.' is a label
+ * separator.
+ *
+ * No function here allocates memory.  Work space is on the stack and
+ * limits a label to MODP_PUNYCODE_MAX code points.
+ */
+
+/*
+ * <PRE>
+ * High Performance Punycode encoder / decoder
+ *
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_PUNYCODE
+#define COM_MODP_STRINGENCODERS_PUNYCODE
+
+#include "modp_stdint.h"
+#include "extern_c_begin.h"
+
+/**
+ * Maximum number of code points in one label.  DNS labels are at
+ * most 63 chars so this is plenty.
+ */
+#define MODP_PUNYCODE_MAX 256
+
+/**
+ * \brief Punycode encode one UTF-8 label
+ *
+ * Basic (ascii) code points are copied as-is, so the case of the
+ * input is kept.  No "xn--" prefix is added.
+ *
+ * \param[out] dest output, at least modp_punycode_encode_len(len) bytes
+ * \param[in] src UTF-8 input
+ * \param[in] len length of the input
+ * \return strlen of the output, the output is null terminated, or -1
+ *   if the input is not valid UTF-8 or is too long.
+ */
+size_t modp_punycode_encode(char* dest, const char* src, size_t len);
+
+/**
+ * Memory needed to encode A bytes.  Each code point takes at most
+ * 11 digits and needs at least 2 input bytes if not ascii.
+ */
+#define modp_punycode_encode_len(A) (6*(A) + 2)
+
+/**
+ * \brief decode one Punycode label to UTF-8
+ *
+ * \param[out] dest output, at least modp_punycode_decode_len(len) bytes
+ * \param[in] src Punycode input, without the "xn--" prefix
+ * \param[in] len length of the input
+ * \return strlen of the output, the output is null terminated, or -1
+ *   if the input is invalid or decodes to too many code points.
+ */
+size_t modp_punycode_decode(char* dest, const char* src, size_t len);
+
+/**
+ * Memory needed to decode A bytes.
+ */
+#define modp_punycode_decode_len(A) (4*(A) + 1)
+
+/**
+ * \brief convert one label to its ascii (A-label) form
+ *
+ * An ascii label is lowercased.  Otherwise the result is "xn--" and
+ * the Punycode of the label with ascii chars lowercased.
+ *
+ * \param[out] dest output, at least modp_idna_to_ascii_len(len) bytes
+ * \param[in] src UTF-8 label
+ * \param[in] len length of the label
+ * \return strlen of the output, the output is null terminated, or -1
+ *   on error.
+ */
+size_t modp_idna_label_to_ascii(char* dest, const char* src, size_t len);
+
+/**
+ * \brief convert one label to its unicode (U-label) form
+ *
+ * An "xn--" label (any case) is decoded, anything else is lowercased.
+ *
+ * \param[out] dest output, at least modp_idna_to_unicode_len(len) bytes
+ * \param[in] src label
+ * \param[in] len length of the label
+ * \return strlen of the output, the output is null terminated, or -1
+ *   on error.
+ */
+size_t modp_idna_label_to_unicode(char* dest, const char* src, size_t len);
+
+/**
+ * \brief normalize a host name to lowercase ascii
+ *
+ * Each '.' separated label is converted with modp_idna_label_to_ascii.
+ * An ascii host is lowercased in one pass.
+ *
+ * \param[out] dest output, at least modp_idna_to_ascii_len(len) bytes
+ * \param[in] src UTF-8 host name
+ * \param[in] len length of the host name
+ * \return strlen of the output, the output is null terminated, or -1
+ *   on error.
+ */
+size_t modp_idna_host_to_ascii(char* dest, const char* src, size_t len);
+
+/**
+ * \brief convert a host name to unicode for display
+ *
+ * Each '.' separated label is converted with modp_idna_label_to_unicode.
+ *
+ * \param[out] dest output, at least modp_idna_to_unicode_len(len) bytes
+ * \param[in] src host name
+ * \param[in] len length of the host name
+ * \return strlen of the output, the output is null terminated, or -1
+ *   on error.
+ */
+size_t modp_idna_host_to_unicode(char* dest, const char* src, size_t len);
+
+/**
+ * Memory needed to convert a label or host name of A bytes to ascii.
+ */
+#define modp_idna_to_ascii_len(A) (8*(A) + 2)
+
+/**
+ * Memory needed to convert a label or host name of A bytes to unicode.
+ */
+#define modp_idna_to_unicode_len(A) (4*(A) + 1)
+
+#include "extern_c_end.h"
+
+#ifdef __cplusplus
+#include <cstring>
+#include <string>
+#include "modp_cxx.h"
+
+namespace modp {
+
+    MODP_CXX_CODEC(punycode_encode, modp_punycode_encode, modp_punycode_encode_len(len))
+    MODP_CXX_CODEC(punycode_decode, modp_punycode_decode, modp_punycode_decode_len(len))
+    MODP_CXX_CODEC(idna_to_ascii, modp_idna_host_to_ascii, modp_idna_to_ascii_len(len))
+    MODP_CXX_CODEC(idna_to_unicode, modp_idna_host_to_unicode, modp_idna_to_unicode_len(len))
+
+    /**
+     * \brief Punycode encode a UTF-8 label
+     * \return the encoded label.  Empty if failed.
+     */
+    inline std::string punycode_encode(const char* s, size_t len)
+    {
+        std::string x;
+        punycode_encode_append(x, s, len);
+        return x;
+    }
+
+    inline std::string punycode_encode(const char* s)
+    {
+        return punycode_encode(s, strlen(s));
+    }
+
+    inline std::string punycode_encode(const std::string& s)
+    {
+        return punycode_encode(s.data(), s.size());
+    }
+
+    /**
+     * \brief decode a Punycode label
+     * \return the UTF-8 label.  Empty if failed.
+     */
+    inline std::string punycode_decode(const char* s, size_t len)
+    {
+        std::string x;
+        punycode_decode_append(x, s, len);
+        return x;
+    }
+
+    inline std::string punycode_decode(const char* s)
+    {
+        return punycode_decode(s, strlen(s));
+    }
+
+    inline std::string punycode_decode(const std::string& s)
+    {
+        return punycode_decode(s.data(), s.size());
+    }
+
+    /**
+     * \brief normalize a host name to lowercase ascii
+     * \return the host name.  Empty if failed.
+     */
+    inline std::string idna_to_ascii(const char* s, size_t len)
+    {
+        std::string x;
+        idna_to_ascii_append(x, s, len);
+        return x;
+    }
+
+    inline std::string idna_to_ascii(const char* s)
+    {
+        return idna_to_ascii(s, strlen(s));
+    }
+
+    inline std::string idna_to_ascii(const std::string& s)
+    {
+        return idna_to_ascii(s.data(), s.size());
+    }
+
+    /**
+     * \brief convert a host name to unicode
+     * \return the host name.  Empty if failed.
+     */
+    inline std::string idna_to_unicode(const char* s, size_t len)
+    {
+        std::string x;
+        idna_to_unicode_append(x, s, len);
+        return x;
+    }
+
+    inline std::string idna_to_unicode(const char* s)
+    {
+        return idna_to_unicode(s, strlen(s));
+    }
+
+    inline std::string idna_to_unicode(const std::string& s)
+    {
+        return idna_to_unicode(s.data(), s.size());
+    }
+
+}       /* namespace modp */
+
+#endif  /* __cplusplus */
+
+#endif  /* COM_MODP_STRINGENCODERS_PUNYCODE */
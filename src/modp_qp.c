@@ -0,0 +1,438 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+/**
+ * \file modp_qp.c
+ * <PRE>
+ * MODP_QP - High performance quoted-printable encoder/decoder
+ * http://code.google.com/p/stringencoders/
+ *
+ * Copyright &copy; 2026  Nick Galbreath -- nickg [at] modp [dot] com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the modp.com nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This is the standard "new" BSD license:
+ * http://www.opensource.org/licenses/bsd-license.php
+ * </PRE>
+ */
+
+#include "config.h"
+#include "modp_qp.h"
+#include "modp_stats.h"
+#include "modp_probe.h"
+#include "modp_stdint.h"
+#include "modp_swar.h"
+#include "modp_qp_data.h"
+
+/*
+ * Content chars allowed on a line that is continued with a soft
+ * break, leaving room for the trailing '='
+ */
+#define QP_SOFT_MAX (MODP_QP_LINE_MAX - 1)
+
+/*
+ * Non-zero if a word contains a byte that is not a plain literal:
+ * controls (including TAB, CR, LF), non-ascii and '='
+ */
+#define QP_WORD_NEEDS_WORK(w) \
+    (MODP_WORD_HASLESS(w, 0x20) | MODP_WORD_HASMORE(w, 0x7E) | \
+     MODP_WORD_HASBYTE(w, '='))
+
+/**
+ * Encode s[0..len), looking ahead at most to s[avail - 1].
+ *
+ * If a byte can not be decided without seeing more input (white
+ * space or CR at the end) and final is 0, it and what follows is
+ * saved in ctx->pending.  This is never more than 2 bytes.
+ *
+ * \param[out] consumed number of input bytes used, may be more than
+ *   len when a CRLF straddles len.
+ * \return number of bytes written to dest
+ */
+static size_t qp_encode_run(modp_qp_ctx* ctx, char* dest, const uint8_t* s,
+                            size_t len, size_t avail, int final,
+                            size_t* consumed)
+{
+    const char* deststart = dest;
+    size_t col = ctx->col;
+    size_t i = 0;
+    size_t n;
+    modp_word_t w;
+    uint8_t c;
+
+    while (i < len) {
+        /*
+         * fast path: 8 literals at a time while they fit on the line.
+         * a space at the end of the word might end a line, so let the
+         * slow path look at it.
+         */
+        while (i + MODP_WORD_SIZE <= len && col + MODP_WORD_SIZE <= QP_SOFT_MAX) {
+            MODP_WORD_LOAD(w, s + i);
+            if (QP_WORD_NEEDS_WORK(w) || s[i + MODP_WORD_SIZE - 1] == ' ') {
+                break;
+            }
+            memcpy(dest, s + i, MODP_WORD_SIZE);
+            dest += MODP_WORD_SIZE;
+            i += MODP_WORD_SIZE;
+            col += MODP_WORD_SIZE;
+        }
+        if (i == len) {
+            break;
+        }
+
+        c = s[i];
+        switch (gsQPEncodeMap[c]) {
+        case 0:
+            n = 1;
+            break;
+        case 'S':
+            /* escape if followed by CRLF or the end of input */
+            if (i + 1 < avail) {
+                if (s[i + 1] != '\r') {
+                    n = 1;
+                } else if (i + 2 < avail) {
+                    n = (s[i + 2] == '\n') ? 3 : 1;
+                } else if (final) {
+                    n = 1;
+                } else {
+                    goto pend;
+                }
+            } else if (final) {
+                n = 3;
+            } else {
+                goto pend;
+            }
+            break;
+        case 'R':
+            if (i + 1 < avail) {
+                if (s[i + 1] == '\n') {
+                    /* hard line break */
+                    dest[0] = '\r';
+                    dest[1] = '\n';
+                    dest += 2;
+                    i += 2;
+                    col = 0;
+                    continue;
+                }
+                n = 3;
+            } else if (final) {
+                n = 3;
+            } else {
+                goto pend;
+            }
+            break;
+        default:
+            n = 3;
+        }
+
+        if (col + n > QP_SOFT_MAX) {
+            dest[0] = '=';
+            dest[1] = '\r';
+            dest[2] = '\n';
+            dest += 3;
+            col = 0;
+        }
+        if (n == 1) {
+            *dest++ = (char) c;
+        } else {
+            dest[0] = '=';
+            dest[1] = (char) gsHexEncodeMap1[c];
+            dest[2] = (char) gsHexEncodeMap2[c];
+            dest += 3;
+        }
+        col += n;
+        i += 1;
+    }
+
+    *consumed = i;
+    ctx->col = col;
+    return (size_t)(dest - deststart);
+
+pend:
+    ctx->npending = len - i;
+    memcpy(ctx->pending, s + i, len - i);
+    *consumed = len;
+    ctx->col = col;
+    return (size_t)(dest - deststart);
+}
+
+static size_t qp_encode_impl(char* dest, const char* src, size_t len)
+{
+    modp_qp_ctx ctx;
+    size_t consumed;
+    size_t d;
+
+    modp_qp_encode_init(&ctx);
+    d = qp_encode_run(&ctx, dest, (const uint8_t*) src, len, len, 1, &consumed);
+    dest[d] = '\0';
+    return d;
+}
+
+size_t modp_qp_encode_strlen(const char* src, size_t len)
+{
+    const uint8_t* s = (const uint8_t*) src;
+    size_t count = 0;
+    size_t col = 0;
+    size_t i = 0;
+    size_t n;
+
+    while (i < len) {
+        switch (gsQPEncodeMap[s[i]]) {
+        case 0:
+            n = 1;
+            break;
+        case 'S':
+            if (i + 1 == len ||
+                (i + 2 < len && s[i + 1] == '\r' && s[i + 2] == '\n')) {
+                n = 3;
+            } else {
+                n = 1;
+            }
+            break;
+        case 'R':
+            if (i + 1 < len && s[i + 1] == '\n') {
+                count += 2;
+                col = 0;
+                i += 2;
+                continue;
+            }
+            n = 3;
+            break;
+        default:
+            n = 3;
+        }
+        if (col + n > QP_SOFT_MAX) {
+            count += 3;
+            col = 0;
+        }
+        count += n;
+        col += n;
+        i += 1;
+    }
+    return count;
+}
+
+void modp_qp_encode_init(modp_qp_ctx* ctx)
+{
+    memset((void*)ctx, 0, sizeof(modp_qp_ctx));
+}
+
+size_t modp_qp_encode_update(modp_qp_ctx* ctx, char* dest,
+                             const char* src, size_t len)
+{
+    const uint8_t* s = (const uint8_t*) src;
+    char* p = dest;
+    uint8_t tmp[4];
+    size_t np = ctx->npending;
+    size_t used;
+
+    if (np) {
+        /*
+         * resolve the held back bytes using the start of this chunk.
+         * two bytes of look ahead is always enough.
+         */
+        memcpy(tmp, ctx->pending, np);
+        ctx->npending = 0;
+        if (len <= 2) {
+            memcpy(tmp + np, s, len);
+            p += qp_encode_run(ctx, p, tmp, np + len, np + len, 0, &used);
+            return (size_t)(p - dest);
+        }
+        memcpy(tmp + np, s, 2);
+        p += qp_encode_run(ctx, p, tmp, np, np + 2, 0, &used);
+        s += used - np;
+        len -= used - np;
+    }
+    p += qp_encode_run(ctx, p, s, len, len, 0, &used);
+    return (size_t)(p - dest);
+}
+
+size_t modp_qp_encode_final(modp_qp_ctx* ctx, char* dest)
+{
+    uint8_t tmp[2];
+    size_t np = ctx->npending;
+    size_t used;
+    size_t d = 0;
+
+    if (np) {
+        memcpy(tmp, ctx->pending, np);
+        ctx->npending = 0;
+        d = qp_encode_run(ctx, dest, tmp, np, np, 1, &used);
+    }
+    modp_qp_encode_init(ctx);
+    return d;
+}
+
+/**
+ * Decode s[0..len).  If final is 0, stops at an '=' that is too close
+ * to the end to decide and reports what was consumed.
+ *
+ * \return number of bytes written to dest
+ */
+static size_t qp_decode_run(char* dest, const uint8_t* s, size_t len,
+                            int final, size_t* consumed)
+{
+    const char* deststart = dest;
+    const uint8_t* pos;
+    size_t i = 0;
+    size_t n;
+    uint32_t d;
+
+    while (i < len) {
+        /* copy up to the next '=' in one go */
+        pos = (const uint8_t*) memchr(s + i, '=', len - i);
+        n = (pos == NULL) ? len - i : (size_t)(pos - (s + i));
+        if (n) {
+            /* may be in-place, dest is never ahead of s */
+            memmove(dest, s + i, n);
+            dest += n;
+            i += n;
+        }
+        if (i == len) {
+            break;
+        }
+
+        /* s[i] == '=' */
+        if (len - i < 3) {
+            if (len - i == 2 && s[i + 1] == '\n') {
+                i += 2;
+                continue;
+            }
+            if (!final) {
+                break;
+            }
+            *dest++ = '=';
+            i += 1;
+            continue;
+        }
+
+        d = (gsHexDecodeMap[s[i + 1]] << 4) | gsHexDecodeMap[s[i + 2]];
+        if (d < 256) { /* if one of the hex chars is bad,  d >= 256 */
+            *dest++ = (char) d;
+            i += 3;
+        } else if (s[i + 1] == '\r' && s[i + 2] == '\n') {
+            /* soft line break */
+            i += 3;
+        } else if (s[i + 1] == '\n') {
+            /* soft line break, bare LF */
+            i += 2;
+        } else {
+            *dest++ = '=';
+            i += 1;
+        }
+    }
+    *consumed = i;
+    return (size_t)(dest - deststart);
+}
+
+static size_t qp_decode_impl(char* dest, const char* src, size_t len)
+{
+    size_t consumed;
+    size_t d = qp_decode_run(dest, (const uint8_t*) src, len, 1, &consumed);
+    dest[d] = '\0';
+    return d;
+}
+
+void modp_qp_decode_init(modp_qp_ctx* ctx)
+{
+    memset((void*)ctx, 0, sizeof(modp_qp_ctx));
+}
+
+size_t modp_qp_decode_update(modp_qp_ctx* ctx, char* dest,
+                             const char* src, size_t len)
+{
+    const uint8_t* s = (const uint8_t*) src;
+    char* p = dest;
+    uint8_t tmp[3];
+    size_t np = ctx->npending;
+    size_t take;
+    size_t used;
+
+    /* finish the partial "=XX" from the last chunk */
+    while (np && len) {
+        take = 3 - np;
+        if (take > len) {
+            take = len;
+        }
+        memcpy(tmp, ctx->pending, np);
+        memcpy(tmp + np, s, take);
+        p += qp_decode_run(p, tmp, np + take, 0, &used);
+        if (used < np + take && take == len) {
+            /* still not enough, all of src is now pending */
+            ctx->npending = np + take - used;
+            memcpy(ctx->pending, tmp + used, ctx->npending);
+            return (size_t)(p - dest);
+        }
+        if (used < np) {
+            /* an '=' of the pending bytes was literal, the next waits */
+            np -= used;
+            memcpy(ctx->pending, tmp + used, np);
+            continue;
+        }
+        /* what tmp did not use of src is decoded with the rest of it */
+        s += used - np;
+        len -= used - np;
+        np = 0;
+    }
+    ctx->npending = np;
+    if (len == 0) {
+        return (size_t)(p - dest);
+    }
+
+    p += qp_decode_run(p, s, len, 0, &used);
+    if (used < len) {
+        ctx->npending = len - used;
+        memcpy(ctx->pending, s + used, ctx->npending);
+    }
+    return (size_t)(p - dest);
+}
+
+size_t modp_qp_decode_final(modp_qp_ctx* ctx, char* dest)
+{
+    uint8_t tmp[2];
+    size_t np = ctx->npending;
+    size_t used;
+    size_t d = 0;
+
+    if (np) {
+        memcpy(tmp, ctx->pending, np);
+        d = qp_decode_run(dest, tmp, np, 1, &used);
+    }
+    modp_qp_decode_init(ctx);
+    return d;
+}
+
+size_t modp_qp_encode(char* dest, const char* src, size_t len)
+{
+    MODP_COUNTED_SIZE(qp_encode, qp_encode_impl(dest, src, len), len);
+}
+
+size_t modp_qp_decode(char* dest, const char* src, size_t len)
+{
+    MODP_COUNTED_SIZE(qp_decode, qp_decode_impl(dest, src, len), len);
+}
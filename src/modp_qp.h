@@ -0,0 +1,237 @@
+/* -*- mode: c++; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_qp.h
+ * \brief quoted-printable (RFC 2045) encoding and decoding
+ *
+ * Used for MIME message bodies that are mostly ascii.  Printable
+ * ascii is passed through, everything else becomes "=XX" and lines
+ * are kept to 76 chars with "soft" line breaks ("=" CRLF).  A CRLF
+ * in the input is a "hard" line break and is passed through.
+ *
+ * Runs of printable ascii are found and copied 8 bytes at a time, so
+ * the encoder is close to memcpy speed on typical text.
+ *
+ * One shot and streaming interfaces are provided.
+ */
+
+/*
+ * <PRE>
+ * High Performance quoted-printable encoder / decoder
+ *
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_QP
+#define COM_MODP_STRINGENCODERS_QP
+
+#include "modp_stdint.h"
+#include "extern_c_begin.h"
+
+/**
+ * Maximum number of chars on an encoded line, not counting the CRLF
+ */
+#define MODP_QP_LINE_MAX 76
+
+/**
+ * \brief quoted-printable encode a string
+ *
+ * \param[out] dest output, must be at least modp_qp_encode_len(len) bytes
+ * \param[in] src the input
+ * \param[in] len the length of the input
+ * \return strlen of the output, the output is null terminated
+ */
+size_t modp_qp_encode(char* dest, const char* src, size_t len);
+
+/**
+ * Memory needed to encode A bytes.  Every byte may become "=XX" and a
+ * soft line break is added after at least every 73 output chars.
+ */
+#define modp_qp_encode_len(A) (3*(A) + 3*((3*(A))/73 + 1) + 1)
+
+/**
+ * \brief exact strlen of the quoted-printable encoding of src
+ *
+ * This examines every byte of the input.
+ *
+ * \param[in] src the input
+ * \param[in] len the length of the input
+ * \return the strlen of the output of modp_qp_encode
+ */
+size_t modp_qp_encode_strlen(const char* src, size_t len);
+
+/**
+ * \brief decode a quoted-printable string
+ *
+ * "=XX" (upper or lower case hex) is decoded and soft line breaks
+ * ("=" CRLF or "=" LF) are removed.  Any other use of "=" is passed
+ * through as-is, there is no error case.
+ *
+ * \param[out] dest the output, at least modp_qp_decode_len(len) bytes.
+ *   This may be the same as src.
+ * \param[in] src the encoded input
+ * \param[in] len the length of the input
+ * \return the strlen of the output, the output is null terminated
+ */
+size_t modp_qp_decode(char* dest, const char* src, size_t len);
+
+/**
+ * Memory needed to decode A bytes.
+ */
+#define modp_qp_decode_len(A) ((A) + 1)
+
+/**
+ * State for streaming encoding or decoding.  Treat as opaque.
+ *
+ * At most two bytes are held back between calls (trailing white
+ * space that may need escaping, or a partial "=XX").
+ */
+typedef struct {
+    size_t col;
+    size_t npending;
+    char pending[2];
+} modp_qp_ctx;
+
+/**
+ * \brief start a streaming encode
+ */
+void modp_qp_encode_init(modp_qp_ctx* ctx);
+
+/**
+ * \brief encode the next chunk of input
+ *
+ * The output is the same as calling modp_qp_encode on all the
+ * chunks joined together.  The output is NOT null terminated.
+ *
+ * \param[in,out] ctx the stream state
+ * \param[out] dest output, at least modp_qp_encode_len(len + 2) bytes
+ * \param[in] src the next chunk
+ * \param[in] len the length of the chunk, may be 0
+ * \return number of bytes written to dest
+ */
+size_t modp_qp_encode_update(modp_qp_ctx* ctx, char* dest,
+                             const char* src, size_t len);
+
+/**
+ * \brief finish a streaming encode, writing any held back input
+ *
+ * \param[in,out] ctx the stream state
+ * \param[out] dest output, at least modp_qp_encode_len(2) bytes
+ * \return number of bytes written to dest
+ */
+size_t modp_qp_encode_final(modp_qp_ctx* ctx, char* dest);
+
+/**
+ * \brief start a streaming decode
+ */
+void modp_qp_decode_init(modp_qp_ctx* ctx);
+
+/**
+ * \brief decode the next chunk of input
+ *
+ * \param[in,out] ctx the stream state
+ * \param[out] dest output, at least len + 2 bytes.  May be the same
+ *   as src if nothing is pending from an earlier chunk.
+ * \param[in] src the next chunk
+ * \param[in] len the length of the chunk, may be 0
+ * \return number of bytes written to dest
+ */
+size_t modp_qp_decode_update(modp_qp_ctx* ctx, char* dest,
+                             const char* src, size_t len);
+
+/**
+ * \brief finish a streaming decode
+ *
+ * \param[in,out] ctx the stream state
+ * \param[out] dest output, at least 2 bytes
+ * \return number of bytes written to dest
+ */
+size_t modp_qp_decode_final(modp_qp_ctx* ctx, char* dest);
+
+#include "extern_c_end.h"
+
+#ifdef __cplusplus
+#include <cstring>
+#include <string>
+#include "modp_cxx.h"
+
+namespace modp {
+
+    MODP_CXX_CODEC(qp_encode, modp_qp_encode, modp_qp_encode_len(len))
+    MODP_CXX_CODEC(qp_decode, modp_qp_decode, modp_qp_decode_len(len))
+
+    inline std::string qp_encode(const char* s, size_t len)
+    {
+        std::string x;
+        qp_encode_append(x, s, len);
+        return x;
+    }
+
+    inline std::string qp_encode(const char* s)
+    {
+        return qp_encode(s, strlen(s));
+    }
+
+    inline std::string qp_encode(const std::string& s)
+    {
+        return qp_encode(s.data(), s.size());
+    }
+
+    /**
+     * quoted-printable encode a string (self-modifing)
+     *
+     * \param[in,out] s the string to be encoded
+     * \return a reference to the input string
+     */
+    inline std::string& qp_encode(std::string& s)
+    {
+        std::string x(qp_encode(s.data(), s.size()));
+        s.swap(x);
+        return s;
+    }
+
+    /**
+     * quoted-printable decode a string (self-modifing)
+     * This function does not allocate memory.
+     *
+     * \param[in,out] s the string to be decoded
+     * \return a reference to the input string
+     */
+    inline std::string& qp_decode(std::string& s)
+    {
+        size_t d = modp_qp_decode(const_cast<char*>(s.data()), s.data(), s.size());
+        s.erase(d, std::string::npos);
+        return s;
+    }
+
+    inline std::string qp_decode(const char* s, size_t len)
+    {
+        std::string x(s, len);
+        qp_decode(x);
+        return x;
+    }
+
+    inline std::string qp_decode(const char* s)
+    {
+        return qp_decode(s, strlen(s));
+    }
+
+    inline std::string qp_decode(const std::string& s)
+    {
+        std::string x(s);
+        qp_decode(x);
+        return x;
+    }
+
+}       /* namespace modp */
+
+#endif  /* __cplusplus */
+
+#endif  /* COM_MODP_STRINGENCODERS_QP */
@@ -0,0 +1,113 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+#include "arraytoc.h"
+
+static void hexencodemap(void)
+{
+    static const char sHexChars[] = "0123456789ABCDEF";
+    int i;
+    char hexEncode1[256];
+    char hexEncode2[256];
+    for (i = 0; i < 256; ++i) {
+        hexEncode1[i] = sHexChars[i >> 4];
+        hexEncode2[i] = sHexChars[i & 0x0f];
+    }
+
+    char_array_to_c(hexEncode1, sizeof(hexEncode1), "gsHexEncodeMap1");
+    char_array_to_c(hexEncode2, sizeof(hexEncode2), "gsHexEncodeMap2");
+}
+
+/*
+ * RFC 2045 section 6.7
+ *  0   literal, "printable" 33-60 and 62-126
+ *  'S' space or tab, literal unless it ends a line
+ *  'R' carriage return, literal only as part of CRLF
+ *  'E' everything else, written as "=XX"
+ */
+static void qpencodemap(void)
+{
+    int i;
+    char qpEncodeMap[256];
+
+    for (i = 0; i < 256; ++i) {
+        qpEncodeMap[i] = 'E';
+    }
+    for (i = 33; i <= 126; ++i) {
+        qpEncodeMap[i] = 0;
+    }
+    qpEncodeMap[(int)'='] = 'E';
+    qpEncodeMap[(int)' '] = 'S';
+    qpEncodeMap[(int)'\t'] = 'S';
+    qpEncodeMap[(int)'\r'] = 'R';
+
+    char_array_to_c(qpEncodeMap, sizeof(qpEncodeMap), "gsQPEncodeMap");
+}
+
+/*
+ * RFC 2047 section 5 (3), the "Q" encoding as used in a phrase
+ *  0   literal, letters, digits and "!*+-/"
+ *  '_' space, written as "_"
+ *  'E' everything else, written as "=XX"
+ */
+static void qencodemap(void)
+{
+    int i;
+    char qEncodeMap[256];
+    static const char sLiterals[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+        "abcdefghijklmnopqrstuvwxyz"
+        "0123456789!*+-/";
+
+    for (i = 0; i < 256; ++i) {
+        qEncodeMap[i] = 'E';
+    }
+    for (i = 0; sLiterals[i]; ++i) {
+        qEncodeMap[(int)sLiterals[i]] = 0;
+    }
+    qEncodeMap[(int)' '] = '_';
+
+    char_array_to_c(qEncodeMap, sizeof(qEncodeMap), "gsQEncodeMap");
+}
+
+static void hexdecodemap(void)
+{
+    uint32_t i;
+    uint32_t map[256];
+    for (i = 0; i <= 255; ++i) {
+        map[i] = 256;
+    }
+
+    /* digits */
+    for (i = '0'; i <= '9'; ++i) {
+        map[i] = i - '0';
+    }
+
+    /* upper */
+    for (i = 'A'; i <= 'F'; ++i) {
+        map[i] = i - 'A' + 10;
+    }
+
+    /* lower, not allowed by the RFC but seen in the wild */
+    for (i = 'a'; i <= 'f'; ++i) {
+        map[i] = i - 'a' + 10;
+    }
+
+    uint32_array_to_c(map, sizeof(map)/sizeof(uint32_t), "gsHexDecodeMap");
+}
+
+/*
+ * with no argument, the tables for modp_qp.c
+ * with "q", the tables for modp_encword.c
+ */
+int main(int argc, char** argv)
+{
+    if (argc > 1 && argv[1][0] == 'q') {
+        qencodemap();
+    } else {
+        qpencodemap();
+    }
+    hexdecodemap();
+    hexencodemap();
+    return 0;
+}
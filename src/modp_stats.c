@@ -0,0 +1,267 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+/**
+ * \file modp_stats.c
+ * <PRE>
+ * MODP_STATS - per codec call, byte and error counters
+ * http://code.google.com/p/stringencoders/
+ *
+ * Copyright &copy; 2026  Nick Galbreath -- nickg [at] modp [dot] com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *   Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ *   Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ *   Neither the name of the modp.com nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * This is the standard "new" BSD license:
+ * http://www.opensource.org/licenses/bsd-license.php
+ * </PRE>
+ */
+
+#include "config.h"
+#include "modp_stats.h"
+
+static const char* const stats_names[MODP_STATS_COUNT] = {
+    "modp_b2_encode", "modp_b2_decode",
+    "modp_b16_encode", "modp_b16_decode",
+    "modp_b64_encode", "modp_b64_decode",
+    "modp_b64w_encode", "modp_b64w_decode",
+    "modp_b64r_encode", "modp_b64r_decode",
+    "modp_b85_encode", "modp_b85_decode",
+    "modp_burl_encode", "modp_burl_min_encode",
+    "modp_burl_decode", "modp_burl_decode_raw",
+    "modp_bjavascript_encode", "modp_bjavascript_uencode",
+    "modp_bjavascript_decode",
+    "modp_xml_encode", "modp_xml_decode",
+    "modp_utf8_validate",
+    "modp_json_end", "modp_msgpk_end",
+    "modp_qp_encode", "modp_qp_decode",
+    "modp_encword_encode", "modp_encword_decode",
+    "modp_punycode_encode", "modp_punycode_decode",
+    "modp_datauri_encode", "modp_datauri_decode"
+};
+
+#if defined(MODP_STATS) && !defined(MODP_INLINE)
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#define CALLS 0
+#define BYTES_IN 1
+#define BYTES_OUT 2
+#define ERRORS 3
+
+/*
+ * One thread's counters.  Only the owning thread writes them, readers
+ * sum them under the lock.  The loads and stores are relaxed atomics,
+ * plain moves on common CPUs.
+ */
+struct stats_block {
+    uint64_t c[MODP_STATS_COUNT][4];
+    struct stats_block* next;
+    int in_use;
+};
+
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t stats_once = PTHREAD_ONCE_INIT;
+static pthread_key_t stats_key;
+static struct stats_block* stats_blocks = NULL;
+static uint64_t stats_zero[MODP_STATS_COUNT][4];
+static __thread struct stats_block* stats_mine = NULL;
+
+/* thread exit: the block keeps its counts and goes to the next thread */
+static void stats_release(void* p)
+{
+    struct stats_block* b = (struct stats_block*)p;
+    pthread_mutex_lock(&stats_lock);
+    b->in_use = 0;
+    pthread_mutex_unlock(&stats_lock);
+}
+
+static void stats_make_key(void)
+{
+    pthread_key_create(&stats_key, stats_release);
+}
+
+static struct stats_block* stats_block(void)
+{
+    struct stats_block* b;
+    void* p;
+
+    if (stats_mine != NULL) {
+        return stats_mine;
+    }
+    pthread_once(&stats_once, stats_make_key);
+    pthread_mutex_lock(&stats_lock);
+    for (b = stats_blocks; b != NULL && b->in_use; b = b->next) {
+    }
+    if (b == NULL && posix_memalign(&p, 64, sizeof(struct stats_block)) == 0) {
+        b = (struct stats_block*)p;
+        memset(b, 0, sizeof(*b));
+        b->next = stats_blocks;
+        stats_blocks = b;
+    }
+    if (b != NULL) {
+        b->in_use = 1;
+    }
+    pthread_mutex_unlock(&stats_lock);
+    if (b != NULL) {
+        pthread_setspecific(stats_key, b);
+    }
+    stats_mine = b;
+    return b;
+}
+
+static void stats_add(uint64_t* c, uint64_t v)
+{
+    __atomic_store_n(c, __atomic_load_n(c, __ATOMIC_RELAXED) + v, __ATOMIC_RELAXED);
+}
+
+static void stats_count(int id, size_t len, size_t out, int error)
+{
+    struct stats_block* b = stats_block();
+    if (b == NULL) {
+        return;
+    }
+    stats_add(&b->c[id][CALLS], 1);
+    stats_add(&b->c[id][BYTES_IN], len);
+    if (error) {
+        stats_add(&b->c[id][ERRORS], 1);
+    } else {
+        stats_add(&b->c[id][BYTES_OUT], out);
+    }
+}
+
+size_t modp_stats_size(int id, size_t len, size_t r)
+{
+    stats_count(id, len, r, r == (size_t)-1);
+    return r;
+}
+
+int modp_stats_utf8(int id, size_t len, int r)
+{
+    stats_count(id, len, 0, r != 0);
+    return r;
+}
+
+/* the sum of every block, call with the lock held */
+static void stats_sum(uint64_t sum[MODP_STATS_COUNT][4])
+{
+    const struct stats_block* b;
+    int i, j;
+
+    memset(sum, 0, sizeof(uint64_t) * MODP_STATS_COUNT * 4);
+    for (b = stats_blocks; b != NULL; b = b->next) {
+        for (i = 0; i < MODP_STATS_COUNT; ++i) {
+            for (j = 0; j < 4; ++j) {
+                sum[i][j] += __atomic_load_n(&b->c[i][j], __ATOMIC_RELAXED);
+            }
+        }
+    }
+}
+
+int modp_stats_enabled(void)
+{
+    return 1;
+}
+
+size_t modp_stats_read(modp_stats_entry* out, size_t n)
+{
+    uint64_t sum[MODP_STATS_COUNT][4];
+    size_t i;
+
+    pthread_mutex_lock(&stats_lock);
+    stats_sum(sum);
+    for (i = 0; i < n && i < MODP_STATS_COUNT; ++i) {
+        out[i].name = stats_names[i];
+        out[i].calls = sum[i][CALLS] - stats_zero[i][CALLS];
+        out[i].bytes_in = sum[i][BYTES_IN] - stats_zero[i][BYTES_IN];
+        out[i].bytes_out = sum[i][BYTES_OUT] - stats_zero[i][BYTES_OUT];
+        out[i].errors = sum[i][ERRORS] - stats_zero[i][ERRORS];
+    }
+    pthread_mutex_unlock(&stats_lock);
+    return i;
+}
+
+void modp_stats_reset(void)
+{
+    pthread_mutex_lock(&stats_lock);
+    stats_sum(stats_zero);
+    pthread_mutex_unlock(&stats_lock);
+}
+
+#else
+
+size_t modp_stats_size(int id, size_t len, size_t r)
+{
+    (void)id;
+    (void)len;
+    return r;
+}
+
+int modp_stats_utf8(int id, size_t len, int r)
+{
+    (void)id;
+    (void)len;
+    return r;
+}
+
+int modp_stats_enabled(void)
+{
+    return 0;
+}
+
+size_t modp_stats_read(modp_stats_entry* out, size_t n)
+{
+    size_t i;
+    for (i = 0; i < n && i < MODP_STATS_COUNT; ++i) {
+        memset(&out[i], 0, sizeof(out[i]));
+        out[i].name = stats_names[i];
+    }
+    return i;
+}
+
+void modp_stats_reset(void)
+{
+}
+
+#endif
+
+void modp_stats_print(FILE* f)
+{
+    modp_stats_entry e[MODP_STATS_COUNT];
+    size_t i, n = modp_stats_read(e, MODP_STATS_COUNT);
+
+    for (i = 0; i < n; ++i) {
+        if (e[i].calls) {
+            fprintf(f, "%s %llu %llu %llu %llu\n", e[i].name,
+                    (unsigned long long)e[i].calls,
+                    (unsigned long long)e[i].bytes_in,
+                    (unsigned long long)e[i].bytes_out,
+                    (unsigned long long)e[i].errors);
+        }
+    }
+}
@@ -0,0 +1,185 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_stats.h
+ * \brief optional per codec call, byte and error counters
+ *
+ * When the library is configured with --enable-stats (which defines
+ * MODP_STATS), each entry point listed in modp_stats_id counts its
+ * calls, input bytes, output bytes and error returns.  This shows
+ * which codecs real traffic spends its bytes in.
+ *
+ * The counters are per thread: each thread adds to its own cache
+ * line aligned block, so counting is a few adds with no locks and no
+ * shared cache lines.  The blocks are only summed when read.  A block
+ * is reused by the next new thread when its thread exits, so the
+ * totals include threads that have gone.
+ *
+ * Only calls from outside the library are counted.  The base64 of
+ * modp_encword and modp_datauri and the stages of modp_fuse are not
+ * counted as b64, burl or utf8 calls.  modp_pipeline and modp_iov
+ * call the function of their codec, so they count one call of it
+ * for each piece they code.
+ *
+ * Without --enable-stats the counting compiles away, the functions
+ * here still exist, modp_stats_enabled returns 0 and the counters
+ * read as 0.  modp_inline.h never counts.
+ *
+ * \code
+ * modp_stats_entry e[MODP_STATS_COUNT];
+ * size_t i, n = modp_stats_read(e, MODP_STATS_COUNT);
+ * for (i = 0; i < n; ++i) {
+ *     if (e[i].calls) printf("%s %llu\n", e[i].name, e[i].bytes_in);
+ * }
+ * \endcode
+ */
+
+/*
+ * <PRE>
+ * Copyright &copy; 2026 Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ * </PRE>
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_STATS
+#define COM_MODP_STRINGENCODERS_STATS
+
+#include <stdio.h>
+#include "modp_stdint.h"
+#include "extern_c_begin.h"
+
+/**
+ * The counted entry points.  The names are the function names
+ * without "modp_", in lower case so the b64w and b64r sources made
+ * from modp_b64.c count under their own name.
+ */
+typedef enum modp_stats_id {
+    MODP_STATS_ID_b2_encode,
+    MODP_STATS_ID_b2_decode,
+    MODP_STATS_ID_b16_encode,
+    MODP_STATS_ID_b16_decode,
+    MODP_STATS_ID_b64_encode,
+    MODP_STATS_ID_b64_decode,
+    MODP_STATS_ID_b64w_encode,
+    MODP_STATS_ID_b64w_decode,
+    MODP_STATS_ID_b64r_encode,
+    MODP_STATS_ID_b64r_decode,
+    MODP_STATS_ID_b85_encode,
+    MODP_STATS_ID_b85_decode,
+    MODP_STATS_ID_burl_encode,
+    MODP_STATS_ID_burl_min_encode,
+    MODP_STATS_ID_burl_decode,
+    MODP_STATS_ID_burl_decode_raw,
+    MODP_STATS_ID_bjavascript_encode,
+    MODP_STATS_ID_bjavascript_uencode,
+    MODP_STATS_ID_bjavascript_decode,
+    MODP_STATS_ID_xml_encode,
+    MODP_STATS_ID_xml_decode,
+    MODP_STATS_ID_utf8_validate,
+    MODP_STATS_ID_json_end,
+    MODP_STATS_ID_msgpk_end,
+    MODP_STATS_ID_qp_encode,
+    MODP_STATS_ID_qp_decode,
+    MODP_STATS_ID_encword_encode,
+    MODP_STATS_ID_encword_decode,
+    MODP_STATS_ID_punycode_encode,
+    MODP_STATS_ID_punycode_decode,
+    MODP_STATS_ID_datauri_encode,
+    MODP_STATS_ID_datauri_decode,
+    MODP_STATS_COUNT
+} modp_stats_id;
+
+/**
+ * The totals of one entry point
+ */
+typedef struct modp_stats_entry {
+    /** the function, e.g. "modp_b64_decode" */
+    const char* name;
+    uint64_t calls;
+    /** bytes read, 0 for modp_json_end and modp_msgpk_end */
+    uint64_t bytes_in;
+    /** bytes written, not counting calls that failed */
+    uint64_t bytes_out;
+    /** calls that returned -1 (or for utf8_validate, not MODP_UTF8_OK) */
+    uint64_t errors;
+} modp_stats_entry;
+
+/**
+ * \brief 1 if the library was built with --enable-stats
+ */
+int modp_stats_enabled(void);
+
+/**
+ * \brief read the totals of every thread since the last reset
+ *
+ * \param[out] out the totals, in modp_stats_id order
+ * \param[in] n entries in out, MODP_STATS_COUNT for all
+ * \return the number of entries written
+ */
+size_t modp_stats_read(modp_stats_entry* out, size_t n);
+
+/**
+ * \brief start counting from 0 again
+ *
+ * The counts of the moment become the zero point, the threads'
+ * counters are not written.
+ */
+void modp_stats_reset(void);
+
+/**
+ * \brief write each entry point with calls, one per line
+ *
+ * "name calls bytes_in bytes_out errors"
+ */
+void modp_stats_print(FILE* f);
+
+/*
+ * Used by the library.  Count a call with result r and return r.
+ */
+size_t modp_stats_size(int id, size_t len, size_t r);
+int modp_stats_utf8(int id, size_t len, int r);
+
+#include "extern_c_end.h"
+
+/*
+ * MODP_STATS_SIZE(b64_decode, len, r) counts a call of modp_b64_decode
+ * with len bytes of input and result r, and is r.
+ */
+#if defined(MODP_STATS) && !defined(MODP_INLINE)
+#define MODP_STATS_SIZE(id, len, r) modp_stats_size(MODP_STATS_ID_##id, (len), (r))
+#define MODP_STATS_UTF8(id, len, r) modp_stats_utf8(MODP_STATS_ID_##id, (len), (r))
+#else
+#define MODP_STATS_SIZE(id, len, r) (r)
+#define MODP_STATS_UTF8(id, len, r) (r)
+#endif
+
+/*
+ * The body of a counted entry point: fire the entry probe of
+ * modp_probe.h, count the call of impl, fire the return probe and
+ * return its result.  The file must include modp_probe.h.
+ *
+ *   size_t modp_b64_decode(char* dest, const char* src, size_t len)
+ *   {
+ *       MODP_COUNTED_SIZE(b64_decode, b64_decode_impl(dest, src, len), len);
+ *   }
+ *
+ * MODP_COUNTED_UTF8 is the same for the int result of utf8_validate.
+ */
+#define MODP_COUNTED_(type, kind, id, impl, len)              \
+    do {                                                      \
+        type modp_counted_r;                                  \
+        MODP_PROBE_ENTRY(id, len);                            \
+        modp_counted_r = MODP_STATS_##kind(id, len, impl);    \
+        MODP_PROBE_RETURN(id, len, modp_counted_r);           \
+        return modp_counted_r;                                \
+    } while (0)
+
+#define MODP_COUNTED_SIZE(id, impl, len) MODP_COUNTED_(size_t, SIZE, id, impl, len)
+#define MODP_COUNTED_UTF8(id, impl, len) MODP_COUNTED_(int, UTF8, id, impl, len)
+
+#endif  /* COM_MODP_STRINGENCODERS_STATS */
@@ -0,0 +1,54 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/**
+ * \file modp_swar.h
+ * \brief word-at-a-time byte tests (internal)
+ *
+ * "SIMD within a register" helpers used by the escaping encoders to
+ * skip over runs of bytes that need no work, eight bytes at a time.
+ * Each macro answers "does ANY byte in the word match?" exactly;
+ * which byte matched is found by falling back to the per-byte loop.
+ *
+ * These are the standard tricks from "Bit Twiddling Hacks"
+ * http://graphics.stanford.edu/~seander/bithacks.html
+ *
+ * This header is not installed and is not part of the public API.
+ */
+
+#ifndef COM_MODP_STRINGENCODERS_SWAR
+#define COM_MODP_STRINGENCODERS_SWAR
+
+#include "modp_stdint.h"
+
+typedef uint64_t modp_word_t;
+
+#define MODP_WORD_SIZE 8
+
+/** copy unaligned input into a word, the compiler turns this into a load */
+#define MODP_WORD_LOAD(w, p) memcpy(&(w), (p), sizeof(modp_word_t))
+
+/** the byte c in every position of a word */
+#define MODP_WORD_BCAST(c) ((modp_word_t)0x0101010101010101ULL * (uint8_t)(c))
+
+#define MODP_WORD_HIBITS ((modp_word_t)0x8080808080808080ULL)
+
+/** non-zero if any byte is 0 */
+#define MODP_WORD_HASZERO(x) \
+    (((x) - MODP_WORD_BCAST(1)) & ~(x) & MODP_WORD_HIBITS)
+
+/** non-zero if any byte equals c */
+#define MODP_WORD_HASBYTE(x, c) MODP_WORD_HASZERO((x) ^ MODP_WORD_BCAST(c))
+
+/** non-zero if any byte is less than n, 0 <= n <= 128 */
+#define MODP_WORD_HASLESS(x, n) \
+    (((x) - MODP_WORD_BCAST(n)) & ~(x) & MODP_WORD_HIBITS)
+
+/** non-zero if any byte is greater than n, 0 <= n <= 127 */
+#define MODP_WORD_HASMORE(x, n) \
+    ((((x) + MODP_WORD_BCAST(127 - (n))) | (x)) & MODP_WORD_HIBITS)
+
+/** non-zero if any byte has the high bit set (i.e. is not 7-bit ascii) */
+#define MODP_WORD_HASHIGH(x) ((x) & MODP_WORD_HIBITS)
+
+#endif /* COM_MODP_STRINGENCODERS_SWAR */
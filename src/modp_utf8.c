@@ -45,8 +45,11 @@
 #include <string.h>
 #include "config.h"
 #include "modp_utf8.h"
+#include "modp_stats.h"
+#include "modp_probe.h"
+#include "modp_internal.h"
 
-int modp_utf8_validate(const char* src_orig, size_t len)
+int modp_utf8_validate_impl(const char* src_orig, size_t len)
 {
     const uint8_t* src = (const uint8_t*) src_orig;
     const uint8_t* srcend = src + len;
@@ -91,3 +94,9 @@ int modp_utf8_validate(const char* src_orig, size_t len)
     }
     return MODP_UTF8_OK;
 }
+
+int modp_utf8_validate(const char* src_orig, size_t len)
+{
+    MODP_COUNTED_UTF8(utf8_validate,
+                      modp_utf8_validate_impl(src_orig, len), len);
+}
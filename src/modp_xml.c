@@ -40,7 +40,12 @@
  * http://www.opensource.org/licenses/bsd-license.php
  * </PRE>
  */
+#include "config.h"
 #include "modp_xml.h"
+#include "modp_stats.h"
+#include "modp_probe.h"
+#include "modp_escape.h"
+#include "modp_xml_data.h"
 
 static const int gsHexDecodeMap[256] = {
 256, 256, 256, 256, 256, 256, 256, 256, 256, 256, 256, 256,
@@ -166,7 +171,7 @@ int modp_xml_parse_dec_entity(const char* s, size_t len)
     int val = 0;
     size_t i;
     for (i = 0; i < len; ++i) {
-        int d = gsHexDecodeMap[(uint32_t)s[i]];
+        int d = gsHexDecodeMap[(uint8_t)s[i]];
         if (d > 9) {
             return -1;
         }
@@ -187,7 +192,7 @@ int modp_xml_parse_hex_entity(const char* s, size_t len)
     int val = 0;
     size_t i;
     for (i = 0; i < len; ++i) {
-        int d = gsHexDecodeMap[(uint32_t)s[i]];
+        int d = gsHexDecodeMap[(uint8_t)s[i]];
         if (d == 256) {
             return -1;
         }
@@ -199,7 +204,7 @@ int modp_xml_parse_hex_entity(const char* s, size_t len)
     return modp_xml_validate_unicode(val);
 }
 
-size_t modp_xml_decode(char* dest, const char* s, size_t len)
+static size_t xml_decode_impl(char* dest, const char* s, size_t len)
 {
     const uint8_t* src = (const uint8_t*) s;
     const char* deststart = dest;
@@ -221,13 +226,19 @@ size_t modp_xml_decode(char* dest, const char* s, size_t len)
         }
         size_t elen = (size_t)(pos - src);
         if (*(src+1) == '#') {
+            if (elen < ((*(src+2) == 'x' || *(src+2) == 'X') ? 4u : 3u)) {
+                /* "&#;" or "&#x;", no digits */
+                *dest++ = (char) *src++;
+                continue;
+            }
             if (*(src+2) == 'x' || *(src+2) == 'X') {
                 unichar = modp_xml_parse_hex_entity((const char*)(src + 3), elen - 3);
             } else {
 
                 unichar = modp_xml_parse_dec_entity((const char*)(src + 2), elen - 2);
             }
-            if (unichar == 0) {
+            if (unichar <= 0) {
+                /* not a valid code point, just copy */
                 *dest++ = (char) *src++;
             } else {
                 dest += modp_xml_unicode_char_to_utf8(dest, unichar);
@@ -261,87 +272,24 @@ size_t modp_xml_decode(char* dest, const char* s, size_t len)
     return (size_t)(dest - deststart); /* compute "strlen" of dest. */
 }
 
-size_t modp_xml_encode(char* dest, const char* src, size_t len)
+static size_t xml_encode_impl(char* dest, const char* src, size_t len)
 {
-    size_t count = 0;
-    const char* srcend = src + len;
-    char ch;
-    while (src < srcend) {
-        ch = *src++;
-        switch (ch) {
-        case '&':
-            *dest++ = '&';
-            *dest++ = 'a';
-            *dest++ = 'm';
-            *dest++ = 'p';
-            *dest++ = ';';
-            count += 5; /* &amp; */
-            break;
-        case '<':
-            *dest++ = '&';
-            *dest++ = 'l';
-            *dest++ = 't';
-            *dest++ = ';';
-            count += 4; /* &lt; */
-            break;
-        case '>':
-            *dest++ = '&';
-            *dest++ = 'g';
-            *dest++ = 't';
-            *dest++ = ';';
-            count += 4; /* &gt; */
-            break;
-        case '\'':
-            *dest++ = '&';
-            *dest++ = 'q';
-            *dest++ = 'u';
-            *dest++ = 'o';
-            *dest++ = 't';
-            *dest++ = ';';
-            count += 6; /* &quot; */
-            break;
-        case '\"':
-            *dest++ = '&';
-            *dest++ = 'a';
-            *dest++ = 'p';
-            *dest++ = 'o';
-            *dest++ = 's';
-            *dest++ = ';';
-            count += 6; /* &apos; */
-            break;
-        default:
-            *dest++ = ch;
-            count += 1;
-        }
-    }
-    *dest = '\0';
-    return count;
+    size_t n = modp_escape_encode(dest, src, len, gsXmlEncodeLen, gsXmlEncodeEsc);
+    dest[n] = '\0';
+    return n;
 }
 
 size_t modp_xml_min_encode_strlen(const char* src, const size_t len)
 {
-    size_t count = 0;
-    const char* srcend = src + len;
-    while (src < srcend) {
-        switch (*src++) {
-        case '&':
-            count += 5; /* &amp; */
-            break;
-        case '<':
-            count += 4; /* &lt; */
-            break;
-        case '>':
-            count += 4; /* &gt; */
-            break;
-        case '\'':
-            count += 6; /* &quot; */
-            break;
-        case '\"':
-            count += 6; /* &apos; */
-            break;
-        default:
-            count += 1;
-        }
-    }
-    return count;
+    return modp_escape_strlen(src, len, gsXmlEncodeLen);
+}
+
+size_t modp_xml_decode(char* dest, const char* s, size_t len)
+{
+    MODP_COUNTED_SIZE(xml_decode, xml_decode_impl(dest, s, len), len);
+}
+
+size_t modp_xml_encode(char* dest, const char* src, size_t len)
+{
+    MODP_COUNTED_SIZE(xml_encode, xml_encode_impl(dest, src, len), len);
 }
@@ -117,6 +117,12 @@ size_t modp_xml_decode(char* dest, const char* str, size_t len);
  */
 size_t modp_xml_encode(char* dest, const char* str, size_t len);
 
+/**
+ * Memory needed for modp_xml_encode, each char may be 6 ("&quot;")
+ * plus the ending null
+ */
+#define modp_xml_encode_len(A) (6 * (A) + 1)
+
 size_t modp_xml_min_encode_strlen(const char* str, size_t len);
 
 END_C
@@ -124,9 +130,37 @@ END_C
 #ifdef __cplusplus
 #include <cstring>
 #include <string>
+#include "modp_cxx.h"
 
 namespace modp {
 
+    MODP_CXX_CODEC(xml_encode, modp_xml_encode, modp_xml_encode_len(len))
+    MODP_CXX_CODEC(xml_decode, modp_xml_decode, len + 1)
+
+    inline std::string xml_encode(const char* s, size_t len)
+    {
+        std::string x;
+        xml_encode_append(x, s, len);
+        return x;
+    }
+
+    inline std::string xml_encode(const char* s)
+    {
+        return xml_encode(s, strlen(s));
+    }
+
+    inline std::string& xml_encode(std::string& s)
+    {
+        std::string x(xml_encode(s.data(), s.size()));
+        s.swap(x);
+        return s;
+    }
+
+    inline std::string xml_encode(const std::string& s)
+    {
+        return xml_encode(s.data(), s.size());
+    }
+
     /**
      * Url decode a string.
      * This function does not allocate memory.
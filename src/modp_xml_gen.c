@@ -0,0 +1,30 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+#include "arraytoc.h"
+
+/*
+ * the five XML entities, everything else is as-is
+ */
+static void xmlescapes(void)
+{
+    const char* esc[256];
+    int i;
+
+    for (i = 0; i < 256; ++i) {
+        esc[i] = NULL;
+    }
+    esc['&'] = "&amp;";
+    esc['<'] = "&lt;";
+    esc['>'] = "&gt;";
+    esc['\''] = "&apos;";
+    esc['"'] = "&quot;";
+
+    escape_array_to_c(esc, "gsXmlEncode");
+}
+
+int main(void)
+{
+    xmlescapes();
+    return 0;
+}
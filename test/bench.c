@@ -0,0 +1,1279 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/** \file bench.c
+ *
+ * Copyright 2026, Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ *
+ * modp_bench, the benchmark driver.  This does NOT test correctness.
+ *
+ * Each benchmark in bench_codecs.c is run over a sweep of input sizes
+ * (1 byte to 64MB by default, to show the L1/L2/L3/DRAM steps).  For
+ * each size the number of calls per repetition is picked so one
+ * repetition takes at least --min-time ms, one repetition is run as
+ * warmup, then --reps repetitions are timed with the monotonic clock.
+ * The per call median, min, mean and standard deviation are reported
+ * along with GB/s and cycles per byte of the median.
+ *
+ * Cycles are TSC (reference) cycles on x86, calibrated against the
+ * clock at startup, or --ghz elsewhere.
+ *
+ * The input is generated by bench_corpus.c, each benchmark using the
+ * kind of data it sees in practice (random bytes for base64, url-like
+ * text for burl, ...) unless --corpus picks one for all.  The text
+ * corpora are run at each --density, the fraction of characters that
+ * need an escape, so throughput can be plotted against density.
+ *
+ * With --latency single calls are timed instead, for the small inputs
+ * (8 to 64 bytes by default) where call overhead and the tail handling
+ * matter more than throughput.  Each call is timed with rdtsc/rdtscp
+ * (the clock elsewhere), the calls of all sizes are made in one
+ * shuffled sequence on inputs picked at random from a pool, and p50,
+ * p99 and p99.9 are reported.  "warm" makes the calls back to back,
+ * "cold" walks --evict bytes of memory before each call so the tables
+ * and input come from DRAM.
+ *
+ * With --threads each benchmark runs on 1, 2, 4, ... threads at once,
+ * each thread on its own copy of the input, first alone and then next
+ * to a co-runner thread that keeps walking --corunner bytes of memory.
+ * Per thread GB/s, the total, and the scaling (per thread GB/s against
+ * the first thread count without the co-runner) show which codecs
+ * lose out when their tables are shared or pushed out of the cache.
+ *
+ * With --perf the timed repetitions are also counted with hardware
+ * counters (see bench_perf.c), adding IPC, core cycles per byte, and
+ * branch and L1D misses per byte.  Counters that are not available
+ * are left out.
+ *
+ * With --compare the results are checked against a baseline from an
+ * earlier --json run, see bench_compare.c, and the exit status is 1 if
+ * any benchmark got slower by more than the noise allows.
+ *
+ *   ./modp_bench [--filter=b64,burl] [--sizes=1,64,4K] [--json=out.json]
+ *
+ * "make bench" runs it with results in bench.json and bench.csv, and
+ * "make bench-density" sweeps the escaping codecs over densities.
+ * "make bench-baseline" saves a baseline and "make bench-compare" runs
+ * again and compares.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define HAVE_RDTSC 1
+#endif
+
+#include "bench.h"
+
+#define MAX_SIZES 64
+#define MAX_DENSITIES 32
+
+/* inputs per size for --latency */
+#define LAT_POOL 64
+
+#define LAT_WARM 1
+#define LAT_COLD 2
+
+struct options {
+    size_t sizes[MAX_SIZES];
+    size_t nsizes;
+    double densities[MAX_DENSITIES];
+    size_t ndensities;
+    int corpus;           /* BENCH_CORPUS_, or -1 for each codec's own */
+    uint32_t seed;
+    size_t reps;
+    double min_time_ns;
+    size_t max_mem;
+    const char* filter;
+    const char* json;
+    const char* csv;
+    const char* compare;  /* baseline JSON for --compare */
+    double threshold;     /* smallest slowdown that is a regression */
+    double ghz;
+    int perf;
+    int quiet;
+    int latency;          /* LAT_WARM | LAT_COLD, 0 for throughput */
+    int sizes_set;
+    size_t samples;       /* calls timed per size for --latency */
+    size_t evict;         /* bytes walked before each cold call */
+    size_t threads[MAX_SIZES];  /* thread counts for --threads */
+    size_t nthreads;
+    size_t corunner;      /* bytes the --threads co-runner walks, 0 for none */
+};
+
+/* results so far, written to the json and csv files at the end */
+static struct bench_result* results = NULL;
+static size_t nresults = 0;
+
+/* calls write here so they can't be optimized away */
+volatile size_t bench_sink;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* TSC cycles per ns, or 0 if there is no TSC */
+static double tsc_ghz(void)
+{
+#ifdef HAVE_RDTSC
+    double t0, t1;
+    unsigned long long c0, c1;
+
+    t0 = now_ns();
+    c0 = __rdtsc();
+    do {
+        t1 = now_ns();
+    } while (t1 - t0 < 50e6);
+    c1 = __rdtsc();
+    return (double)(c1 - c0) / (t1 - t0);
+#else
+    return 0.0;
+#endif
+}
+
+/*
+ * Timestamps for single calls.  The lfences keep the call from being
+ * reordered around the reads, rdtscp waits for it to finish.  Ticks
+ * are TSC cycles, or ns without a TSC.
+ */
+#ifdef HAVE_RDTSC
+static uint64_t tick_start(void)
+{
+    uint64_t t;
+    _mm_lfence();
+    t = __rdtsc();
+    _mm_lfence();
+    return t;
+}
+
+static uint64_t tick_stop(void)
+{
+    unsigned int aux;
+    uint64_t t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+}
+#else
+static uint64_t tick_start(void)
+{
+    return (uint64_t)now_ns();
+}
+
+static uint64_t tick_stop(void)
+{
+    return (uint64_t)now_ns();
+}
+#endif
+
+/* parse "64", "4K", "16M" */
+static size_t parse_size(const char* s)
+{
+    char* end;
+    double v = strtod(s, &end);
+    switch (*end) {
+    case 'k': case 'K': v *= 1024.0; break;
+    case 'm': case 'M': v *= 1024.0 * 1024.0; break;
+    case 'g': case 'G': v *= 1024.0 * 1024.0 * 1024.0; break;
+    default: break;
+    }
+    return (size_t)v;
+}
+
+/* "4K" for 4096, into buf of at least 32 bytes */
+static const char* format_size(char* buf, size_t n)
+{
+    if (n >= 1024 * 1024 && n % (1024 * 1024) == 0) {
+        sprintf(buf, "%luM", (unsigned long)(n / (1024 * 1024)));
+    } else if (n >= 1024 && n % 1024 == 0) {
+        sprintf(buf, "%luK", (unsigned long)(n / 1024));
+    } else {
+        sprintf(buf, "%lu", (unsigned long)n);
+    }
+    return buf;
+}
+
+/* is name in the comma separated list of substrings, NULL matches all */
+static int match_filter(const char* filter, const char* name)
+{
+    const char* p = filter;
+    const char* comma;
+    char word[64];
+    size_t n;
+
+    if (filter == NULL) {
+        return 1;
+    }
+    while (*p) {
+        comma = strchr(p, ',');
+        n = comma ? (size_t)(comma - p) : strlen(p);
+        if (n > 0 && n < sizeof(word)) {
+            memcpy(word, p, n);
+            word[n] = '\0';
+            if (strstr(name, word) != NULL) {
+                return 1;
+            }
+        }
+        if (comma == NULL) {
+            break;
+        }
+        p = comma + 1;
+    }
+    return 0;
+}
+
+/* total ns for iters calls */
+static double time_calls(const struct bench_codec* c, char* out,
+                         const char* in, size_t inlen, size_t iters)
+{
+    /* read through a volatile so the call can't be inlined */
+    bench_fn volatile vfn = c->fn;
+    bench_fn fn = vfn;
+    size_t i, acc = 0;
+    double t0, t1;
+
+    t0 = now_ns();
+    for (i = 0; i < iters; ++i) {
+        acc += fn(out, in, inlen);
+    }
+    t1 = now_ns();
+    bench_sink = acc;
+    return t1 - t0;
+}
+
+static int cmp_double(const void* a, const void* b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* fill in the statistics of r from n per call samples, sorts them */
+static void stats(struct bench_result* r, double* samples, size_t n)
+{
+    size_t i;
+    double sum = 0.0, var = 0.0;
+
+    qsort(samples, n, sizeof(double), cmp_double);
+    r->min_ns = samples[0];
+    r->median_ns = (n % 2) ? samples[n / 2]
+        : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+    for (i = 0; i < n; ++i) {
+        sum += samples[i];
+    }
+    r->mean_ns = sum / (double)n;
+    for (i = 0; i < n; ++i) {
+        var += (samples[i] - r->mean_ns) * (samples[i] - r->mean_ns);
+    }
+    r->stddev_ns = (n > 1) ? sqrt(var / (double)(n - 1)) : 0.0;
+}
+
+/* (max - min) / median of n sorted values */
+static double rel_range(const double* sorted, size_t n)
+{
+    double median = (n % 2) ? sorted[n / 2]
+        : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+    return median > 0.0 ? (sorted[n - 1] - sorted[0]) / median : 0.0;
+}
+
+/*
+ * rel_range of the medians of nruns runs of consecutive samples,
+ * sorts each run's samples
+ */
+static double run_spread(double* samples, size_t n, size_t nruns)
+{
+    double* medians;
+    double* run;
+    size_t i, len;
+    double spread;
+
+    if (nruns > n) {
+        nruns = n;
+    }
+    if (nruns < 2 || (medians = (double*)malloc(nruns * sizeof(double))) == NULL) {
+        return 0.0;
+    }
+    for (i = 0; i < nruns; ++i) {
+        /* the last run takes what is left over */
+        run = samples + i * (n / nruns);
+        len = (i + 1 < nruns) ? n / nruns : n - i * (n / nruns);
+        qsort(run, len, sizeof(double), cmp_double);
+        medians[i] = (len % 2) ? run[len / 2] : (run[len / 2 - 1] + run[len / 2]) / 2.0;
+    }
+    qsort(medians, nruns, sizeof(double), cmp_double);
+    spread = rel_range(medians, nruns);
+    free(medians);
+    return spread;
+}
+
+/*
+ * Run one benchmark at one size.  Returns NULL, or why it was skipped.
+ */
+static const char* run_one(const struct options* opt, const struct bench_codec* c,
+                   const char* raw, size_t size, struct bench_result* r)
+{
+    char* prepbuf = NULL;
+    char* out;
+    const char* in = raw;
+    size_t inlen = size;
+    size_t outlen;
+    size_t iters = 1;
+    size_t i;
+    double t;
+    double* samples;
+    double counts[BENCH_PERF_COUNT];
+
+    if (c->prep != NULL) {
+        if (9 * size + 64 > opt->max_mem ||
+            (prepbuf = (char*)malloc(8 * size + 64)) == NULL) {
+            return "not enough memory";
+        }
+        inlen = c->prep(prepbuf, raw, size);
+        if (inlen == (size_t)-1) {
+            free(prepbuf);
+            return "no valid input of this size";
+        }
+        in = prepbuf;
+    }
+    outlen = c->mult * inlen + c->add + 16;
+    if (outlen + (in == raw ? 0 : inlen) > opt->max_mem ||
+        (out = (char*)malloc(outlen)) == NULL) {
+        free(prepbuf);
+        return "not enough memory";
+    }
+
+    /* find the calls per repetition, this also warms up */
+    for (;;) {
+        t = time_calls(c, out, in, inlen, iters);
+        if (t >= opt->min_time_ns || iters >= ((size_t)1 << 40)) {
+            break;
+        }
+        if (t < opt->min_time_ns / 16) {
+            iters *= 8;
+        } else {
+            iters = (size_t)((double)iters * 1.2 * opt->min_time_ns / t) + 1;
+        }
+    }
+    time_calls(c, out, in, inlen, iters);
+
+    samples = (double*)malloc(opt->reps * sizeof(double));
+    if (samples == NULL) {
+        free(out);
+        free(prepbuf);
+        return "not enough memory";
+    }
+    if (opt->perf) {
+        bench_perf_start();
+    }
+    for (i = 0; i < opt->reps; ++i) {
+        samples[i] = time_calls(c, out, in, inlen, iters) / (double)iters;
+    }
+    bench_perf_stop(counts);
+
+    memset(r, 0, sizeof(*r));
+    for (i = 0; i < BENCH_PERF_COUNT; ++i) {
+        r->perf[i] = (opt->perf && counts[i] >= 0.0) ?
+            counts[i] / ((double)opt->reps * (double)iters) : -1.0;
+    }
+    r->name = c->name;
+    r->size = size;
+    r->bytes = (c->flags & BENCH_FIXED) ? c->fn(out, in, inlen) : inlen;
+    r->iters = iters;
+    r->reps = opt->reps;
+    stats(r, samples, opt->reps);
+    r->spread = rel_range(samples, opt->reps);
+    r->gbps = r->bytes ? (double)r->bytes / r->median_ns : 0.0;
+    r->cpb = (opt->ghz > 0.0 && r->bytes) ?
+        r->median_ns * opt->ghz / (double)r->bytes : 0.0;
+
+    free(samples);
+    free(out);
+    free(prepbuf);
+    return NULL;
+}
+
+/* xorshift32 for the latency schedule */
+static uint32_t lat_rand(uint32_t* s)
+{
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *s = x;
+    return x;
+}
+
+/* nearest rank percentile of n sorted samples */
+static double percentile(const double* sorted, size_t n, double p)
+{
+    size_t i = (size_t)ceil(p * (double)n);
+    return sorted[i > 0 ? i - 1 : 0];
+}
+
+/* the smallest time of an empty tick_start/tick_stop pair */
+static double tick_overhead(void)
+{
+    uint64_t t0, t1, best = (uint64_t)-1;
+    int i;
+    for (i = 0; i < 1000; ++i) {
+        t0 = tick_start();
+        t1 = tick_stop();
+        if (t1 - t0 < best) {
+            best = t1 - t0;
+        }
+    }
+    return (double)best;
+}
+
+struct lat_input {
+    const char* in;
+    size_t inlen;
+};
+
+/*
+ * --latency for one benchmark, all sizes at once.  Writes a result per
+ * size to rs and returns how many.  ticks_ns is ticks per ns.
+ */
+static size_t run_latency(const struct options* opt, const struct bench_codec* c,
+                          const char* raw, size_t rawlen, int cold,
+                          double ticks_ns, struct bench_result* rs)
+{
+    bench_fn volatile vfn = c->fn;
+    bench_fn fn = vfn;
+    size_t nsizes = (c->flags & BENCH_FIXED) ? 1 : opt->nsizes;
+    size_t nsamples = opt->samples;
+    size_t i, j, k, e, n, nr = 0, outlen = 0, preplen = 0, acc = 0;
+    size_t done[MAX_SIZES];
+    int valid[MAX_SIZES];
+    struct lat_input* pool;
+    struct bench_result* r;
+    unsigned char* evict = NULL;
+    char* prepbuf = NULL;
+    char* out = NULL;
+    size_t* order = NULL;
+    double* samples = NULL;
+    double overhead = tick_overhead();
+    double spread;
+    uint32_t seed = opt->seed ? opt->seed : 1;
+    uint64_t t0, t1;
+    char sz[32];
+
+    if (cold) {
+        /* DRAM misses are slow, take fewer samples */
+        nsamples = (nsamples + 9) / 10;
+        if (nsamples < 1000 && opt->samples >= 1000) {
+            nsamples = 1000;
+        }
+    }
+
+    pool = (struct lat_input*)malloc(nsizes * LAT_POOL * sizeof(struct lat_input));
+    if (pool == NULL) {
+        return 0;
+    }
+    for (j = 0; j < nsizes; ++j) {
+        n = (c->flags & BENCH_FIXED) ? 0 : opt->sizes[j];
+        if (n > rawlen || (c->prep && 8 * n + 64 > opt->max_mem / LAT_POOL / nsizes)) {
+            fprintf(stderr, "modp_bench: %s at %s skipped, not enough memory\n",
+                    c->name, format_size(sz, n));
+            valid[j] = 0;
+            continue;
+        }
+        valid[j] = 1;
+        if (c->prep != NULL) {
+            preplen += LAT_POOL * (8 * n + 64);
+        }
+    }
+    if (preplen > 0 && (prepbuf = (char*)malloc(preplen)) == NULL) {
+        free(pool);
+        return 0;
+    }
+
+    /* the pool, random slices of raw, run through prep */
+    preplen = 0;
+    for (j = 0; j < nsizes; ++j) {
+        n = (c->flags & BENCH_FIXED) ? 0 : opt->sizes[j];
+        for (k = 0; valid[j] && k < LAT_POOL; ++k) {
+            pool[j * LAT_POOL + k].in = raw + lat_rand(&seed) % (rawlen - n + 1);
+            pool[j * LAT_POOL + k].inlen = n;
+            if (c->prep != NULL) {
+                pool[j * LAT_POOL + k].inlen =
+                    c->prep(prepbuf + preplen, pool[j * LAT_POOL + k].in, n);
+                pool[j * LAT_POOL + k].in = prepbuf + preplen;
+                preplen += 8 * n + 64;
+                if (pool[j * LAT_POOL + k].inlen == (size_t)-1) {
+                    fprintf(stderr, "modp_bench: %s at %s skipped, no valid input of this size\n",
+                            c->name, format_size(sz, n));
+                    valid[j] = 0;
+                }
+            }
+            if (valid[j] && c->mult * pool[j * LAT_POOL + k].inlen + c->add > outlen) {
+                outlen = c->mult * pool[j * LAT_POOL + k].inlen + c->add;
+            }
+        }
+    }
+
+    /* every size nsamples times, shuffled */
+    for (j = 0, n = 0; j < nsizes; ++j) {
+        n += valid[j] ? nsamples : 0;
+    }
+    order = (size_t*)malloc((n + 1) * sizeof(size_t));
+    samples = (double*)malloc((nsizes * nsamples + 1) * sizeof(double));
+    out = (char*)malloc(outlen + 16);
+    if (cold) {
+        evict = (unsigned char*)malloc(opt->evict + 1);
+    }
+    if (order == NULL || samples == NULL || out == NULL || (cold && evict == NULL)) {
+        goto done;
+    }
+    if (cold) {
+        memset(evict, 0, opt->evict + 1);
+    }
+    for (j = 0, i = 0; j < nsizes; ++j) {
+        for (k = 0; valid[j] && k < nsamples; ++k) {
+            order[i++] = j;
+        }
+        done[j] = 0;
+    }
+    for (i = n; i > 1; --i) {
+        k = lat_rand(&seed) % i;
+        j = order[i - 1];
+        order[i - 1] = order[k];
+        order[k] = j;
+    }
+
+    /* warmup, every input once */
+    for (i = 0; i < nsizes * LAT_POOL; ++i) {
+        if (valid[i / LAT_POOL]) {
+            acc += fn(out, pool[i].in, pool[i].inlen);
+        }
+    }
+
+    for (i = 0; i < n; ++i) {
+        j = order[i];
+        k = j * LAT_POOL + lat_rand(&seed) % LAT_POOL;
+        if (cold) {
+            for (e = 0; e < opt->evict; e += 64) {
+                evict[e] = (unsigned char)(evict[e] + 1);
+            }
+        }
+        t0 = tick_start();
+        acc += fn(out, pool[k].in, pool[k].inlen);
+        t1 = tick_stop();
+        samples[j * nsamples + done[j]++] =
+            ((double)(t1 - t0) > overhead ? (double)(t1 - t0) - overhead : 0.0) / ticks_ns;
+    }
+    bench_sink = acc;
+
+    for (j = 0; j < nsizes; ++j) {
+        if (!valid[j]) {
+            continue;
+        }
+        r = &rs[nr++];
+        memset(r, 0, sizeof(*r));
+        for (k = 0; k < BENCH_PERF_COUNT; ++k) {
+            r->perf[k] = -1.0;
+        }
+        r->name = c->name;
+        r->size = (c->flags & BENCH_FIXED) ? 0 : opt->sizes[j];
+        r->bytes = (c->flags & BENCH_FIXED) ?
+            fn(out, pool[0].in, pool[0].inlen) : pool[j * LAT_POOL].inlen;
+        r->iters = 1;
+        r->reps = nsamples;
+        r->cache = cold ? "cold" : "warm";
+        spread = run_spread(samples + j * nsamples, nsamples, opt->reps);
+        stats(r, samples + j * nsamples, nsamples);
+        r->spread = spread;
+        r->p50_ns = percentile(samples + j * nsamples, nsamples, 0.50);
+        r->p99_ns = percentile(samples + j * nsamples, nsamples, 0.99);
+        r->p999_ns = percentile(samples + j * nsamples, nsamples, 0.999);
+        r->gbps = (r->bytes && r->median_ns > 0.0) ? (double)r->bytes / r->median_ns : 0.0;
+        r->cpb = (opt->ghz > 0.0 && r->bytes) ?
+            r->median_ns * opt->ghz / (double)r->bytes : 0.0;
+    }
+
+done:
+    free(evict);
+    free(out);
+    free(samples);
+    free(order);
+    free(prepbuf);
+    free(pool);
+    return nr;
+}
+
+/*
+ * --threads for one benchmark at one size, for each thread count alone
+ * and with the co-runner.  Writes the results to rs, returns how many.
+ */
+static size_t run_threads(const struct options* opt, const struct bench_codec* c,
+                          const char* raw, size_t size, struct bench_result* rs)
+{
+    char* prepbuf = NULL;
+    char* out;
+    const char* in = raw;
+    size_t inlen = size;
+    size_t outlen, bytes, most = 0;
+    size_t i, k, n, cr, nr = 0;
+    double *calls, *elapsed, *samples;
+    double total, base = 0.0;
+    struct bench_result* r;
+    char sz[32];
+
+    for (k = 0; k < opt->nthreads; ++k) {
+        most = opt->threads[k] > most ? opt->threads[k] : most;
+    }
+    if (c->prep != NULL) {
+        if (9 * size + 64 > opt->max_mem ||
+            (prepbuf = (char*)malloc(8 * size + 64)) == NULL) {
+            fprintf(stderr, "modp_bench: %s at %s skipped, not enough memory\n",
+                    c->name, format_size(sz, size));
+            return 0;
+        }
+        inlen = c->prep(prepbuf, raw, size);
+        if (inlen == (size_t)-1) {
+            fprintf(stderr, "modp_bench: %s at %s skipped, no valid input of this size\n",
+                    c->name, format_size(sz, size));
+            free(prepbuf);
+            return 0;
+        }
+        in = prepbuf;
+    }
+    outlen = c->mult * inlen + c->add + 16;
+    if ((outlen + inlen) * (most + 1) > opt->max_mem ||
+        (out = (char*)malloc(outlen)) == NULL) {
+        fprintf(stderr, "modp_bench: %s at %s skipped, not enough memory\n",
+                c->name, format_size(sz, size));
+        free(prepbuf);
+        return 0;
+    }
+    bytes = (c->flags & BENCH_FIXED) ? c->fn(out, in, inlen) : inlen;
+
+    calls = (double*)malloc(3 * (most + 1) * sizeof(double));
+    if (calls == NULL) {
+        free(out);
+        free(prepbuf);
+        return 0;
+    }
+    elapsed = calls + most + 1;
+    samples = elapsed + most + 1;
+
+    for (cr = 0; cr < (opt->corunner ? 2u : 1u); ++cr) {
+        for (k = 0; k < opt->nthreads; ++k) {
+            n = opt->threads[k];
+            if (bench_threads_run(c->fn, in, inlen, outlen, n, cr ? opt->corunner : 0,
+                                  opt->min_time_ns * (double)opt->reps,
+                                  calls, elapsed) != 0) {
+                fprintf(stderr, "modp_bench: %s at %s on %lu threads failed\n",
+                        c->name, format_size(sz, size), (unsigned long)n);
+                continue;
+            }
+            r = &rs[nr++];
+            memset(r, 0, sizeof(*r));
+            for (i = 0; i < BENCH_PERF_COUNT; ++i) {
+                r->perf[i] = -1.0;
+            }
+            total = 0.0;
+            for (i = 0; i < n; ++i) {
+                samples[i] = elapsed[i] / calls[i];
+                total += (double)bytes / samples[i];
+            }
+            r->name = c->name;
+            r->size = size;
+            r->bytes = bytes;
+            r->iters = (size_t)calls[0];
+            r->reps = n;
+            stats(r, samples, n);
+            r->spread = rel_range(samples, n);
+            r->gbps = bytes ? (double)bytes / r->median_ns : 0.0;
+            r->cpb = (opt->ghz > 0.0 && bytes) ?
+                r->median_ns * opt->ghz / (double)bytes : 0.0;
+            r->threads = n;
+            r->corunner = (int)cr;
+            r->total_gbps = total;
+            if (base == 0.0) {
+                base = r->gbps;
+            }
+            r->scaling = base > 0.0 ? r->gbps / base : 0.0;
+        }
+    }
+
+    free(calls);
+    free(out);
+    free(prepbuf);
+    return nr;
+}
+
+/* a / b, or -1 if either is not known */
+static double ratio(double a, double b)
+{
+    return (a < 0.0 || b <= 0.0) ? -1.0 : a / b;
+}
+
+/* the counter ratios: IPC, core cycles, branch and L1D misses per byte */
+static void perf_ratios(const struct bench_result* r, double v[4])
+{
+    double bytes = (double)r->bytes;
+    v[0] = ratio(r->perf[BENCH_PERF_INSTRUCTIONS], r->perf[BENCH_PERF_CYCLES]);
+    v[1] = ratio(r->perf[BENCH_PERF_CYCLES], bytes);
+    v[2] = ratio(r->perf[BENCH_PERF_BRANCH_MISSES], bytes);
+    v[3] = ratio(r->perf[BENCH_PERF_L1D_MISSES], bytes);
+}
+
+static const char* perf_names[4] = { "ipc", "cycles_pb", "brmiss_pb", "l1dmiss_pb" };
+
+static void print_header(const struct options* opt)
+{
+    if (opt->nthreads) {
+        printf("%-16s %-11s %6s %4s %7s %10s %7s %10s %8s\n",
+               "name", "data", "size", "thr", "corun", "GB/s/thr", "rsd",
+               "total GB/s", "scaling");
+        return;
+    }
+    if (opt->latency) {
+        printf("%-16s %-11s %6s %5s %10s %10s %10s %10s %8s\n",
+               "name", "data", "size", "cache", "p50 ns", "p99 ns", "p99.9 ns",
+               "min ns", "p50 cyc");
+        return;
+    }
+    printf("%-16s %-11s %6s %12s %12s %7s %8s %8s",
+           "name", "data", "size", "median ns", "min ns", "rsd", "GB/s", "cpb");
+    if (opt->perf) {
+        printf(" %6s %8s %9s %9s", "IPC", "cyc/B", "brmiss/B", "L1Dmiss/B");
+    }
+    printf("\n");
+}
+
+static void print_result(const struct options* opt, const struct bench_result* r)
+{
+    char sz[32];
+    char data[32];
+    double v[4];
+    int i;
+
+    if (r->corpus == NULL) {
+        strcpy(data, "-");
+    } else if (r->density < 0.0) {
+        sprintf(data, "%.10s", r->corpus);
+    } else {
+        sprintf(data, "%.10s %g%%", r->corpus, 100.0 * r->density);
+    }
+    if (r->threads) {
+        printf("%-16s %-11s %6s %4lu %7s %10.3f %6.2f%% %10.3f %8.3f\n",
+               r->name, data, r->size ? format_size(sz, r->size) : "-",
+               (unsigned long)r->threads, r->corunner ? "yes" : "no", r->gbps,
+               r->mean_ns > 0.0 ? 100.0 * r->stddev_ns / r->mean_ns : 0.0,
+               r->total_gbps, r->scaling);
+        fflush(stdout);
+        return;
+    }
+    if (r->cache != NULL) {
+        printf("%-16s %-11s %6s %5s %10.2f %10.2f %10.2f %10.2f %8.1f\n",
+               r->name, data, r->size ? format_size(sz, r->size) : "-", r->cache,
+               r->p50_ns, r->p99_ns, r->p999_ns, r->min_ns, r->p50_ns * opt->ghz);
+        fflush(stdout);
+        return;
+    }
+    printf("%-16s %-11s %6s %12.2f %12.2f %6.2f%% %8.3f %8.3f",
+           r->name, data, r->size ? format_size(sz, r->size) : "-",
+           r->median_ns, r->min_ns,
+           r->mean_ns > 0.0 ? 100.0 * r->stddev_ns / r->mean_ns : 0.0,
+           r->gbps, r->cpb);
+    if (opt->perf) {
+        perf_ratios(r, v);
+        for (i = 0; i < 4; ++i) {
+            if (v[i] < 0.0) {
+                printf(" %*s", i == 0 ? 6 : (i == 1 ? 8 : 9), "-");
+            } else {
+                printf(" %*.*f", i == 0 ? 6 : (i == 1 ? 8 : 9), i < 2 ? 2 : 4, v[i]);
+            }
+        }
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+static int write_json(const struct options* opt, const char* path)
+{
+    size_t i, j;
+    double v[4];
+    const struct bench_result* r;
+    FILE* f = fopen(path, "w");
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    fprintf(f, "{\n");
+    fprintf(f, "  \"benchmark\": \"modp_bench\",\n");
+    fprintf(f, "  \"version\": 1,\n");
+#ifdef __VERSION__
+    fprintf(f, "  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+    fprintf(f, "  \"ghz\": %.4f,\n", opt->ghz);
+    fprintf(f, "  \"reps\": %lu,\n", (unsigned long)opt->reps);
+    fprintf(f, "  \"min_time_ms\": %.3f,\n", opt->min_time_ns / 1e6);
+    fprintf(f, "  \"seed\": %lu,\n", (unsigned long)opt->seed);
+    fprintf(f, "  \"results\": [\n");
+    for (i = 0; i < nresults; ++i) {
+        r = &results[i];
+        fprintf(f, "    {\"name\": \"%s\", \"corpus\": \"%s\", \"density\": %.4f, "
+                "\"size\": %lu, \"bytes\": %lu, \"iters\": %lu, \"reps\": %lu, \"median_ns\": %.4f, "
+                "\"min_ns\": %.4f, \"mean_ns\": %.4f, \"stddev_ns\": %.4f, "
+                "\"spread\": %.4f, \"gbps\": %.4f, \"cpb\": %.4f",
+                r->name, r->corpus ? r->corpus : "none", r->density > 0.0 ? r->density : 0.0,
+                (unsigned long)r->size, (unsigned long)r->bytes,
+                (unsigned long)r->iters, (unsigned long)r->reps,
+                r->median_ns, r->min_ns, r->mean_ns, r->stddev_ns,
+                r->spread, r->gbps, r->cpb);
+        if (r->cache != NULL) {
+            fprintf(f, ", \"cache\": \"%s\", \"p50_ns\": %.4f, \"p99_ns\": %.4f, "
+                    "\"p999_ns\": %.4f", r->cache, r->p50_ns, r->p99_ns, r->p999_ns);
+        }
+        if (r->threads) {
+            fprintf(f, ", \"threads\": %lu, \"corunner\": %d, \"total_gbps\": %.4f, "
+                    "\"scaling\": %.4f", (unsigned long)r->threads, r->corunner,
+                    r->total_gbps, r->scaling);
+        }
+        if (opt->perf) {
+            perf_ratios(r, v);
+            for (j = 0; j < 4; ++j) {
+                if (v[j] < 0.0) {
+                    fprintf(f, ", \"%s\": null", perf_names[j]);
+                } else {
+                    fprintf(f, ", \"%s\": %.4f", perf_names[j], v[j]);
+                }
+            }
+        }
+        fprintf(f, "}%s\n", (i + 1 < nresults) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    return fclose(f);
+}
+
+static int write_csv(const struct options* opt, const char* path)
+{
+    size_t i, j;
+    double v[4];
+    const struct bench_result* r;
+    FILE* f = fopen(path, "w");
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    fprintf(f, "name,corpus,density,size,bytes,iters,reps,median_ns,min_ns,mean_ns,stddev_ns,gbps,cpb");
+    if (opt->latency) {
+        fprintf(f, ",cache,p50_ns,p99_ns,p999_ns");
+    }
+    if (opt->nthreads) {
+        fprintf(f, ",threads,corunner,total_gbps,scaling");
+    }
+    if (opt->perf) {
+        for (j = 0; j < 4; ++j) {
+            fprintf(f, ",%s", perf_names[j]);
+        }
+    }
+    fprintf(f, "\n");
+    for (i = 0; i < nresults; ++i) {
+        r = &results[i];
+        fprintf(f, "%s,%s,%.4f,%lu,%lu,%lu,%lu,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f",
+                r->name, r->corpus ? r->corpus : "none",
+                r->density > 0.0 ? r->density : 0.0, (unsigned long)r->size, (unsigned long)r->bytes,
+                (unsigned long)r->iters, (unsigned long)r->reps,
+                r->median_ns, r->min_ns, r->mean_ns, r->stddev_ns,
+                r->gbps, r->cpb);
+        if (opt->latency) {
+            fprintf(f, ",%s,%.4f,%.4f,%.4f",
+                    r->cache, r->p50_ns, r->p99_ns, r->p999_ns);
+        }
+        if (opt->nthreads) {
+            fprintf(f, ",%lu,%d,%.4f,%.4f", (unsigned long)r->threads,
+                    r->corunner, r->total_gbps, r->scaling);
+        }
+        if (opt->perf) {
+            perf_ratios(r, v);
+            for (j = 0; j < 4; ++j) {
+                if (v[j] < 0.0) {
+                    fprintf(f, ",");
+                } else {
+                    fprintf(f, ",%.4f", v[j]);
+                }
+            }
+        }
+        fprintf(f, "\n");
+    }
+    return fclose(f);
+}
+
+static void usage(void)
+{
+    printf("usage: modp_bench [options]\n"
+           "  --list             list the benchmarks and exit\n"
+           "  --filter=A,B       only benchmarks with a name containing A or B\n"
+           "  --sizes=1,64,4K    input sizes, K/M/G suffixes allowed\n"
+           "  --max-size=N       sizes up to N from the default sweep\n"
+           "  --reps=N           timed repetitions (default 9)\n"
+           "  --min-time=MS      minimum time of one repetition (default 10)\n"
+           "  --max-mem=N        skip sizes needing more memory (default 1G)\n"
+           "  --corpus=KIND      input for all benchmarks: az, binary, url,\n"
+           "                     json, utf8 or html (default: per benchmark)\n"
+           "  --density=0,0.1    escape densities of the text corpora (default 0.05)\n"
+           "  --seed=N           random seed of the input (default 1)\n"
+           "  --ghz=F            cycles per ns for cpb (default: TSC, x86 only)\n"
+           "  --json=FILE        write results as JSON\n"
+           "  --csv=FILE         write results as CSV\n"
+           "  --compare=FILE     compare with the results in FILE from --json,\n"
+           "                     exit 1 on a regression\n"
+           "  --threshold=PCT    smallest slowdown --compare counts (default 5)\n"
+           "  --perf             read hardware counters (Linux perf_event)\n"
+           "  --latency[=MODE]   time single calls, MODE is warm, cold or both\n"
+           "                     (default both), sizes default to 8,16,32,64\n"
+           "  --samples=N        calls per size for --latency (default 10000,\n"
+           "                     a tenth of that for cold)\n"
+           "  --evict=N          bytes walked before each cold call (default 8M)\n"
+           "  --threads[=1,2,4]  run on each number of threads at once (default\n"
+           "                     powers of 2 up to the cpus), sizes default to 1K,64K\n"
+           "  --corunner=N       bytes the cache polluting thread walks next to\n"
+           "                     --threads (default 64M, 0 for none)\n"
+           "  --quiet            no table on stdout\n");
+}
+
+static void default_sizes(struct options* opt, size_t max)
+{
+    size_t n;
+    opt->nsizes = 0;
+    opt->sizes[opt->nsizes++] = 1;
+    opt->sizes[opt->nsizes++] = 8;
+    for (n = 64; n <= max && opt->nsizes < MAX_SIZES; n *= 4) {
+        opt->sizes[opt->nsizes++] = n;
+    }
+    if (opt->sizes[opt->nsizes - 1] != max && max > 8 && opt->nsizes < MAX_SIZES) {
+        opt->sizes[opt->nsizes++] = max;
+    }
+}
+
+static int parse_args(struct options* opt, int argc, char* argv[])
+{
+    int i;
+    const char* a;
+    const char* p;
+    size_t j;
+
+    memset(opt, 0, sizeof(*opt));
+    opt->reps = 9;
+    opt->min_time_ns = 10e6;
+    opt->max_mem = (size_t)1 << 30;
+    opt->ghz = -1.0;
+    opt->corpus = -1;
+    opt->seed = 1;
+    opt->samples = 10000;
+    opt->evict = (size_t)8 << 20;
+    opt->corunner = (size_t)64 << 20;
+    opt->threshold = 0.05;
+    opt->densities[0] = 0.05;
+    opt->ndensities = 1;
+    default_sizes(opt, (size_t)64 << 20);
+
+    for (i = 1; i < argc; ++i) {
+        a = argv[i];
+        if (strcmp(a, "--list") == 0) {
+            for (j = 0; j < bench_codecs_count; ++j) {
+                printf("%s\n", bench_codecs[j].name);
+            }
+            exit(0);
+        } else if (strcmp(a, "--help") == 0 || strcmp(a, "-h") == 0) {
+            usage();
+            exit(0);
+        } else if (strcmp(a, "--perf") == 0) {
+            opt->perf = 1;
+        } else if (strcmp(a, "--quiet") == 0) {
+            opt->quiet = 1;
+        } else if (strncmp(a, "--filter=", 9) == 0) {
+            opt->filter = a + 9;
+        } else if (strncmp(a, "--sizes=", 8) == 0) {
+            opt->sizes_set = 1;
+            opt->nsizes = 0;
+            for (p = a + 8; *p && opt->nsizes < MAX_SIZES; ++p) {
+                opt->sizes[opt->nsizes++] = parse_size(p);
+                p = strchr(p, ',');
+                if (p == NULL) {
+                    break;
+                }
+            }
+        } else if (strcmp(a, "--latency") == 0 || strcmp(a, "--latency=both") == 0) {
+            opt->latency = LAT_WARM | LAT_COLD;
+        } else if (strcmp(a, "--latency=warm") == 0) {
+            opt->latency = LAT_WARM;
+        } else if (strcmp(a, "--latency=cold") == 0) {
+            opt->latency = LAT_COLD;
+        } else if (strcmp(a, "--threads") == 0) {
+            opt->nthreads = 0;
+            for (j = 1; j <= (size_t)bench_threads_cpus() && opt->nthreads < MAX_SIZES; j *= 2) {
+                opt->threads[opt->nthreads++] = j;
+            }
+            if (j / 2 != (size_t)bench_threads_cpus() && opt->nthreads < MAX_SIZES) {
+                opt->threads[opt->nthreads++] = (size_t)bench_threads_cpus();
+            }
+        } else if (strncmp(a, "--threads=", 10) == 0) {
+            opt->nthreads = 0;
+            for (p = a + 10; *p && opt->nthreads < MAX_SIZES; ++p) {
+                if (atoi(p) > 0) {
+                    opt->threads[opt->nthreads++] = (size_t)atoi(p);
+                }
+                p = strchr(p, ',');
+                if (p == NULL) {
+                    break;
+                }
+            }
+        } else if (strncmp(a, "--corunner=", 11) == 0) {
+            opt->corunner = parse_size(a + 11);
+        } else if (strncmp(a, "--samples=", 10) == 0) {
+            opt->samples = (size_t)atol(a + 10);
+        } else if (strncmp(a, "--evict=", 8) == 0) {
+            opt->evict = parse_size(a + 8);
+        } else if (strncmp(a, "--density=", 10) == 0) {
+            opt->ndensities = 0;
+            for (p = a + 10; *p && opt->ndensities < MAX_DENSITIES; ++p) {
+                opt->densities[opt->ndensities++] = atof(p);
+                p = strchr(p, ',');
+                if (p == NULL) {
+                    break;
+                }
+            }
+            if (opt->ndensities == 0) {
+                opt->densities[opt->ndensities++] = 0.0;
+            }
+        } else if (strncmp(a, "--corpus=", 9) == 0) {
+            opt->corpus = bench_corpus_find(a + 9);
+            if (opt->corpus < 0) {
+                fprintf(stderr, "modp_bench: unknown corpus %s\n", a + 9);
+                return -1;
+            }
+        } else if (strncmp(a, "--seed=", 7) == 0) {
+            opt->seed = (uint32_t)strtoul(a + 7, NULL, 10);
+        } else if (strncmp(a, "--max-size=", 11) == 0) {
+            opt->sizes_set = 1;
+            default_sizes(opt, parse_size(a + 11));
+        } else if (strncmp(a, "--reps=", 7) == 0) {
+            opt->reps = (size_t)atoi(a + 7);
+        } else if (strncmp(a, "--min-time=", 11) == 0) {
+            opt->min_time_ns = atof(a + 11) * 1e6;
+        } else if (strncmp(a, "--max-mem=", 10) == 0) {
+            opt->max_mem = parse_size(a + 10);
+        } else if (strncmp(a, "--ghz=", 6) == 0) {
+            opt->ghz = atof(a + 6);
+        } else if (strncmp(a, "--json=", 7) == 0) {
+            opt->json = a + 7;
+        } else if (strncmp(a, "--csv=", 6) == 0) {
+            opt->csv = a + 6;
+        } else if (strncmp(a, "--compare=", 10) == 0) {
+            opt->compare = a + 10;
+        } else if (strncmp(a, "--threshold=", 12) == 0) {
+            opt->threshold = atof(a + 12) / 100.0;
+        } else {
+            fprintf(stderr, "modp_bench: unknown option %s\n", a);
+            usage();
+            return -1;
+        }
+    }
+    if (opt->reps == 0) {
+        opt->reps = 1;
+    }
+    if (opt->samples == 0) {
+        opt->samples = 1;
+    }
+    if (opt->latency && !opt->sizes_set) {
+        opt->nsizes = 0;
+        for (j = 8; j <= 64; j *= 2) {
+            opt->sizes[opt->nsizes++] = j;
+        }
+    }
+    if (opt->nthreads && opt->latency) {
+        fprintf(stderr, "modp_bench: --threads and --latency can't be used together\n");
+        return -1;
+    }
+    if (opt->nthreads && !opt->sizes_set) {
+        opt->nsizes = 0;
+        opt->sizes[opt->nsizes++] = 1024;
+        opt->sizes[opt->nsizes++] = 64 * 1024;
+    }
+    for (j = 0; j < opt->nthreads; ++j) {
+        if (opt->threads[j] > (size_t)bench_threads_cpus()) {
+            fprintf(stderr, "modp_bench: %lu threads on %d cpus, the threads "
+                    "will take turns\n", (unsigned long)opt->threads[j],
+                    bench_threads_cpus());
+            break;
+        }
+    }
+    if (opt->nthreads && opt->perf) {
+        fprintf(stderr, "modp_bench: --perf is ignored with --threads\n");
+        opt->perf = 0;
+    }
+    if (opt->latency && opt->perf) {
+        fprintf(stderr, "modp_bench: --perf is ignored with --latency\n");
+        opt->perf = 0;
+    }
+    if (opt->ghz < 0.0) {
+        opt->ghz = tsc_ghz();
+    }
+    if (opt->perf && bench_perf_open() == 0) {
+        fprintf(stderr, "modp_bench: no hardware counters available "
+                "(see /proc/sys/kernel/perf_event_paranoid), continuing without\n");
+        opt->perf = 0;
+    }
+    return 0;
+}
+
+/* does density change the data of a corpus */
+static int has_density(int kind)
+{
+    return kind != BENCH_CORPUS_AZ && kind != BENCH_CORPUS_BINARY;
+}
+
+int main(int argc, char* argv[])
+{
+    struct options opt;
+    const struct bench_codec* c;
+    struct bench_result r;
+    const char* skip;
+    size_t i, j, k, nd, nl, maxsize = 1;
+    double ticks_ns = 1.0;
+    char* raw;
+    char sz[32];
+    int kind, raw_kind = -1;
+    double density, raw_density = -1.0;
+    int rc = 0;
+
+    if (parse_args(&opt, argc, argv) != 0) {
+        return 2;
+    }
+
+    for (j = 0; j < opt.nsizes; ++j) {
+        if (opt.sizes[j] > maxsize) {
+            maxsize = opt.sizes[j];
+        }
+    }
+    if (opt.latency) {
+        /* room for the pool to be different slices */
+        maxsize = maxsize < 65536 ? 65536 : maxsize;
+#ifdef HAVE_RDTSC
+        ticks_ns = tsc_ghz();
+#endif
+    }
+    raw = (char*)malloc(maxsize);
+    results = (struct bench_result*)malloc(
+        (bench_codecs_count * opt.nsizes * opt.ndensities * 2 *
+         (opt.nthreads ? opt.nthreads : 1) + 1) * sizeof(struct bench_result));
+    if (raw == NULL || results == NULL) {
+        fprintf(stderr, "modp_bench: out of memory\n");
+        return 2;
+    }
+
+    if (!opt.quiet) {
+        if (opt.ghz > 0.0) {
+            printf("# cpb at %.3f GHz\n", opt.ghz);
+        }
+        print_header(&opt);
+    }
+    for (i = 0; i < bench_codecs_count; ++i) {
+        c = &bench_codecs[i];
+        if (!match_filter(opt.filter, c->name)) {
+            continue;
+        }
+        kind = (opt.corpus >= 0) ? opt.corpus : c->corpus;
+        nd = (has_density(kind) && !(c->flags & BENCH_FIXED)) ? opt.ndensities : 1;
+        for (k = 0; k < nd; ++k) {
+            density = has_density(kind) ? opt.densities[k] : -1.0;
+            if (!(c->flags & BENCH_FIXED) &&
+                (kind != raw_kind || density != raw_density)) {
+                bench_corpus(raw, maxsize, kind, density, opt.seed);
+                raw_kind = kind;
+                raw_density = density;
+            }
+            for (j = 0; opt.latency && j < 2; ++j) {
+                if (opt.latency & (j ? LAT_COLD : LAT_WARM)) {
+                    nl = run_latency(&opt, c, raw, maxsize, (int)j, ticks_ns, results + nresults);
+                    for (; nl > 0; --nl, ++nresults) {
+                        if (!(c->flags & BENCH_FIXED)) {
+                            results[nresults].corpus = bench_corpus_names[kind];
+                            results[nresults].density = density;
+                        }
+                        if (!opt.quiet) {
+                            print_result(&opt, &results[nresults]);
+                        }
+                    }
+                }
+            }
+            for (j = 0; opt.nthreads && j < opt.nsizes; ++j) {
+                nl = run_threads(&opt, c, raw, (c->flags & BENCH_FIXED) ? 0 : opt.sizes[j],
+                                 results + nresults);
+                for (; nl > 0; --nl, ++nresults) {
+                    if (!(c->flags & BENCH_FIXED)) {
+                        results[nresults].corpus = bench_corpus_names[kind];
+                        results[nresults].density = density;
+                    }
+                    if (!opt.quiet) {
+                        print_result(&opt, &results[nresults]);
+                    }
+                }
+                if (c->flags & BENCH_FIXED) {
+                    break;
+                }
+            }
+            for (j = 0; !opt.latency && !opt.nthreads && j < opt.nsizes; ++j) {
+                skip = run_one(&opt, c, raw, (c->flags & BENCH_FIXED) ? 0 : opt.sizes[j], &r);
+                if (skip != NULL) {
+                    fprintf(stderr, "modp_bench: %s at %s skipped, %s\n",
+                            c->name, format_size(sz, opt.sizes[j]), skip);
+                    continue;
+                }
+                if (!(c->flags & BENCH_FIXED)) {
+                    r.corpus = bench_corpus_names[kind];
+                    r.density = density;
+                }
+                results[nresults++] = r;
+                if (!opt.quiet) {
+                    print_result(&opt, &r);
+                }
+                if (c->flags & BENCH_FIXED) {
+                    break;
+                }
+            }
+        }
+    }
+
+    if (opt.json != NULL && write_json(&opt, opt.json) != 0) {
+        rc = 1;
+    }
+    if (opt.csv != NULL && write_csv(&opt, opt.csv) != 0) {
+        rc = 1;
+    }
+    if (opt.compare != NULL) {
+        nl = (size_t)bench_compare(opt.compare, results, nresults, opt.threshold, opt.quiet);
+        if (nl == (size_t)-1) {
+            rc = 2;
+        } else if (nl > 0) {
+            fprintf(stderr, "modp_bench: %lu regressions against %s\n",
+                    (unsigned long)nl, opt.compare);
+            rc = 1;
+        }
+    }
+    bench_perf_close();
+    free(results);
+    free(raw);
+    return rc;
+}
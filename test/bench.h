@@ -0,0 +1,159 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/** \file bench.h
+ *
+ * Copyright 2026, Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ *
+ * Shared by the benchmark driver (bench.c) and the list of
+ * benchmarks (bench_codecs.c).  This does NOT test correctness.
+ */
+
+#ifndef MODP_BENCH_H
+#define MODP_BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * The call being timed.  Same as the codecs: write the output of len
+ * bytes of src to dest and return the output length.
+ */
+typedef size_t (*bench_fn)(char* dest, const char* src, size_t len);
+
+/**
+ * Run once, not in the size sweep.  fn ignores src and len, and the
+ * throughput is of the output bytes.
+ */
+#define BENCH_FIXED 1
+
+/* input data kinds, see bench_corpus.c */
+#define BENCH_CORPUS_AZ      0
+#define BENCH_CORPUS_BINARY  1
+#define BENCH_CORPUS_URL     2
+#define BENCH_CORPUS_JSON    3
+#define BENCH_CORPUS_UTF8    4
+#define BENCH_CORPUS_HTML    5
+#define BENCH_CORPUS_COUNT   6
+
+extern const char* const bench_corpus_names[BENCH_CORPUS_COUNT];
+
+/** the BENCH_CORPUS_ value for a name, or -1 */
+int bench_corpus_find(const char* name);
+
+/**
+ * Fill buf with len bytes of kind, with density (0 to 1) of the
+ * characters needing an escape
+ */
+void bench_corpus(char* buf, size_t len, int kind, double density, uint32_t seed);
+
+/**
+ * One benchmark
+ */
+struct bench_codec {
+    /** name used in reports and by --filter, e.g. "b64_encode" */
+    const char* name;
+
+    /** the call to time */
+    bench_fn fn;
+
+    /**
+     * Makes the input from the raw data, e.g. the encoder for a
+     * decoder.  NULL to use the raw data as-is.
+     */
+    bench_fn prep;
+
+    /** output bytes needed for len input bytes: mult * len + add */
+    size_t mult;
+    size_t add;
+
+    /** BENCH_FIXED or 0 */
+    int flags;
+
+    /** the BENCH_CORPUS_ of the raw data, unless --corpus is given */
+    int corpus;
+};
+
+extern const struct bench_codec bench_codecs[];
+extern const size_t bench_codecs_count;
+
+/* hardware counters for --perf, see bench_perf.c */
+#define BENCH_PERF_CYCLES        0
+#define BENCH_PERF_INSTRUCTIONS  1
+#define BENCH_PERF_BRANCH_MISSES 2
+#define BENCH_PERF_L1D_MISSES    3
+#define BENCH_PERF_COUNT         4
+
+/** open the counters, returns how many could be opened */
+int bench_perf_open(void);
+
+/** reset and start counting */
+void bench_perf_start(void);
+
+/** stop counting and read the totals, -1 for a counter not available */
+void bench_perf_stop(double counts[BENCH_PERF_COUNT]);
+
+void bench_perf_close(void);
+
+/* threads for --threads, see bench_threads.c */
+
+/**
+ * Call fn on in for ns on each of nthreads threads, each with its own
+ * copy of the input and output, while another thread walks corunner
+ * bytes of memory (0 for no co-runner).  The calls each thread made
+ * and its ns go in calls[] and elapsed[].  Returns 0, or -1 without
+ * threads or memory.
+ */
+int bench_threads_run(bench_fn fn, const char* in, size_t inlen, size_t outlen,
+                      size_t nthreads, size_t corunner, double ns,
+                      double* calls, double* elapsed);
+
+/** online cpus */
+int bench_threads_cpus(void);
+
+/**
+ * Timing statistics for one benchmark at one size.  With --latency
+ * the samples are single calls, iters is 1 and reps the call count,
+ * and spread is of the medians of --reps runs of consecutive calls.
+ */
+struct bench_result {
+    const char* name;
+    size_t size;          /* raw data size */
+    const char* corpus;   /* raw data kind */
+    double density;       /* escape density of the raw data */
+    size_t bytes;         /* input bytes per call */
+    size_t iters;         /* calls per repetition */
+    size_t reps;
+    double median_ns;     /* per call */
+    double min_ns;
+    double mean_ns;
+    double stddev_ns;
+    double spread;        /* (max - min) / median of the repetitions */
+    double gbps;          /* bytes / median, GB/s */
+    double cpb;           /* cycles per byte, 0 if unknown */
+    double perf[BENCH_PERF_COUNT];  /* per call, -1 if not counted */
+    const char* cache;    /* --latency: "warm" or "cold", else NULL */
+    double p50_ns;        /* --latency percentiles of single calls */
+    double p99_ns;
+    double p999_ns;
+    size_t threads;       /* --threads: threads running, else 0 */
+    int corunner;         /* --threads: 1 with the cache polluter */
+    double total_gbps;    /* --threads: all threads */
+    double scaling;       /* --threads: per thread GB/s vs one thread alone */
+};
+
+/**
+ * Compare n results with the baseline in path, a --json file.  Prints
+ * the comparison (only regressions if quiet) and returns the number of
+ * regressions, or -1 if the baseline can't be read.  threshold is the
+ * smallest slowdown that counts, e.g. 0.05.  See bench_compare.c.
+ */
+int bench_compare(const char* path, const struct bench_result* results, size_t n,
+                  double threshold, int quiet);
+
+#endif
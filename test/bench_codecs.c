@@ -0,0 +1,337 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/** \file bench_codecs.c
+ *
+ * Copyright 2026, Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ *
+ * The list of benchmarks run by modp_bench.  To add one, write a
+ * wrapper with the bench_fn signature if the function doesn't have
+ * it already, and add a line to bench_codecs[].
+ */
+
+/* we compile as C90 but use snprintf */
+#define _ISOC99_SOURCE
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bench.h"
+
+#include "modp_b2.h"
+#include "modp_b16.h"
+#include "modp_b64.h"
+#include "modp_b64w.h"
+#include "modp_b64r.h"
+#include "modp_b85.h"
+#include "modp_burl.h"
+#include "modp_bjavascript.h"
+#include "modp_ascii.h"
+#include "modp_xml.h"
+#include "modp_utf8.h"
+#include "modp_json.h"
+#include "modp_messagepack.h"
+#include "modp_numtoa.h"
+#include "modp_qp.h"
+#include "modp_encword.h"
+#include "modp_fuse.h"
+#include "modp_iov.h"
+#include "apr_base64.h"
+
+/* wrappers for functions without the bench_fn signature */
+
+static size_t apr_encode(char* dest, const char* src, size_t len)
+{
+    return (size_t)apr_base64_encode_binary(dest, (const unsigned char*)src, (int)len);
+}
+
+/* apr decodes up to the null, the input from prep has one */
+static size_t apr_decode(char* dest, const char* src, size_t len)
+{
+    (void)len;
+    return (size_t)apr_base64_decode_binary((unsigned char*)dest, src);
+}
+
+static size_t js_uencode(char* dest, const char* src, size_t len)
+{
+    return modp_bjavascript_uencode(dest, src, len, MODP_JS_ESCAPE_HTML);
+}
+
+static size_t toupper_copy(char* dest, const char* src, size_t len)
+{
+    modp_toupper_copy(dest, src, len);
+    return len;
+}
+
+static size_t tolower_copy(char* dest, const char* src, size_t len)
+{
+    modp_tolower_copy(dest, src, len);
+    return len;
+}
+
+static size_t toprint_copy(char* dest, const char* src, size_t len)
+{
+    modp_toprint_copy(dest, src, len);
+    return len;
+}
+
+/* the standard C library, for comparison */
+static size_t ctype_toupper_copy(char* dest, const char* src, size_t len)
+{
+    size_t i;
+    for (i = 0; i < len; ++i) {
+        dest[i] = (char)toupper((unsigned char)src[i]);
+    }
+    dest[len] = '\0';
+    return len;
+}
+
+static size_t utf8_validate(char* dest, const char* src, size_t len)
+{
+    (void)dest;
+    return (size_t)modp_utf8_validate(src, len);
+}
+
+static size_t json_string(char* dest, const char* src, size_t len)
+{
+    modp_json_ctx ctx;
+    modp_json_init(&ctx, dest);
+    modp_json_add_string(&ctx, src, len);
+    return modp_json_end(&ctx);
+}
+
+static size_t msgpk_string(char* dest, const char* src, size_t len)
+{
+    modp_msgpk_ctx ctx;
+    modp_msgpk_init(&ctx, dest);
+    modp_msgpk_add_string(&ctx, src, len);
+    return modp_msgpk_end(&ctx);
+}
+
+/* a form field to XML, fused and as three calls */
+#define URL_XML (MODP_FUSE_BURL_DECODE | MODP_FUSE_UTF8_VALIDATE | MODP_FUSE_XML_ENCODE)
+
+static size_t url_xml_fused(char* dest, const char* src, size_t len)
+{
+    return modp_fuse(dest, src, len, URL_XML);
+}
+
+/* the decoded text goes past the end of the XML, mult is 7 */
+static size_t url_xml_3pass(char* dest, const char* src, size_t len)
+{
+    char* mid = dest + 6 * len + 3;
+    size_t n = modp_burl_decode(mid, src, len);
+    if (modp_utf8_validate(mid, n) != MODP_UTF8_OK) {
+        return (size_t)-1;
+    }
+    return modp_xml_encode(dest, mid, n);
+}
+
+/*
+ * src as a chain of 4K buffers, base64 into another chain, coded in
+ * place and copied to one buffer first
+ */
+#define IOV_MAX_BUFS 16384
+
+static int iov_split(struct iovec* iov, char* s, size_t len)
+{
+    size_t piece = 4096;
+    int n = 0;
+
+    if (len > piece * IOV_MAX_BUFS) {
+        piece = len / IOV_MAX_BUFS + 1;
+    }
+    while (len > 0) {
+        iov[n].iov_base = s;
+        iov[n].iov_len = (len < piece) ? len : piece;
+        s += iov[n].iov_len;
+        len -= iov[n].iov_len;
+        n += 1;
+    }
+    return n;
+}
+
+static size_t b64_encode_iov(char* dest, const char* src, size_t len)
+{
+    static struct iovec in[IOV_MAX_BUFS];
+    static struct iovec out[IOV_MAX_BUFS];
+    int incnt = iov_split(in, (char*)(size_t)src, len);
+    int outcnt = iov_split(out, dest, modp_b64_encode_len(len));
+    return modp_iov_code(&modp_pipeline_b64_encode, out, &outcnt, in, incnt);
+}
+
+/* the copy goes past the end of the output, mult is 3 */
+static size_t b64_encode_copy(char* dest, const char* src, size_t len)
+{
+    static struct iovec in[IOV_MAX_BUFS];
+    char* mid = dest + 2 * len + 8;
+    int incnt = iov_split(in, (char*)(size_t)src, len);
+    size_t n = 0;
+    int i;
+
+    for (i = 0; i < incnt; ++i) {
+        memcpy(mid + n, in[i].iov_base, in[i].iov_len);
+        n += in[i].iov_len;
+    }
+    return modp_b64_encode(dest, mid, n);
+}
+
+/* fixed size benchmarks, these ignore src */
+
+static size_t json_doc(char* dest, const char* src, size_t len)
+{
+    modp_json_ctx ctx;
+    (void)src;
+    (void)len;
+    modp_json_init(&ctx, dest);
+    modp_json_map_open(&ctx);
+    modp_json_add_cstring(&ctx, "start_ms");
+    modp_json_add_uint32(&ctx, 123456789);
+    modp_json_add_cstring(&ctx, "remote_ip");
+    modp_json_add_cstring(&ctx, "123.123.123.13");
+    modp_json_add_cstring(&ctx, "request");
+    modp_json_add_cstring(&ctx, "GET /foobar HTTP/1.1");
+    modp_json_add_cstring(&ctx, "headers_in");
+    modp_json_ary_open(&ctx);
+    modp_json_ary_open(&ctx);
+    modp_json_add_cstring(&ctx, "Accept");
+    modp_json_add_cstring(&ctx, "*/*");
+    modp_json_ary_close(&ctx);
+    modp_json_ary_open(&ctx);
+    modp_json_add_cstring(&ctx, "User-agent");
+    modp_json_add_cstring(&ctx, "Mozilla/5.0 (iPad; U; CPU OS 3_2_1 like Mac OS X; en-us) AppleWebKit/531.21.10 (KHTML, like Gecko) Mobile/7B405");
+    modp_json_ary_close(&ctx);
+    modp_json_ary_close(&ctx);
+    modp_json_map_close(&ctx);
+    return modp_json_end(&ctx);
+}
+
+static size_t msgpk_doc(char* dest, const char* src, size_t len)
+{
+    modp_msgpk_ctx ctx;
+    (void)src;
+    (void)len;
+    modp_msgpk_init(&ctx, dest);
+    modp_msgpk_map_open(&ctx, (size_t)4);
+    modp_msgpk_add_cstring(&ctx, "start_ms");
+    modp_msgpk_add_uint32(&ctx, (uint32_t)123456789);
+    modp_msgpk_add_cstring(&ctx, "remote_ip");
+    modp_msgpk_add_cstring(&ctx, "123.123.123.13");
+    modp_msgpk_add_cstring(&ctx, "request");
+    modp_msgpk_add_cstring(&ctx, "GET /foobar HTTP/1.1");
+    modp_msgpk_add_cstring(&ctx, "headers_in");
+    modp_msgpk_ary_open(&ctx, (size_t)2);
+    modp_msgpk_ary_open(&ctx, (size_t)2);
+    modp_msgpk_add_cstring(&ctx, "Accept");
+    modp_msgpk_add_cstring(&ctx, "*/*");
+    modp_msgpk_ary_open(&ctx, (size_t)2);
+    modp_msgpk_add_cstring(&ctx, "User-agent");
+    modp_msgpk_add_cstring(&ctx, "Mozilla/5.0 (iPad; U; CPU OS 3_2_1 like Mac OS X; en-us) AppleWebKit/531.21.10 (KHTML, like Gecko) Mobile/7B405");
+    return modp_msgpk_end(&ctx);
+}
+
+static const double dvalues[16] = {
+    0.0, 1.0, -1.5, 3.14159265, 1e-5, 123456.789, -987654321.0, 0.1,
+    2.5e8, 42.0, -0.000123, 65535.0, 1.0 / 3.0, 7.77, 1e9, -2.0e-3
+};
+
+static size_t dtoa_16(char* dest, const char* src, size_t len)
+{
+    size_t i, n = 0;
+    (void)src;
+    (void)len;
+    for (i = 0; i < 16; ++i) {
+        n += modp_dtoa2(dvalues[i], dest + n, 6);
+    }
+    return n;
+}
+
+static size_t sprintf_dtoa_16(char* dest, const char* src, size_t len)
+{
+    size_t i, n = 0;
+    (void)src;
+    (void)len;
+    for (i = 0; i < 16; ++i) {
+        n += (size_t)snprintf(dest + n, 32, "%.6g", dvalues[i]);
+    }
+    return n;
+}
+
+static size_t uitoa_16(char* dest, const char* src, size_t len)
+{
+    size_t i, n = 0;
+    (void)src;
+    (void)len;
+    for (i = 0; i < 16; ++i) {
+        n += modp_uitoa10((uint32_t)(i * 2654435761u), dest + n);
+    }
+    return n;
+}
+
+static size_t sprintf_u_16(char* dest, const char* src, size_t len)
+{
+    size_t i, n = 0;
+    (void)src;
+    (void)len;
+    for (i = 0; i < 16; ++i) {
+        n += (size_t)snprintf(dest + n, 16, "%u", (unsigned)(i * 2654435761u));
+    }
+    return n;
+}
+
+const struct bench_codec bench_codecs[] = {
+    /* name              fn                      prep                  mult add flags corpus */
+    { "b2_encode",       modp_b2_encode,         NULL,                 8, 1, 0, BENCH_CORPUS_BINARY },
+    { "b2_decode",       modp_b2_decode,         modp_b2_encode,       1, 1, 0, BENCH_CORPUS_BINARY },
+    { "b16_encode",      modp_b16_encode,        NULL,                 2, 1, 0, BENCH_CORPUS_BINARY },
+    { "b16_decode",      modp_b16_decode,        modp_b16_encode,      1, 1, 0, BENCH_CORPUS_BINARY },
+    { "b64_encode",      modp_b64_encode,        NULL,                 2, 4, 0, BENCH_CORPUS_BINARY },
+    { "b64_encode_iov",  b64_encode_iov,         NULL,                 2, 4, 0, BENCH_CORPUS_BINARY },
+    { "b64_encode_copy", b64_encode_copy,        NULL,                 3, 8, 0, BENCH_CORPUS_BINARY },
+    { "b64_decode",      modp_b64_decode,        modp_b64_encode,      1, 2, 0, BENCH_CORPUS_BINARY },
+    { "apr_b64_encode",  apr_encode,             NULL,                 2, 4, 0, BENCH_CORPUS_BINARY },
+    { "apr_b64_decode",  apr_decode,             modp_b64_encode,      1, 2, 0, BENCH_CORPUS_BINARY },
+    { "b64w_encode",     modp_b64w_encode,       NULL,                 2, 4, 0, BENCH_CORPUS_BINARY },
+    { "b64w_decode",     modp_b64w_decode,       modp_b64w_encode,     1, 2, 0, BENCH_CORPUS_BINARY },
+    { "b64r_encode",     modp_b64r_encode,       NULL,                 2, 4, 0, BENCH_CORPUS_BINARY },
+    { "b64r_decode",     modp_b64r_decode,       modp_b64r_encode,     1, 2, 0, BENCH_CORPUS_BINARY },
+    { "b85_encode",      modp_b85_encode,        NULL,                 2, 5, 0, BENCH_CORPUS_BINARY },
+    { "b85_decode",      modp_b85_decode,        modp_b85_encode,      1, 4, 0, BENCH_CORPUS_BINARY },
+    { "burl_encode",     modp_burl_encode,       NULL,                 3, 1, 0, BENCH_CORPUS_URL },
+    { "burl_min_encode", modp_burl_min_encode,   NULL,                 3, 1, 0, BENCH_CORPUS_URL },
+    { "burl_decode",     modp_burl_decode,       modp_burl_encode,     1, 1, 0, BENCH_CORPUS_URL },
+    { "js_encode",       modp_bjavascript_encode, NULL,                4, 1, 0, BENCH_CORPUS_JSON },
+    { "js_uencode",      js_uencode,             NULL,                 6, 1, 0, BENCH_CORPUS_JSON },
+    { "js_decode",       modp_bjavascript_decode, modp_bjavascript_encode, 1, 1, 0, BENCH_CORPUS_JSON },
+    { "xml_encode",      modp_xml_encode,        NULL,                 6, 1, 0, BENCH_CORPUS_HTML },
+    { "xml_decode",      modp_xml_decode,        modp_xml_encode,      1, 1, 0, BENCH_CORPUS_HTML },
+    { "json_string",     json_string,            NULL,                 6, 3, 0, BENCH_CORPUS_JSON },
+    { "url_xml_fused",   url_xml_fused,          modp_burl_encode,     6, 3, 0, BENCH_CORPUS_UTF8 },
+    { "url_xml_3pass",   url_xml_3pass,          modp_burl_encode,     7, 4, 0, BENCH_CORPUS_UTF8 },
+    { "msgpk_string",    msgpk_string,           NULL,                 1, 6, 0, BENCH_CORPUS_UTF8 },
+    { "qp_encode",       modp_qp_encode,         NULL,                 4, 4, 0, BENCH_CORPUS_UTF8 },
+    { "qp_decode",       modp_qp_decode,         modp_qp_encode,       1, 1, 0, BENCH_CORPUS_UTF8 },
+    { "encword_encode",  modp_encword_encode,    NULL,                 2, 32, 0, BENCH_CORPUS_UTF8 },
+    { "encword_decode",  modp_encword_decode,    modp_encword_encode,  1, 1, 0, BENCH_CORPUS_UTF8 },
+    { "utf8_validate",   utf8_validate,          NULL,                 0, 1, 0, BENCH_CORPUS_UTF8 },
+    { "toupper_copy",    toupper_copy,           NULL,                 1, 1, 0, BENCH_CORPUS_UTF8 },
+    { "ctype_toupper",   ctype_toupper_copy,     NULL,                 1, 1, 0, BENCH_CORPUS_UTF8 },
+    { "tolower_copy",    tolower_copy,           NULL,                 1, 1, 0, BENCH_CORPUS_UTF8 },
+    { "toprint_copy",    toprint_copy,           NULL,                 1, 1, 0, BENCH_CORPUS_UTF8 },
+
+    /* fixed size */
+    { "json_doc",        json_doc,               NULL,                 0, 512, BENCH_FIXED, BENCH_CORPUS_AZ },
+    { "msgpk_doc",       msgpk_doc,              NULL,                 0, 512, BENCH_FIXED, BENCH_CORPUS_AZ },
+    { "dtoa_16",         dtoa_16,                NULL,                 0, 512, BENCH_FIXED, BENCH_CORPUS_AZ },
+    { "sprintf_dtoa_16", sprintf_dtoa_16,        NULL,                 0, 512, BENCH_FIXED, BENCH_CORPUS_AZ },
+    { "uitoa_16",        uitoa_16,               NULL,                 0, 256, BENCH_FIXED, BENCH_CORPUS_AZ },
+    { "sprintf_u_16",    sprintf_u_16,           NULL,                 0, 256, BENCH_FIXED, BENCH_CORPUS_AZ }
+};
+
+const size_t bench_codecs_count = sizeof(bench_codecs) / sizeof(bench_codecs[0]);
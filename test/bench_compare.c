@@ -0,0 +1,203 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/** \file bench_compare.c
+ *
+ * Copyright 2026, Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ *
+ * modp_bench --compare, checks the results of this run against a
+ * baseline written by an earlier --json.  Results are matched on name,
+ * corpus, density and size (and the cache state or thread count of
+ * --latency and --threads runs), and only the medians are compared.
+ *
+ * A result is a regression when its median is slower than the
+ * baseline's by more than the allowed change, which is --threshold or
+ * the spreads of the two runs added, whichever is larger.  The spread
+ * is how far apart the fastest and slowest repetitions of a run were,
+ * relative to the median, and for --latency the repetitions are --reps
+ * runs of consecutive calls, not the single calls.  A change bigger
+ * than both spreads means every repetition of this run was slower than
+ * every repetition of the baseline.  The standard error of the mean
+ * would not do, it shrinks with the number of samples but two runs
+ * differ by more than that.
+ *
+ * This only reads the JSON that write_json in bench.c writes, one
+ * result per line, it is not a general JSON parser.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+struct baseline {
+    char key[192];
+    double median_ns;
+    double spread;
+};
+
+/* the value after "key": in line, or NULL */
+static const char* field(const char* line, const char* key)
+{
+    char pat[64];
+    const char* p;
+
+    sprintf(pat, "\"%.50s\": ", key);
+    p = strstr(line, pat);
+    return p ? p + strlen(pat) : NULL;
+}
+
+static double number(const char* line, const char* key, double dflt)
+{
+    const char* p = field(line, key);
+    return (p && *p != 'n') ? strtod(p, NULL) : dflt;
+}
+
+/* a string value into buf of len bytes, dflt if missing */
+static void string(const char* line, const char* key, char* buf, size_t len,
+                   const char* dflt)
+{
+    const char* p = field(line, key);
+    size_t n = 0;
+
+    if (p == NULL || *p != '"') {
+        strncpy(buf, dflt, len - 1);
+        buf[len - 1] = '\0';
+        return;
+    }
+    for (++p; *p && *p != '"' && n + 1 < len; ++p) {
+        buf[n++] = *p;
+    }
+    buf[n] = '\0';
+}
+
+/* the cache or thread variant of a result, "-" for plain throughput */
+static void variant(char* buf, const char* cache, unsigned long threads, int corunner)
+{
+    if (threads) {
+        sprintf(buf, "%luthr%s", threads, corunner ? "+co" : "");
+    } else {
+        sprintf(buf, "%.8s", cache ? cache : "-");
+    }
+}
+
+static void make_key(char* buf, const char* name, const char* corpus, double density,
+                     unsigned long size, const char* var)
+{
+    sprintf(buf, "%.64s|%.16s|%.4f|%lu|%.16s", name, corpus, density, size, var);
+}
+
+static struct baseline* load(const char* path, size_t* count)
+{
+    FILE* f = fopen(path, "r");
+    struct baseline* b = NULL;
+    struct baseline* nb;
+    size_t n = 0, cap = 0;
+    char line[4096];
+    char name[65], corpus[17], cache[17], var[32];
+
+    if (f == NULL) {
+        perror(path);
+        return NULL;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (field(line, "name") == NULL || field(line, "median_ns") == NULL) {
+            continue;
+        }
+        if (n == cap) {
+            cap = cap ? 2 * cap : 64;
+            nb = (struct baseline*)realloc(b, cap * sizeof(struct baseline));
+            if (nb == NULL) {
+                break;
+            }
+            b = nb;
+        }
+        string(line, "name", name, sizeof(name), "");
+        string(line, "corpus", corpus, sizeof(corpus), "none");
+        string(line, "cache", cache, sizeof(cache), "-");
+        variant(var, cache, (unsigned long)number(line, "threads", 0.0),
+                (int)number(line, "corunner", 0.0));
+        make_key(b[n].key, name, corpus, number(line, "density", 0.0),
+                 (unsigned long)number(line, "size", 0.0), var);
+        b[n].median_ns = number(line, "median_ns", 0.0);
+        b[n].spread = number(line, "spread", 0.0);
+        ++n;
+    }
+    fclose(f);
+    if (n == 0) {
+        fprintf(stderr, "modp_bench: no results in %s\n", path);
+        free(b);
+        return NULL;
+    }
+    *count = n;
+    return b;
+}
+
+int bench_compare(const char* path, const struct bench_result* results, size_t n,
+                  double threshold, int quiet)
+{
+    struct baseline* b;
+    size_t nb = 0, i, j;
+    int regressions = 0, compared = 0, missing = 0;
+    char key[192], var[32], data[32];
+    double change, tol, spread;
+    const char* status;
+    const struct bench_result* r;
+
+    b = load(path, &nb);
+    if (b == NULL) {
+        return -1;
+    }
+    if (!quiet) {
+        printf("# compared with %s\n", path);
+        printf("%-16s %-11s %6s %-8s %12s %12s %8s %7s  %s\n",
+               "name", "data", "size", "variant", "base ns", "ns", "change",
+               "allowed", "status");
+    }
+    for (i = 0; i < n; ++i) {
+        r = &results[i];
+        variant(var, r->cache, (unsigned long)r->threads, r->corunner);
+        make_key(key, r->name, r->corpus ? r->corpus : "none",
+                 r->density > 0.0 ? r->density : 0.0, (unsigned long)r->size, var);
+        for (j = 0; j < nb && strcmp(b[j].key, key) != 0; ++j) {
+        }
+        if (j == nb || b[j].median_ns <= 0.0) {
+            ++missing;
+            continue;
+        }
+        ++compared;
+        change = r->median_ns / b[j].median_ns - 1.0;
+        spread = b[j].spread + r->spread;
+        tol = (spread > threshold) ? spread : threshold;
+        if (change > tol) {
+            status = "REGRESSION";
+            ++regressions;
+        } else if (change < -tol) {
+            status = "faster";
+        } else {
+            status = "ok";
+        }
+        if (!quiet || change > tol) {
+            if (r->corpus == NULL) {
+                strcpy(data, "-");
+            } else if (r->density < 0.0) {
+                sprintf(data, "%.10s", r->corpus);
+            } else {
+                sprintf(data, "%.10s %g%%", r->corpus, 100.0 * r->density);
+            }
+            printf("%-16s %-11s %6lu %-8s %12.2f %12.2f %+7.1f%% %6.1f%%  %s\n",
+                   r->name, data, (unsigned long)r->size, var, b[j].median_ns,
+                   r->median_ns, 100.0 * change, 100.0 * tol, status);
+        }
+    }
+    printf("# %d compared, %d regressions, %d not in the baseline\n",
+           compared, regressions, missing);
+    free(b);
+    return regressions;
+}
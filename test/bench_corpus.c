@@ -0,0 +1,160 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/** \file bench_corpus.c
+ *
+ * Copyright 2026, Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ *
+ * Input data for modp_bench.  Generated rather than checked in, and
+ * deterministic for a given seed, so runs on different machines see
+ * the same bytes.
+ *
+ * For the text corpora, density is the fraction of characters that
+ * the matching encoder has to escape (or, for utf8, the fraction of
+ * code points that are not ascii).  The escapes are spread at random
+ * so the branch predictor can't learn a pattern:
+ *
+ *   az      'A' + i % 26, the old speedtest data, no escapes
+ *   binary  random bytes, density is ignored
+ *   url     url-safe words, escapes are ' ', '&', '=', '?', '/', ...
+ *   json    printable text, escapes are '"', '\\', '\n', '\t', ...
+ *   utf8    ascii text with 2, 3 and 4 byte UTF-8 code points
+ *   html    text with '&', '<', '>', '"' and '\''
+ */
+
+#include <string.h>
+
+#include "bench.h"
+
+const char* const bench_corpus_names[BENCH_CORPUS_COUNT] = {
+    "az", "binary", "url", "json", "utf8", "html"
+};
+
+static const char url_safe[] =
+    "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-_.";
+static const char url_escape[] = " &=?/:%#+@";
+
+static const char json_safe[] =
+    "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ 0123456789 ,.:;-_()";
+static const char json_escape[] = "\"\\\n\t\r\b\f\001";
+
+static const char text_safe[] =
+    "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ 0123456789 ,.;:-_()";
+static const char html_escape[] = "&<>\"'";
+
+/* xorshift32, the state must not be 0 */
+static uint32_t next(uint32_t* s)
+{
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *s = x;
+    return x;
+}
+
+/* a random char of a string literal */
+#define PICK(S, R) (S[(R) % (sizeof(S) - 1)])
+
+/* write code point cp as UTF-8, returns bytes written */
+static size_t put_utf8(char* p, uint32_t cp)
+{
+    if (cp < 0x800) {
+        p[0] = (char)(0xC0 | (cp >> 6));
+        p[1] = (char)(0x80 | (cp & 0x3F));
+        return 2;
+    } else if (cp < 0x10000) {
+        p[0] = (char)(0xE0 | (cp >> 12));
+        p[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        p[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    p[0] = (char)(0xF0 | (cp >> 18));
+    p[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+    p[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    p[3] = (char)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+/* a random non-ascii code point of 2, 3 or 4 bytes, no surrogates */
+static uint32_t random_cp(uint32_t r)
+{
+    switch (r % 3) {
+    case 0: return 0x80 + (r >> 2) % (0x800 - 0x80);
+    case 1: return 0x800 + (r >> 2) % (0xD800 - 0x800);
+    default: return 0x10000 + (r >> 2) % (0x110000 - 0x10000);
+    }
+}
+
+void bench_corpus(char* buf, size_t len, int kind, double density, uint32_t seed)
+{
+    uint32_t s = seed ? seed : 1;
+    uint32_t limit;
+    uint32_t r;
+    size_t i = 0;
+
+    if (density <= 0.0) {
+        limit = 0;
+    } else if (density >= 1.0) {
+        limit = 0xFFFFFFFFu;
+    } else {
+        limit = (uint32_t)(density * 4294967296.0);
+    }
+
+    switch (kind) {
+    case BENCH_CORPUS_BINARY:
+        for (i = 0; i < len; ++i) {
+            buf[i] = (char)(next(&s) >> 24);
+        }
+        break;
+    case BENCH_CORPUS_URL:
+        for (i = 0; i < len; ++i) {
+            r = next(&s);
+            buf[i] = (r < limit) ? PICK(url_escape, next(&s)) : PICK(url_safe, next(&s));
+        }
+        break;
+    case BENCH_CORPUS_JSON:
+        for (i = 0; i < len; ++i) {
+            r = next(&s);
+            buf[i] = (r < limit) ? PICK(json_escape, next(&s)) : PICK(json_safe, next(&s));
+        }
+        break;
+    case BENCH_CORPUS_HTML:
+        for (i = 0; i < len; ++i) {
+            r = next(&s);
+            buf[i] = (r < limit) ? PICK(html_escape, next(&s)) : PICK(text_safe, next(&s));
+        }
+        break;
+    case BENCH_CORPUS_UTF8:
+        while (i < len) {
+            r = next(&s);
+            if (r < limit && len - i >= 4) {
+                i += put_utf8(buf + i, random_cp(next(&s)));
+            } else {
+                buf[i++] = PICK(text_safe, next(&s));
+            }
+        }
+        break;
+    default:
+        for (i = 0; i < len; ++i) {
+            buf[i] = (char)('A' + i % 26);
+        }
+        break;
+    }
+}
+
+int bench_corpus_find(const char* name)
+{
+    int i;
+    for (i = 0; i < BENCH_CORPUS_COUNT; ++i) {
+        if (strcmp(name, bench_corpus_names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,141 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/** \file bench_perf.c
+ *
+ * Copyright 2026, Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ *
+ * Hardware performance counters for modp_bench --perf, using
+ * perf_event_open on Linux.  Each counter is opened on its own so a
+ * missing one (common in VMs, or L1D on some CPUs) only loses that
+ * column.  Only user space is counted, which works with the default
+ * perf_event_paranoid of 2.  Counts are scaled if the kernel had to
+ * multiplex the counters.
+ *
+ * Elsewhere, or if no counter can be opened, bench_perf_open returns
+ * 0 and the benchmark runs without them.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+
+#ifdef __linux__
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static int perf_fd[BENCH_PERF_COUNT] = { -1, -1, -1, -1 };
+
+static int open_counter(uint32_t type, uint64_t config)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+int bench_perf_open(void)
+{
+    int i, n = 0;
+
+    perf_fd[BENCH_PERF_CYCLES] =
+        open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    perf_fd[BENCH_PERF_INSTRUCTIONS] =
+        open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    perf_fd[BENCH_PERF_BRANCH_MISSES] =
+        open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    perf_fd[BENCH_PERF_L1D_MISSES] =
+        open_counter(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                     (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    for (i = 0; i < BENCH_PERF_COUNT; ++i) {
+        if (perf_fd[i] >= 0) {
+            ++n;
+        }
+    }
+    return n;
+}
+
+void bench_perf_start(void)
+{
+    int i;
+    for (i = 0; i < BENCH_PERF_COUNT; ++i) {
+        if (perf_fd[i] >= 0) {
+            ioctl(perf_fd[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(perf_fd[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void bench_perf_stop(double counts[BENCH_PERF_COUNT])
+{
+    int i;
+    uint64_t v[3];
+
+    for (i = 0; i < BENCH_PERF_COUNT; ++i) {
+        counts[i] = -1.0;
+        if (perf_fd[i] < 0) {
+            continue;
+        }
+        ioctl(perf_fd[i], PERF_EVENT_IOC_DISABLE, 0);
+        /* value, time enabled, time running */
+        if (read(perf_fd[i], v, sizeof(v)) != (ssize_t)sizeof(v) || v[2] == 0) {
+            continue;
+        }
+        counts[i] = (double)v[0] * ((double)v[1] / (double)v[2]);
+    }
+}
+
+void bench_perf_close(void)
+{
+    int i;
+    for (i = 0; i < BENCH_PERF_COUNT; ++i) {
+        if (perf_fd[i] >= 0) {
+            close(perf_fd[i]);
+            perf_fd[i] = -1;
+        }
+    }
+}
+
+#else
+
+int bench_perf_open(void)
+{
+    return 0;
+}
+
+void bench_perf_start(void)
+{
+}
+
+void bench_perf_stop(double counts[BENCH_PERF_COUNT])
+{
+    int i;
+    for (i = 0; i < BENCH_PERF_COUNT; ++i) {
+        counts[i] = -1.0;
+    }
+}
+
+void bench_perf_close(void)
+{
+}
+
+#endif
@@ -0,0 +1,233 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/** \file bench_threads.c
+ *
+ * Copyright 2026, Nick Galbreath -- nickg [at] client9 [dot] com
+ * All rights reserved.
+ *
+ * http://code.google.com/p/stringencoders/
+ *
+ * Released under bsd license.  See modp_b64.c for details.
+ *
+ * Threads for modp_bench --threads.  Every worker copies the input to
+ * its own buffers, waits for the others, then calls the codec until
+ * its time is up, so the only thing shared is the codec's tables.
+ * The co-runner writes one byte of every cache line of a large buffer
+ * over and over, pushing the tables out of the shared cache the way
+ * an unrelated workload on the same machine would.
+ *
+ * Without pthreads bench_threads_run returns -1.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench.h"
+
+#ifdef HAVE_PTHREAD_H
+
+#include <pthread.h>
+
+/* calls between looks at the clock */
+#define BATCH 16
+
+struct worker {
+    pthread_t thread;
+    bench_fn fn;
+    const char* src;
+    size_t inlen;
+    size_t outlen;
+    double ns;
+    double calls;
+    double elapsed;
+    size_t sink;
+    int failed;
+};
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+static int go = 0;
+static int stop = 0;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void wait_go(void)
+{
+    pthread_mutex_lock(&lock);
+    while (!go) {
+        pthread_cond_wait(&cond, &lock);
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+static void* worker_main(void* arg)
+{
+    struct worker* w = (struct worker*)arg;
+    char* in = (char*)malloc(w->inlen + 1);
+    char* out = (char*)malloc(w->outlen + 16);
+    double t0, t;
+    size_t i, acc = 0;
+
+    if (in == NULL || out == NULL) {
+        w->failed = 1;
+    } else {
+        memcpy(in, w->src, w->inlen);
+        /* warm this thread's copies */
+        acc += w->fn(out, in, w->inlen);
+    }
+    wait_go();
+    if (!w->failed) {
+        t0 = now_ns();
+        do {
+            for (i = 0; i < BATCH; ++i) {
+                acc += w->fn(out, in, w->inlen);
+            }
+            w->calls += BATCH;
+            t = now_ns() - t0;
+        } while (t < w->ns);
+        w->elapsed = t;
+    }
+    w->sink = acc;
+    free(out);
+    free(in);
+    return NULL;
+}
+
+struct corunner {
+    pthread_t thread;
+    unsigned char* buf;
+    size_t len;
+};
+
+static void* corunner_main(void* arg)
+{
+    struct corunner* cr = (struct corunner*)arg;
+    size_t i;
+    int done = 0;
+
+    wait_go();
+    while (!done) {
+        for (i = 0; i < cr->len; i += 64) {
+            cr->buf[i] = (unsigned char)(cr->buf[i] + 1);
+        }
+        pthread_mutex_lock(&lock);
+        done = stop;
+        pthread_mutex_unlock(&lock);
+    }
+    return NULL;
+}
+
+int bench_threads_run(bench_fn fn, const char* in, size_t inlen, size_t outlen,
+                      size_t nthreads, size_t corunner, double ns,
+                      double* calls, double* elapsed)
+{
+    struct worker* w;
+    struct corunner cr;
+    size_t i, started = 0;
+    int rc = 0;
+
+    w = (struct worker*)calloc(nthreads, sizeof(struct worker));
+    if (w == NULL) {
+        return -1;
+    }
+    cr.len = corunner;
+    cr.buf = NULL;
+    if (corunner > 0) {
+        cr.buf = (unsigned char*)calloc(corunner, 1);
+        if (cr.buf == NULL) {
+            free(w);
+            return -1;
+        }
+    }
+
+    go = 0;
+    stop = 0;
+    if (cr.buf != NULL && pthread_create(&cr.thread, NULL, corunner_main, &cr) != 0) {
+        free(cr.buf);
+        cr.buf = NULL;
+        rc = -1;
+    }
+    for (i = 0; rc == 0 && i < nthreads; ++i) {
+        w[i].fn = fn;
+        w[i].src = in;
+        w[i].inlen = inlen;
+        w[i].outlen = outlen;
+        w[i].ns = ns;
+        if (pthread_create(&w[i].thread, NULL, worker_main, &w[i]) != 0) {
+            rc = -1;
+            break;
+        }
+        ++started;
+    }
+
+    /* a failed start still releases the threads that did start */
+    pthread_mutex_lock(&lock);
+    go = 1;
+    pthread_cond_broadcast(&cond);
+    pthread_mutex_unlock(&lock);
+
+    for (i = 0; i < started; ++i) {
+        pthread_join(w[i].thread, NULL);
+        if (w[i].failed) {
+            rc = -1;
+        }
+        calls[i] = w[i].calls;
+        elapsed[i] = w[i].elapsed;
+    }
+    if (cr.buf != NULL) {
+        pthread_mutex_lock(&lock);
+        stop = 1;
+        pthread_mutex_unlock(&lock);
+        pthread_join(cr.thread, NULL);
+        free(cr.buf);
+    }
+    free(w);
+    return rc;
+}
+
+int bench_threads_cpus(void)
+{
+#ifdef _SC_NPROCESSORS_ONLN
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#else
+    return 1;
+#endif
+}
+
+#else
+
+int bench_threads_run(bench_fn fn, const char* in, size_t inlen, size_t outlen,
+                      size_t nthreads, size_t corunner, double ns,
+                      double* calls, double* elapsed)
+{
+    (void)fn;
+    (void)in;
+    (void)inlen;
+    (void)outlen;
+    (void)nthreads;
+    (void)corunner;
+    (void)ns;
+    (void)calls;
+    (void)elapsed;
+    return -1;
+}
+
+int bench_threads_cpus(void)
+{
+    return 1;
+}
+
+#endif
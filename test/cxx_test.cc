@@ -2,9 +2,16 @@
 /* vi: set expandtab shiftwidth=4 tabstop=4: */
 
 #include <cstdlib>
+#include <cstring>
 #include <string>
 using std::string;
 
+#include <vector>
+using std::vector;
+
+#include <deque>
+#include <iterator>
+
 #include <iostream>
 using std::cerr;
 
@@ -15,7 +22,15 @@ using std::cerr;
 #include "modp_b64w.h"
 #include "modp_burl.h"
 #include "modp_bjavascript.h"
+#include "modp_xml.h"
 #include "modp_ascii.h"
+#include "modp_qp.h"
+#include "modp_encword.h"
+#include "modp_punycode.h"
+#include "modp_datauri.h"
+#include "modp_json.h"
+#include "modp_messagepack.h"
+#include "modp_alloc.h"
 
 using namespace modp;
 
@@ -376,6 +391,534 @@ static void test_javascript_const()
     }
 }
 
+static void test_javascript_unicode()
+{
+    const string orig("</script>\xE2\x80\xA8\xC3\xA9");
+    const string expected("<\\/script>\\u2028\xC3\xA9");
+    string result = javascript_uencode(orig);
+    if (result != expected) {
+        WHERE(cerr) << "Expected: " << expected << "Received: " << result << "\n";
+        exit(1);
+    }
+    javascript_decode(result);
+    if (result != orig) {
+        WHERE(cerr) << "Expected: " << orig << "Received: " << result << "\n";
+        exit(1);
+    }
+    result = "\\u12";
+    javascript_decode(result);
+    if (!result.empty()) {
+        WHERE(cerr) << "Expected decode to be empty\n";
+        exit(1);
+    }
+}
+
+static void test_xml()
+{
+    const string orig("a<b & \"c\" 'd'>");
+    const string expected("a&lt;b &amp; &quot;c&quot; &apos;d&apos;&gt;");
+    string result = xml_encode(orig);
+    if (result != expected) {
+        WHERE(cerr) << "Expected: " << expected << " Received: " << result << "\n";
+        exit(1);
+    }
+    string s(orig);
+    xml_encode(s);
+    if (s != expected || xml_decode(s) != orig) {
+        WHERE(cerr) << "xml_encode in place failed: " << s << "\n";
+        exit(1);
+    }
+
+    char buf[16];
+    if (xml_encode(buf, sizeof(buf), "<", 1) != 4 || string(buf, 4) != "&lt;") {
+        WHERE(cerr) << "xml_encode into buffer failed\n";
+        exit(1);
+    }
+    /* 6 * 3 + 1 bytes needed, even if "abc" would fit */
+    if (xml_encode(buf, sizeof(buf), "abc", 3) != (size_t)-1) {
+        WHERE(cerr) << "Expected buffer too small\n";
+        exit(1);
+    }
+
+    vector<char> v(1, '[');
+    xml_encode_append(v, "&", 1);
+    string out;
+    xml_encode_to(out, "'", 1);
+    if (string(&v[0], v.size()) != "[&amp;" || out != "&apos;") {
+        WHERE(cerr) << "xml_encode_append or xml_encode_to failed\n";
+        exit(1);
+    }
+
+#ifdef MODP_HAS_STRING_VIEW
+    if (xml_encode(std::string_view("<>")) != "&lt;&gt;") {
+        WHERE(cerr) << "xml_encode string_view failed\n";
+        exit(1);
+    }
+#endif
+}
+
+static void test_qp()
+{
+    const string orig("caf\xC3\xA9 = ok ");
+    const string expected("caf=C3=A9 =3D ok=20");
+    string result = qp_encode(orig);
+    if (result != expected) {
+        WHERE(cerr) << "Expected: " << expected << "Received: " << result << "\n";
+        exit(1);
+    }
+    qp_decode(result);
+    if (result != orig) {
+        WHERE(cerr) << "Expected: " << orig << "Received: " << result << "\n";
+        exit(1);
+    }
+}
+
+static void test_encword()
+{
+    const string orig("caf\xC3\xA9 au lait");
+    const string expected("=?UTF-8?Q?caf=C3=A9_au_lait?=");
+    string result = encword_encode(orig);
+    if (result != expected) {
+        WHERE(cerr) << "Expected: " << expected << "Received: " << result << "\n";
+        exit(1);
+    }
+    result = encword_decode(result);
+    if (result != orig) {
+        WHERE(cerr) << "Expected: " << orig << "Received: " << result << "\n";
+        exit(1);
+    }
+}
+
+static void test_idna()
+{
+    const string orig("www.B\xC3\xBC" "cher.de");
+    const string expected("www.xn--bcher-kva.de");
+    string result = idna_to_ascii(orig);
+    if (result != expected) {
+        WHERE(cerr) << "Expected: " << expected << "Received: " << result << "\n";
+        exit(1);
+    }
+    result = idna_to_unicode(result);
+    if (result != "www.b\xC3\xBC" "cher.de") {
+        WHERE(cerr) << "Received: " << result << "\n";
+        exit(1);
+    }
+    if (!punycode_decode(string("-")).empty()) {
+        WHERE(cerr) << "Expected decode to be empty\n";
+        exit(1);
+    }
+}
+
+static void test_datauri()
+{
+    const string orig("\x89PNG\r\n");
+    const string expected("data:image/png;base64,iVBORw0K");
+    string result = datauri_encode("image/png", orig);
+    if (result != expected) {
+        WHERE(cerr) << "Expected: " << expected << "Received: " << result << "\n";
+        exit(1);
+    }
+    string mime;
+    datauri_decode(result, &mime);
+    if (result != orig || mime != "image/png") {
+        WHERE(cerr) << "Received: " << result << " " << mime << "\n";
+        exit(1);
+    }
+    result = "data:,a%20b";
+    datauri_decode(result);
+    if (result != "a b") {
+        WHERE(cerr) << "Expected: a b Received: " << result << "\n";
+        exit(1);
+    }
+}
+
+/*
+ * the buffer, append and string_view overloads from modp_cxx.h
+ */
+static void test_cxx_buffers()
+{
+    char buf[16];
+    size_t d = b64_encode(buf, sizeof(buf), "abcd", 4);
+    if (d != 8 || string(buf, d) != "YWJjZA==") {
+        WHERE(cerr) << "b64_encode into buffer failed\n";
+        exit(1);
+    }
+    if (b64_encode(buf, 4, "abcd", 4) != (size_t)-1) {
+        WHERE(cerr) << "Expected buffer too small\n";
+        exit(1);
+    }
+
+    string out("x=");
+    url_encode_append(out, "a b", 3);
+    b16_encode_append(out, "\xff", 1);
+    if (out != "x=a+bFF") {
+        WHERE(cerr) << "Expected: x=a+bFF Received: " << out << "\n";
+        exit(1);
+    }
+
+    vector<char> v(1, '[');
+    b64_decode_append(v, "YWJj", 4);
+    if (v.size() != 4 || string(&v[0], v.size()) != "[abc") {
+        WHERE(cerr) << "b64_decode_append to vector failed\n";
+        exit(1);
+    }
+    if (b64_decode_append(v, "Y!Jj", 4) != (size_t)-1 || v.size() != 4) {
+        WHERE(cerr) << "Expected failed append to leave vector alone\n";
+        exit(1);
+    }
+
+#ifdef MODP_HAS_STRING_VIEW
+    std::string_view sv("hello");
+    if (b16_encode(sv) != "68656C6C6F" || b16_decode(std::string_view("6869")) != "hi") {
+        WHERE(cerr) << "string_view overloads failed\n";
+        exit(1);
+    }
+#endif
+}
+
+/*
+ * a toy chunked buffer, like an iobuf or rope, to check that any type
+ * with prepare/commit works as a sink
+ */
+class chunk_sink {
+public:
+    char* prepare(size_t n)
+    {
+        chunks_.push_back(string(n, '\0'));
+        return &chunks_.back()[0];
+    }
+
+    void commit(size_t n)
+    {
+        chunks_.back().resize(n);
+    }
+
+    string str() const
+    {
+        string x;
+        for (size_t i = 0; i < chunks_.size(); ++i) {
+            x += chunks_[i];
+        }
+        return x;
+    }
+
+    size_t chunks() const { return chunks_.size(); }
+
+private:
+    vector<string> chunks_;
+};
+
+static void test_cxx_sinks()
+{
+    vector<unsigned char> bytes;
+    if (b64_decode_to(bytes, "AP8=", 4) != 2 || bytes.size() != 2 ||
+        bytes[0] != 0 || bytes[1] != 255) {
+        WHERE(cerr) << "b64_decode_to vector<unsigned char> failed\n";
+        exit(1);
+    }
+
+    string out;
+    b16_encode_to(out, "hi", 2);
+    if (out != "6869") {
+        WHERE(cerr) << "Expected: 6869 Received: " << out << "\n";
+        exit(1);
+    }
+
+    char buf[8];
+    array_sink fixed(buf);
+    b64_encode_to(fixed, "abc", 3);
+    b16_encode_to(fixed, "\x01", 1);
+    if (string(fixed.data(), fixed.size()) != "YWJj01") {
+        WHERE(cerr) << "array_sink failed: " << string(fixed.data(), fixed.size()) << "\n";
+        exit(1);
+    }
+    /* no room for 4 more + null: refused, not truncated */
+    if (b64_encode_to(fixed, "abc", 3) != (size_t)-1 || fixed.size() != 6) {
+        WHERE(cerr) << "Expected array_sink to be full\n";
+        exit(1);
+    }
+
+    chunk_sink chunks;
+    url_encode_to(chunks, "a b", 3);
+    javascript_uencode_to(chunks, "</", 2);
+    b64_decode_to(chunks, "!!!!", 4);
+    if (chunks.str() != "a+b<\\/" || chunks.chunks() != 3) {
+        WHERE(cerr) << "custom sink failed: " << chunks.str() << "\n";
+        exit(1);
+    }
+
+    std::deque<char> dq;
+    iterator_sink<std::back_insert_iterator<std::deque<char> > > it =
+        make_iterator_sink(std::back_inserter(dq));
+    b16_decode_to(it, "4142", 4);
+    b16_decode_to(it, "43", 2);
+    if (string(dq.begin(), dq.end()) != "ABC") {
+        WHERE(cerr) << "iterator_sink failed\n";
+        exit(1);
+    }
+}
+
+static void test_json_writer()
+{
+    JsonWriter w;
+    w.map_open().key("id").add(42).key("name").add(string("a\"b"))
+        .key("tags").ary_open().add(true).add_null().add(1.5).ary_close()
+        .map_close();
+    string expected("{\"id\":42,\"name\":\"a\\\"b\",\"tags\":[true,null,1.5]}");
+    if (w.str() != expected) {
+        WHERE(cerr) << "Expected: " << expected << " Received: " << w.str() << "\n";
+        exit(1);
+    }
+
+    /* small document: take() leaves the writer empty and reusable */
+    string out = w.take();
+    if (out != expected || w.size() != 0) {
+        WHERE(cerr) << "take failed: " << out << "\n";
+        exit(1);
+    }
+
+    /* spill from the inline space to the heap */
+    basic_json_writer<vector<char>, 16> big;
+    string item(100, 'x');
+    size_t i;
+    big.ary_open();
+    for (i = 0; i < 50; ++i) {
+        big.add(item).add((unsigned int)i);
+    }
+    big.ary_close();
+    size_t n = big.size();
+    const char* before = big.data();
+    vector<char> v = big.take();
+    if (v.size() != n || v.data() != before || v[0] != '[' || v[n - 1] != ']') {
+        WHERE(cerr) << "Expected take to hand over the vector\n";
+        exit(1);
+    }
+
+    /* long, long long and size_t must all pick an overload */
+    JsonWriter ints;
+    ints.ary_open().add(-5L).add((int64_t)-7).add((long long)8)
+        .add((size_t)9).add((uint64_t)10).add(-(1LL << 60)).ary_close();
+    if (ints.str() != "[-5,-7,8,9,10,\"-1152921504606846976\"]") {
+        WHERE(cerr) << "JsonWriter int64 failed: " << ints.str() << "\n";
+        exit(1);
+    }
+
+#if __cplusplus >= 201103L
+    JsonWriter a;
+    a.ary_open().add("x");
+    JsonWriter b(std::move(a));
+    b.ary_close();
+    if (b.str() != "[\"x\"]" || a.size() != 0) {
+        WHERE(cerr) << "JsonWriter move failed: " << b.str() << "\n";
+        exit(1);
+    }
+#endif
+}
+
+static void test_msgpack_writer()
+{
+    MsgpackWriter w;
+    w.map_open(2).add("a").add(1).add("b").add(false);
+    string out = w.take();
+    /* fixmap 2, fixstr "a", int32 1, fixstr "b", false */
+    if (out.size() != 11 || (unsigned char)out[0] != 0x82 || out[2] != 'a' ||
+        (unsigned char)out[3] != 0xD2 || (unsigned char)out[10] != 0xC2) {
+        WHERE(cerr) << "MsgpackWriter failed, size " << out.size() << "\n";
+        exit(1);
+    }
+
+    basic_msgpack_writer<string, 8> big;
+    big.ary_open(3).add(string(1000, 'y')).add_null().add(2.0);
+    if (big.size() != 1 + 3 + 1000 + 1 + 9) {
+        WHERE(cerr) << "MsgpackWriter grow failed, size " << big.size() << "\n";
+        exit(1);
+    }
+
+    MsgpackWriter ints;
+    ints.ary_open(4).add(-5L).add((int64_t)-7).add((size_t)9).add((uint64_t)10);
+    out = ints.take();
+    /* fixarray 4, then int64 twice and uint64 twice */
+    if (out.size() != 1 + 4 * 9 || (unsigned char)out[1] != 0xD3 ||
+        (unsigned char)out[10] != 0xD3 || (unsigned char)out[19] != 0xCF ||
+        (unsigned char)out[28] != 0xCF) {
+        WHERE(cerr) << "MsgpackWriter int64 failed, size " << out.size() << "\n";
+        exit(1);
+    }
+}
+
+static void test_arena()
+{
+    char stack[128];
+    modp::arena a(stack, sizeof(stack));
+    char* p = static_cast<char*>(a.alloc(4, 1));
+    if (p != stack || a.used() != 4) {
+        WHERE(cerr) << "arena alloc failed\n";
+        exit(1);
+    }
+    a.alloc(1000);
+    a.reset();
+    if (a.alloc(4, 1) != stack) {
+        WHERE(cerr) << "arena reset failed\n";
+        exit(1);
+    }
+
+#ifdef MODP_HAS_PMR
+    a.reset();
+    std::pmr::string s = b64_encode("abc", &a);
+    if (s != "YWJj" || s.get_allocator().resource() != &a) {
+        WHERE(cerr) << "pmr b64_encode failed: " << s << "\n";
+        exit(1);
+    }
+
+    std::pmr::vector<char> v(&a);
+    url_encode_append(v, "a b", 3);
+    if (string(v.begin(), v.end()) != "a+b") {
+        WHERE(cerr) << "pmr append failed\n";
+        exit(1);
+    }
+
+    /* writers keep the arena through take and moves */
+    pmr::JsonWriter w(&a);
+    w.ary_open().add(string(500, 'x')).ary_close();
+    pmr::JsonWriter w2(std::move(w));
+    std::pmr::string out = w2.take();
+    if (out.size() != 504 || out.get_allocator().resource() != &a) {
+        WHERE(cerr) << "pmr JsonWriter failed, size " << out.size() << "\n";
+        exit(1);
+    }
+
+    pmr::MsgpackWriter m(&a);
+    m.add(1);
+    if (m.take().get_allocator().resource() != &a) {
+        WHERE(cerr) << "pmr MsgpackWriter failed\n";
+        exit(1);
+    }
+
+    /* a pmr resource over a C arena */
+    modp_arena_t c;
+    modp_arena_init(&c, NULL, 0, NULL);
+    modp_allocator_t ca = modp_arena_allocator(&c);
+    allocator_resource r(&ca);
+    std::pmr::string t = b16_encode(string(20, '\x01'), &r);
+    if (t.size() != 40 || t.compare(0, 4, "0101") != 0 || modp_arena_used(&c) == 0) {
+        WHERE(cerr) << "allocator_resource failed: " << t << "\n";
+        exit(1);
+    }
+    t = std::pmr::string();
+    modp_arena_destroy(&c);
+#endif
+}
+
+#if __cplusplus >= 201402L
+#include "config.h"
+#include "modp_constexpr.h"
+
+/* the generated tables, to check the constexpr builders against */
+namespace gen_b64 {
+#include "modp_b64_data.h"
+}
+namespace gen_b16 {
+#include "modp_b16_data.h"
+}
+namespace gen_burl {
+#include "modp_burl_data.h"
+}
+
+/* the escape tables of modp_burl_gen as the one byte map of url_encode_table */
+static uint8_t url_map(uint8_t len, const char* esc, size_t i)
+{
+    return (len == 0) ? (uint8_t) i : (len == 1) ? (uint8_t) esc[0] : 0;
+}
+
+#ifdef WORDS_BIGENDIAN
+static const bool big_endian = true;
+#else
+static const bool big_endian = false;
+#endif
+
+static constexpr bool ct_equals(const char* a, const char* b)
+{
+    while (*a && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return *a == *b;
+}
+
+/* these are checked by the compiler, not at run time */
+static_assert(ct_equals(ct::b64_encode("user:secret").c_str(), "dXNlcjpzZWNyZXQ="), "");
+static_assert(ct::b64_encode("user:secret").size() == 16, "");
+static_assert(ct_equals(ct::b64w_encode("\xfb\xff").c_str(), "-_8."), "");
+static_assert(ct_equals(ct::b64r_encode("\xfb\xff").c_str(), "-_8="), "");
+static_assert(ct_equals(ct::b64_decode("YWJjZA==").c_str(), "abcd"), "");
+static_assert(!ct::b64_decode("YWJ!").ok(), "");
+static_assert(ct_equals(ct::b16_encode("\x01\xab").c_str(), "01AB"), "");
+static_assert(ct_equals(ct::b16_decode("6869").c_str(), "hi"), "");
+static_assert(!ct::b16_decode("686").ok(), "");
+static_assert(ct_equals(ct::url_encode("a b/c~").c_str(), "a+b%2Fc%7E"), "");
+static_assert(ct::url_encode_table()[' '] == '+', "");
+static_assert(ct::b64_decode_table(3, false)['='] == 0x01FFFFFF, "");
+
+static void test_constexpr()
+{
+    char src[256];
+    char a[3 * 256 + 1];
+    char b[3 * 256 + 1];
+    size_t i, len;
+
+    for (i = 0; i < sizeof(src); ++i) {
+        src[i] = (char) i;
+    }
+
+    /* same output as the library for every byte and length */
+    for (len = 0; len <= sizeof(src); ++len) {
+        const char* s = src + sizeof(src) - len;
+        if (ct::b64_encode(a, s, len) != modp_b64_encode(b, s, len) || strcmp(a, b) != 0 ||
+            ct::b64w_encode(a, s, len) != modp_b64w_encode(b, s, len) || strcmp(a, b) != 0 ||
+            ct::b16_encode(a, s, len) != modp_b16_encode(b, s, len) || strcmp(a, b) != 0 ||
+            ct::url_encode(a, s, len) != modp_burl_encode(b, s, len) || strcmp(a, b) != 0) {
+            WHERE(cerr) << "constexpr encode differs, len=" << len << "\n";
+            exit(1);
+        }
+        modp_b64_encode(b, s, len);
+        if (ct::b64_decode(a, b, strlen(b)) != len || memcmp(a, s, len) != 0) {
+            WHERE(cerr) << "constexpr b64 decode failed, len=" << len << "\n";
+            exit(1);
+        }
+        modp_b16_encode(b, s, len);
+        if (ct::b16_decode(a, b, strlen(b)) != len || memcmp(a, s, len) != 0) {
+            WHERE(cerr) << "constexpr b16 decode failed, len=" << len << "\n";
+            exit(1);
+        }
+    }
+
+    /* same tables as the generators */
+    constexpr ct::table<uint8_t> e0 = ct::b64_encode_table(0);
+    constexpr ct::table<uint8_t> e1 = ct::b64_encode_table(1);
+    constexpr ct::table<uint8_t> h1 = ct::hex_encode_table(true);
+    constexpr ct::table<uint8_t> h2 = ct::hex_encode_table(false);
+    constexpr ct::table<uint32_t> hd = ct::hex_decode_table(false);
+    constexpr ct::table<uint32_t> hd2 = ct::hex_decode_table(true);
+    constexpr ct::table<uint8_t> url = ct::url_encode_table();
+    const ct::table<uint32_t> d0 = ct::b64_decode_table(0, big_endian);
+    const ct::table<uint32_t> d1 = ct::b64_decode_table(1, big_endian);
+    const ct::table<uint32_t> d2 = ct::b64_decode_table(2, big_endian);
+    const ct::table<uint32_t> d3 = ct::b64_decode_table(3, big_endian);
+
+    for (i = 0; i < 256; ++i) {
+        if (e0[i] != gen_b64::e0[i] || e1[i] != gen_b64::e1[i] ||
+            d0[i] != gen_b64::d0[i] || d1[i] != gen_b64::d1[i] ||
+            d2[i] != gen_b64::d2[i] || d3[i] != gen_b64::d3[i] ||
+            h1[i] != gen_b16::gsHexEncodeC1[i] || h2[i] != gen_b16::gsHexEncodeC2[i] ||
+            hd[i] != gen_b16::gsHexDecodeMap[i] || hd2[i] != gen_b16::gsHexDecodeD2[i] ||
+            url[i] != url_map(gen_burl::gsUrlEncodeLen[i], gen_burl::gsUrlEncodeEsc[i], i)) {
+            WHERE(cerr) << "constexpr table differs at " << i << "\n";
+            exit(1);
+        }
+    }
+}
+#endif
+
 static void test_ascii_inline()
 {
     string orig;
@@ -475,6 +1018,20 @@ int main()
     test_url_cstr();
     test_javascript();
     test_javascript_const();
+    test_javascript_unicode();
+    test_xml();
+    test_qp();
+    test_encword();
+    test_idna();
+    test_datauri();
+    test_cxx_buffers();
+    test_cxx_sinks();
+    test_json_writer();
+    test_msgpack_writer();
+    test_arena();
+#if __cplusplus >= 201402L
+    test_constexpr();
+#endif
     test_ascii_inline();
     test_ascii_copy();
 
@@ -0,0 +1,186 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minunit.h"
+
+#include "modp_alloc.h"
+#include "modp_b64.h"
+
+/* a parent allocator that counts calls and can be told to fail */
+struct counter {
+    int allocs;
+    int frees;
+    size_t live;
+    int fail;
+};
+
+static void* count_allocate(void* state, size_t size, size_t align)
+{
+    struct counter* c = (struct counter*)state;
+    (void)align;
+    if (c->fail) {
+        return NULL;
+    }
+    c->allocs += 1;
+    c->live += size;
+    return malloc(size);
+}
+
+static void count_deallocate(void* state, void* ptr, size_t size, size_t align)
+{
+    struct counter* c = (struct counter*)state;
+    (void)align;
+    c->frees += 1;
+    c->live -= size;
+    free(ptr);
+}
+
+static char* testHeap(void)
+{
+    char* p = (char*)modp_allocate(NULL, 10, 8);
+    mu_assert(p != NULL);
+    memset(p, 'x', 10);
+    modp_deallocate(NULL, p, 10, 8);
+    return 0;
+}
+
+static char* testCallerBuffer(void)
+{
+    char buf[64];
+    struct counter c = { 0, 0, 0, 0 };
+    modp_allocator_t parent = { count_allocate, count_deallocate, NULL };
+    modp_arena_t arena;
+    char* p;
+    char* q;
+
+    parent.state = &c;
+    modp_arena_init(&arena, buf, sizeof(buf), &parent);
+
+    p = (char*)modp_arena_alloc(&arena, 10, 1);
+    mu_assert(p == buf);
+    q = (char*)modp_arena_alloc(&arena, 8, 8);
+    mu_assert(q >= p + 10);
+    mu_assert(((size_t)q & 7) == 0);
+    mu_assert(q + 8 <= buf + sizeof(buf));
+    mu_assert_int_equals(0, c.allocs);
+
+    /* doesn't fit: one block from the parent */
+    p = (char*)modp_arena_alloc(&arena, 100, 1);
+    mu_assert(p != NULL);
+    mu_assert(p < buf || p >= buf + sizeof(buf));
+    mu_assert_int_equals(1, c.allocs);
+
+    /* back to the caller buffer */
+    modp_arena_reset(&arena);
+    mu_assert_int_equals(0, modp_arena_used(&arena));
+    p = (char*)modp_arena_alloc(&arena, 10, 1);
+    mu_assert(p == buf);
+
+    modp_arena_destroy(&arena);
+    mu_assert_int_equals(c.allocs, c.frees);
+    mu_assert_int_equals(0, c.live);
+    return 0;
+}
+
+static char* testReset(void)
+{
+    struct counter c = { 0, 0, 0, 0 };
+    modp_allocator_t parent = { count_allocate, count_deallocate, NULL };
+    modp_arena_t arena;
+    char* first;
+    char* p;
+    int i;
+
+    parent.state = &c;
+    modp_arena_init(&arena, NULL, 0, &parent);
+
+    first = (char*)modp_arena_alloc(&arena, 100, 1);
+    mu_assert(first != NULL);
+    mu_assert_int_equals(1, c.allocs);
+    mu_assert_int_equals(100, modp_arena_used(&arena));
+
+    /* many requests of the same size reuse the kept block */
+    for (i = 0; i < 100; ++i) {
+        modp_arena_reset(&arena);
+        p = (char*)modp_arena_alloc(&arena, 100, 1);
+        mu_assert(p == first);
+    }
+    mu_assert_int_equals(1, c.allocs);
+    mu_assert_int_equals(0, c.frees);
+
+    /* larger than a block: a block of its own, freed on reset */
+    p = (char*)modp_arena_alloc(&arena, 3 * MODP_ARENA_BLOCK_SIZE, 16);
+    mu_assert(p != NULL);
+    mu_assert(((size_t)p & 15) == 0);
+    memset(p, 0, 3 * MODP_ARENA_BLOCK_SIZE);
+    mu_assert_int_equals(2, c.allocs);
+    modp_arena_reset(&arena);
+    mu_assert_int_equals(1, c.frees);
+
+    modp_arena_destroy(&arena);
+    mu_assert_int_equals(c.allocs, c.frees);
+    mu_assert_int_equals(0, c.live);
+    return 0;
+}
+
+static char* testFail(void)
+{
+    struct counter c = { 0, 0, 0, 1 };
+    modp_allocator_t parent = { count_allocate, count_deallocate, NULL };
+    modp_arena_t arena;
+
+    parent.state = &c;
+    modp_arena_init(&arena, NULL, 0, &parent);
+    mu_assert(modp_arena_alloc(&arena, 1, 1) == NULL);
+    mu_assert(modp_arena_alloc(&arena, (size_t)-1, 1) == NULL);
+    mu_assert(modp_arena_alloc(&arena, 1, (size_t)1 << (sizeof(size_t) * 8 - 1)) == NULL);
+    modp_arena_destroy(&arena);
+    return 0;
+}
+
+static char* testArenaAllocator(void)
+{
+    char buf[256];
+    modp_arena_t arena;
+    modp_allocator_t a;
+    char* out;
+    size_t d;
+
+    modp_arena_init(&arena, buf, sizeof(buf), NULL);
+    a = modp_arena_allocator(&arena);
+
+    out = (char*)modp_allocate(&a, modp_b64_encode_len(3), 1);
+    mu_assert(out == buf);
+    d = modp_b64_encode(out, "abc", 3);
+    mu_assert_int_equals(4, d);
+    mu_assert_str_equals("YWJj", out);
+    modp_deallocate(&a, out, modp_b64_encode_len(3), 1);
+
+    /* arenas can nest, the inner blocks come from the outer arena */
+    {
+        modp_arena_t inner;
+        modp_arena_init(&inner, NULL, 0, &a);
+        mu_assert(modp_arena_alloc(&inner, 1, 1) != NULL);
+        mu_assert(modp_arena_used(&arena) >= MODP_ARENA_BLOCK_SIZE);
+        modp_arena_destroy(&inner);
+    }
+
+    modp_arena_destroy(&arena);
+    return 0;
+}
+
+static char* all_tests(void)
+{
+    mu_run_test(testHeap);
+    mu_run_test(testCallerBuffer);
+    mu_run_test(testReset);
+    mu_run_test(testFail);
+    mu_run_test(testArenaAllocator);
+    return 0;
+}
+
+UNITTESTS
@@ -127,6 +127,152 @@ static char* testBinaryEscape(void)
     return 0;
 }
 
+/**
+ * UTF-8 is passed through, broken UTF-8 is hex escaped
+ */
+static char* testUnicodePassThrough(void)
+{
+    char buf[100];
+    /* e-acute, euro sign, G clef, then a bad continuation byte */
+    const char* s1 = "caf\xC3\xA9 \xE2\x82\xAC \xF0\x9D\x84\x9E \x80";
+    const char* s2 = "caf\xC3\xA9 \xE2\x82\xAC \xF0\x9D\x84\x9E \\x80";
+    size_t d = modp_bjavascript_uencode(buf, s1, strlen(s1), 0);
+    mu_assert_int_equals(d, strlen(s2));
+    mu_assert_str_equals(buf, s2);
+    mu_assert_int_equals(d, modp_bjavascript_uencode_strlen(s1, strlen(s1), 0));
+
+    /* overlong and surrogate forms are not UTF-8 */
+    d = modp_bjavascript_uencode(buf, "\xC0\xAF\xED\xA0\x80", (size_t)5, 0);
+    mu_assert_str_equals(buf, "\\xC0\\xAF\\xED\\xA0\\x80");
+    mu_assert_int_equals(d, 20);
+    return 0;
+}
+
+static char* testUnicodeEscape(void)
+{
+    char buf[100];
+    const char* s1 = "a\xE2\x80\xA8" "b\xE2\x80\xA9" "c\xC3\xA9";
+    const char* s2 = "a\\u2028b\\u2029c\xC3\xA9";
+    const char* s3 = "a\\u2028b\\u2029c\\u00E9";
+    size_t d = modp_bjavascript_uencode(buf, s1, strlen(s1), MODP_JS_ESCAPE_LINESEP);
+    mu_assert_int_equals(d, strlen(s2));
+    mu_assert_str_equals(buf, s2);
+
+    d = modp_bjavascript_uencode(buf, s1, strlen(s1), MODP_JS_ESCAPE_NONASCII);
+    mu_assert_int_equals(d, strlen(s3));
+    mu_assert_str_equals(buf, s3);
+    mu_assert_int_equals(d, modp_bjavascript_uencode_strlen(s1, strlen(s1),
+                                                            MODP_JS_ESCAPE_NONASCII));
+
+    /* astral plane gets a surrogate pair */
+    d = modp_bjavascript_uencode(buf, "\xF0\x9D\x84\x9E", (size_t)4, MODP_JS_ESCAPE_NONASCII);
+    mu_assert_str_equals(buf, "\\uD834\\uDD1E");
+    mu_assert_int_equals(d, 12);
+    return 0;
+}
+
+static char* testScriptEscape(void)
+{
+    char buf[100];
+    const char* s1 = "x = '</script><script>alert(1)</script>' < 1;";
+    const char* s2 = "x = \\'<\\/script><script>alert(1)<\\/script>\\' < 1;";
+    size_t d = modp_bjavascript_uencode(buf, s1, strlen(s1), MODP_JS_ESCAPE_HTML);
+    mu_assert_int_equals(d, strlen(s2));
+    mu_assert_str_equals(buf, s2);
+    mu_assert_int_equals(d, modp_bjavascript_uencode_strlen(s1, strlen(s1),
+                                                            MODP_JS_ESCAPE_HTML));
+
+    /* without the flag '<' is left alone */
+    d = modp_bjavascript_uencode(buf, "</", (size_t)2, 0);
+    mu_assert_str_equals(buf, "</");
+    mu_assert_int_equals(d, 2);
+    return 0;
+}
+
+/**
+ * Same output as the original encoder for ascii, check each
+ * position relative to the 8-byte word fast path
+ */
+static char* testUnicodeMatchesAscii(void)
+{
+    char input[40];
+    char buf1[200];
+    char buf2[200];
+    size_t i, j;
+    size_t d1, d2;
+    const char special[] = "\"'\\\n\t\x01\x7f";
+
+    for (i = 0; i < sizeof(special) - 1; ++i) {
+        for (j = 0; j < sizeof(input); ++j) {
+            memset(input, 'a', sizeof(input));
+            input[j] = special[i];
+            d1 = modp_bjavascript_encode(buf1, input, sizeof(input));
+            d2 = modp_bjavascript_uencode(buf2, input, sizeof(input), MODP_JS_ESCAPE_HTML);
+            mu_assert_int_equals(d1, d2);
+            mu_assert_str_equals(buf1, buf2);
+        }
+    }
+    return 0;
+}
+
+static char* testDecode(void)
+{
+    char buf[100];
+    const char* s1 = "a\\nb\\tc\\\\d\\'e\\\"f\\/g\\x41\\u00E9\\uD834\\uDD1E\\u{1F600}\\q";
+    const char* s2 = "a\nb\tc\\d'e\"f/gA\xC3\xA9\xF0\x9D\x84\x9E\xF0\x9F\x98\x80q";
+    size_t d = modp_bjavascript_decode(buf, s1, strlen(s1));
+    mu_assert_int_equals(d, strlen(s2));
+    mu_assert_str_equals(buf, s2);
+
+    /* line continuation */
+    d = modp_bjavascript_decode(buf, "ab\\\r\ncd", (size_t)7);
+    mu_assert_str_equals(buf, "abcd");
+
+    /* malformed */
+    mu_assert_int_equals(modp_bjavascript_decode(buf, "\\", (size_t)1), -1);
+    mu_assert_int_equals(modp_bjavascript_decode(buf, "\\x4", (size_t)3), -1);
+    mu_assert_int_equals(modp_bjavascript_decode(buf, "\\xZZ", (size_t)4), -1);
+    mu_assert_int_equals(modp_bjavascript_decode(buf, "\\u12G4", (size_t)6), -1);
+    mu_assert_int_equals(modp_bjavascript_decode(buf, "\\uD834", (size_t)6), -1);
+    mu_assert_int_equals(modp_bjavascript_decode(buf, "\\uDD1E", (size_t)6), -1);
+    mu_assert_int_equals(modp_bjavascript_decode(buf, "\\u{110000}", (size_t)10), -1);
+    return 0;
+}
+
+/**
+ * decode(encode(x)) == x for both encoders, including binary
+ */
+static char* testDecodeRoundTrip(void)
+{
+    char input[256];
+    char buf[1100];
+    size_t i, d;
+
+    for (i = 0; i < sizeof(input); ++i) {
+        input[i] = (char) i;
+    }
+
+    d = modp_bjavascript_encode(buf, input, sizeof(input));
+    d = modp_bjavascript_decode(buf, buf, d);
+    mu_assert_int_equals(d, sizeof(input));
+    mu_assert(memcmp(buf, input, sizeof(input)) == 0);
+
+    d = modp_bjavascript_uencode(buf, input, sizeof(input), MODP_JS_ESCAPE_HTML);
+    d = modp_bjavascript_decode(buf, buf, d);
+    mu_assert_int_equals(d, sizeof(input));
+    mu_assert(memcmp(buf, input, sizeof(input)) == 0);
+
+    {
+        const char* s1 = "</\xE2\x80\xA8\xC3\xA9\xF0\x9D\x84\x9E";
+        d = modp_bjavascript_uencode(buf, s1, strlen(s1),
+                                     MODP_JS_ESCAPE_HTML | MODP_JS_ESCAPE_NONASCII);
+        d = modp_bjavascript_decode(buf, buf, d);
+        mu_assert_int_equals(d, strlen(s1));
+        mu_assert_str_equals(buf, s1);
+    }
+    return 0;
+}
+
 static char* all_tests(void)
 {
     mu_run_test(testNoEscape);
@@ -134,6 +280,12 @@ static char* all_tests(void)
     mu_run_test(testBinaryEscape);
     mu_run_test(testSQuoteEscape);
     mu_run_test(testDQuoteEscape);
+    mu_run_test(testUnicodePassThrough);
+    mu_run_test(testUnicodeEscape);
+    mu_run_test(testScriptEscape);
+    mu_run_test(testUnicodeMatchesAscii);
+    mu_run_test(testDecode);
+    mu_run_test(testDecodeRoundTrip);
     return 0;
 }
 
@@ -0,0 +1,86 @@
+#!/bin/sh
+#
+# round trips every codec of the modp tool, through mmap and a pipe,
+# in blocks small enough that escapes and groups are cut between them,
+# and checks the output is the same as coding the input in one call.
+#
+
+MODP=${MODP:-../src/modp}
+T=${TMPDIR:-/tmp}/modp_cli_test.$$
+mkdir -p $T || exit 1
+trap 'rm -rf $T' 0
+
+# 96K of random bytes, and 96K of text full of things to escape
+perl -e 'srand(1); print map { chr(int(rand(256))) } 1..98304' > $T/bin
+perl -e 'srand(2); my @t = ("abc", "x y", "%", "%4", "&", "&amp", ";", "<", ">",
+    "\\", "\\u", "\"", "\x27", "/", "\n", "\r\n", "\t", "\x00", "\xc3\xa9",
+    "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\xe2\x80\xa8", "+", "=");
+    my $s = ""; $s .= $t[int(rand(@t))] while length($s) < 98304; print $s' > $T/txt
+
+fail=0
+check() {
+    if ! cmp -s "$1" "$2"; then
+        echo "FAIL: $3"
+        fail=1
+    fi
+}
+
+for c in `$MODP --list`; do
+    case $c in
+        b*) in=$T/bin ;;
+        *)  in=$T/txt ;;
+    esac
+    $MODP --block=64M $c $in > $T/enc || { echo "FAIL: $c encode"; fail=1; continue; }
+    $MODP -j 4 --block=4099 $c $in > $T/enc.map
+    check $T/enc $T/enc.map "$c encode, mmap"
+    cat $in | $MODP --block=4099 $c > $T/enc.pipe
+    check $T/enc $T/enc.pipe "$c encode, pipe"
+
+    if [ $c = json ]; then
+        continue
+    fi
+    $MODP -j 4 --block=4099 -d $c -o $T/dec.map $T/enc
+    check $in $T/dec.map "$c decode, mmap"
+    cat $T/enc | $MODP --block=4099 -d $c > $T/dec.pipe
+    check $in $T/dec.pipe "$c decode, pipe"
+done
+
+# escapes longer than the cut functions used to look back, cut by a
+# block of 4096: a run of backslashes and a numeric entity with
+# leading zeros
+perl -e 'print "a" x 4001, "\\" x 300' > $T/bs
+$MODP js $T/bs > $T/bs.js
+$MODP -j 4 --block=4096 -d js -o $T/bs.map $T/bs.js
+check $T/bs $T/bs.map "js decode of a backslash run, mmap"
+cat $T/bs.js | $MODP --block=4096 -d js > $T/bs.pipe
+check $T/bs $T/bs.pipe "js decode of a backslash run, pipe"
+
+perl -e 'print "a" x 4070, "&#", "0" x 34, "65;"' > $T/ent
+$MODP --block=64M -d xml $T/ent > $T/ent.once
+$MODP -j 4 --block=4096 -d xml -o $T/ent.map $T/ent
+check $T/ent.once $T/ent.map "xml decode of a long entity, mmap"
+cat $T/ent | $MODP --block=4096 -d xml > $T/ent.pipe
+check $T/ent.once $T/ent.pipe "xml decode of a long entity, pipe"
+
+# bad numeric entities are copied, and xml decode of any bytes does
+# not crash
+printf '&#\200;&#x;&#x\200;&#;' > $T/badent
+$MODP -d xml $T/badent > $T/badent.out || { echo "FAIL: xml decode of bad entities"; fail=1; }
+check $T/badent $T/badent.out "xml decode of bad entities"
+for m in "--block=64M" "-j 4 --block=4096"; do
+    $MODP $m -d xml -o $T/bin.xml $T/bin || { echo "FAIL: xml decode of binary, mmap $m"; fail=1; }
+    cat $T/bin | $MODP $m -d xml > $T/bin.pipe || { echo "FAIL: xml decode of binary, pipe $m"; fail=1; }
+    check $T/bin.xml $T/bin.pipe "xml decode of binary, $m"
+done
+
+# a trailing newline is not base64
+echo "aGVsbG8=" | $MODP -d b64 > $T/hello
+printf hello > $T/hello.ok
+check $T/hello.ok $T/hello "b64 decode, trailing newline"
+
+if echo "a!!!" | $MODP -d b64 > /dev/null 2>&1; then
+    echo "FAIL: b64 decode of bad input succeeded"
+    fail=1
+fi
+
+exit $fail
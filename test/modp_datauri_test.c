@@ -0,0 +1,130 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/* we compile as C90 but use snprintf */
+#define _ISOC99_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minunit.h"
+
+#include "modp_datauri.h"
+
+static char* testEncode(void)
+{
+    char buf[100];
+    size_t d;
+
+    d = modp_datauri_encode(buf, "image/png", (size_t)9, "abc", (size_t)3);
+    mu_assert_str_equals("data:image/png;base64,YWJj", buf);
+    mu_assert_int_equals(d, modp_datauri_encode_strlen(9, 3));
+    mu_assert_int_equals(d + 1, modp_datauri_encode_len(9, 3));
+
+    d = modp_datauri_encode(buf, "", (size_t)0, "", (size_t)0);
+    mu_assert_str_equals("data:;base64,", buf);
+    mu_assert_int_equals(d, modp_datauri_encode_strlen(0, 0));
+    return 0;
+}
+
+static char* testRoundTrip(void)
+{
+    char src[256];
+    char buf[modp_datauri_encode_len(10, 256)];
+    struct modp_datauri_t uri;
+    size_t i, len, d;
+
+    for (i = 0; i < sizeof(src); ++i) {
+        src[i] = (char) i;
+    }
+    for (len = 0; len <= sizeof(src); ++len) {
+        d = modp_datauri_encode(buf, "font/woff2", (size_t)10, src, len);
+        mu_assert_int_equals(modp_datauri_encode_strlen(10, len), d);
+        d = modp_datauri_decode(&uri, buf, d);
+        mu_assert_int_equals(len, d);
+        mu_assert_int_equals(1, uri.base64);
+        mu_assert_int_equals(10, uri.mime_len);
+        mu_assert(strncmp(uri.mime, "font/woff2", 10) == 0);
+        mu_assert(memcmp(src, uri.data, len) == 0);
+        mu_assert_int_equals(0, uri.data[len]);
+    }
+    return 0;
+}
+
+static char* testDecode(void)
+{
+    char buf[100];
+    struct modp_datauri_t uri;
+    size_t d;
+
+    /* percent encoded, no media type */
+    strcpy(buf, "data:,A%20brief%20note");
+    d = modp_datauri_decode(&uri, buf, strlen(buf));
+    mu_assert_int_equals(12, d);
+    mu_assert_int_equals(0, uri.mime_len);
+    mu_assert_int_equals(0, uri.base64);
+    mu_assert_str_equals("A brief note", uri.data);
+
+    /* parameters are part of the media type, base64 is any case */
+    strcpy(buf, "DATA:text/plain;charset=utf-8;BASE64,YWJj");
+    d = modp_datauri_decode(&uri, buf, strlen(buf));
+    mu_assert_int_equals(3, d);
+    mu_assert_int_equals(24, uri.mime_len);
+    mu_assert(strncmp(uri.mime, "text/plain;charset=utf-8", 24) == 0);
+    mu_assert_str_equals("abc", uri.data);
+
+    /* percent encoded base64 */
+    strcpy(buf, "data:;base64,YWJjZA%3D%3D");
+    d = modp_datauri_decode(&uri, buf, strlen(buf));
+    mu_assert_int_equals(4, d);
+    mu_assert_str_equals("abcd", uri.data);
+    return 0;
+}
+
+/* an empty payload, in a buffer of just len + 1 bytes */
+static char* testEmpty(void)
+{
+    static const char* const uris[] = { "data:;base64,", "data:,", "data:text/plain;base64," };
+    struct modp_datauri_t uri;
+    char* buf;
+    size_t i, len;
+
+    for (i = 0; i < sizeof(uris) / sizeof(uris[0]); ++i) {
+        len = strlen(uris[i]);
+        buf = (char*)malloc(len + 1);
+        mu_assert(buf != NULL);
+        memcpy(buf, uris[i], len + 1);
+        mu_assert_int_equals(0, modp_datauri_decode(&uri, buf, len));
+        mu_assert_int_equals(0, uri.data_len);
+        mu_assert_str_equals("", uri.data);
+        free(buf);
+    }
+    return 0;
+}
+
+static char* testBadDecode(void)
+{
+    char buf[100];
+    struct modp_datauri_t uri;
+
+    strcpy(buf, "http://example.com/");
+    mu_assert_int_equals(-1, modp_datauri_decode(&uri, buf, strlen(buf)));
+    strcpy(buf, "data:text/plain");
+    mu_assert_int_equals(-1, modp_datauri_decode(&uri, buf, strlen(buf)));
+    strcpy(buf, "data:;base64,YWJ!");
+    mu_assert_int_equals(-1, modp_datauri_decode(&uri, buf, strlen(buf)));
+    return 0;
+}
+
+static char* all_tests(void)
+{
+    mu_run_test(testEncode);
+    mu_run_test(testRoundTrip);
+    mu_run_test(testDecode);
+    mu_run_test(testEmpty);
+    mu_run_test(testBadDecode);
+    return 0;
+}
+
+UNITTESTS
@@ -0,0 +1,175 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/* we compile as C90 but use snprintf */
+#define _ISOC99_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minunit.h"
+
+#include "modp_encword.h"
+
+static char* testPlain(void)
+{
+    char buf[100];
+    size_t d;
+
+    d = modp_encword_encode(buf, "", (size_t)0);
+    mu_assert_int_equals(0, d);
+    mu_assert_str_equals("", buf);
+
+    d = modp_encword_encode(buf, "Hello World = 2", (size_t)15);
+    mu_assert_int_equals(15, d);
+    mu_assert_str_equals("Hello World = 2", buf);
+
+    /* looks like an encoded-word, so it must be encoded */
+    d = modp_encword_encode(buf, "=?ab cd", (size_t)7);
+    mu_assert_str_equals("=?UTF-8?Q?=3D=3Fab_cd?=", buf);
+    return 0;
+}
+
+static char* testEncodeQ(void)
+{
+    char buf[100];
+    const char* s = "caf\xc3\xa9 au lait";
+    size_t d = modp_encword_encode(buf, s, strlen(s));
+    mu_assert_str_equals("=?UTF-8?Q?caf=C3=A9_au_lait?=", buf);
+    mu_assert_int_equals(strlen(buf), d);
+    return 0;
+}
+
+static char* testEncodeB(void)
+{
+    char buf[100];
+    /* mostly non-ascii, B is shorter */
+    const char* s = "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e";
+    size_t d = modp_encword_encode(buf, s, strlen(s));
+    mu_assert_str_equals("=?UTF-8?B?5pel5pys6Kqe?=", buf);
+    mu_assert_int_equals(strlen(buf), d);
+    return 0;
+}
+
+/*
+ * long input is split into words of at most 75 chars, on UTF-8
+ * boundaries, and decodes back to the original
+ */
+static char* testSplit(void)
+{
+    char src[400];
+    char buf[modp_encword_encode_len(400)];
+    char back[sizeof(buf)];
+    char* word;
+    char* end;
+    size_t len, d, n;
+    int kind;
+
+    for (kind = 0; kind < 2; ++kind) {
+        for (len = 1; len < sizeof(src) - 3; len += 5) {
+            n = 0;
+            while (n < len) {
+                if (kind == 0) {
+                    /* mostly ascii, Q */
+                    src[n] = (char)('a' + (n % 26));
+                    n += 1;
+                    if (n % 9 == 1) {
+                        src[n] = (char)0xc3;
+                        src[n + 1] = (char)0xa9;
+                        n += 2;
+                    }
+                } else {
+                    /* 3 byte chars, B */
+                    src[n] = (char)0xe6;
+                    src[n + 1] = (char)0x97;
+                    src[n + 2] = (char)0xa5;
+                    n += 3;
+                }
+            }
+            d = modp_encword_encode(buf, src, n);
+            mu_assert(d < modp_encword_encode_len(n));
+            mu_assert_int_equals(strlen(buf), d);
+
+            /* each word is short enough and holds whole UTF-8 chars */
+            word = buf;
+            for (;;) {
+                end = strstr(word + 10, "?=");
+                mu_assert(end != NULL);
+                mu_assert(end + 2 - word <= MODP_ENCWORD_MAX);
+                d = modp_encword_decode(back, word, (size_t)(end + 2 - word));
+                mu_assert(d > 0);
+                mu_assert((back[0] & 0xC0) != 0x80);
+                if (kind == 1) {
+                    mu_assert_int_equals(0, d % 3);
+                }
+                if (end[2] == '\0') {
+                    break;
+                }
+                mu_assert(strncmp(end + 2, "\r\n ", 3) == 0);
+                word = end + 5;
+            }
+
+            d = modp_encword_decode(back, buf, strlen(buf));
+            mu_assert_int_equals(n, d);
+            mu_assert(memcmp(src, back, n) == 0);
+        }
+    }
+    return 0;
+}
+
+static char* testDecode(void)
+{
+    char buf[200];
+    const char* s;
+    size_t d;
+
+    /* from RFC 2047 section 8 */
+    s = "(=?ISO-8859-1?Q?a?=)";
+    d = modp_encword_decode(buf, s, strlen(s));
+    mu_assert_str_equals("(a)", buf);
+
+    s = "(=?ISO-8859-1?Q?a?= b)";
+    d = modp_encword_decode(buf, s, strlen(s));
+    mu_assert_str_equals("(a b)", buf);
+
+    s = "(=?ISO-8859-1?Q?a?= =?ISO-8859-1?Q?b?=)";
+    d = modp_encword_decode(buf, s, strlen(s));
+    mu_assert_str_equals("(ab)", buf);
+
+    s = "(=?ISO-8859-1?Q?a?=\r\n    =?ISO-8859-1?Q?b?=)";
+    d = modp_encword_decode(buf, s, strlen(s));
+    mu_assert_str_equals("(ab)", buf);
+
+    s = "(=?ISO-8859-1?Q?a_b?=)";
+    d = modp_encword_decode(buf, s, strlen(s));
+    mu_assert_str_equals("(a b)", buf);
+
+    s = "Subject: =?utf-8?b?5pel5pys6Kqe?= and =?UTF-8*en?q?caf=c3=a9?=";
+    d = modp_encword_decode(buf, s, strlen(s));
+    mu_assert_str_equals("Subject: \xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e and caf\xc3\xa9", buf);
+    mu_assert_int_equals(strlen(buf), d);
+
+    /* malformed words are left alone */
+    s = "=?UTF-8?X?abc?= =?UTF-8?Q?=ZZ?= =?UTF-8?B?abc?= =?UTF-8?Q?abc";
+    d = modp_encword_decode(buf, s, strlen(s));
+    mu_assert_str_equals(s, buf);
+
+    /* space is kept when the next word is bad */
+    s = "=?UTF-8?Q?a?= =?UTF-8?Q?=Z?=";
+    d = modp_encword_decode(buf, s, strlen(s));
+    mu_assert_str_equals("a =?UTF-8?Q?=Z?=", buf);
+    return 0;
+}
+
+static char* all_tests(void)
+{
+    mu_run_test(testPlain);
+    mu_run_test(testEncodeQ);
+    mu_run_test(testEncodeB);
+    mu_run_test(testSplit);
+    mu_run_test(testDecode);
+    return 0;
+}
+
+UNITTESTS
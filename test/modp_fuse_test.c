@@ -0,0 +1,137 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minunit.h"
+
+#include "modp_fuse.h"
+#include "modp_burl.h"
+#include "modp_utf8.h"
+#include "modp_xml.h"
+#include "modp_json.h"
+
+#define MAXLEN 20000
+
+static char* src;
+static char* mid;
+static char* once;
+static char* out;
+
+/* the stages one after another, -1 if not UTF-8 */
+static size_t stages(char* dest, const char* s, size_t len, int flags)
+{
+    modp_json_ctx ctx;
+
+    if (flags & MODP_FUSE_BURL_DECODE) {
+        len = modp_burl_decode(mid, s, len);
+        s = mid;
+    }
+    if ((flags & MODP_FUSE_UTF8_VALIDATE) && modp_utf8_validate(s, len) != MODP_UTF8_OK) {
+        return (size_t) -1;
+    }
+    if (flags & MODP_FUSE_XML_ENCODE) {
+        return modp_xml_encode(dest, s, len);
+    }
+    if (flags & MODP_FUSE_JSON_STRING) {
+        modp_json_init(&ctx, dest);
+        modp_json_add_string(&ctx, s, len);
+        return modp_json_end(&ctx);
+    }
+    memcpy(dest, s, len);
+    dest[len] = '\0';
+    return len;
+}
+
+/* text full of escapes, multi-byte UTF-8 and cut %XX */
+static size_t make_input(unsigned seed, size_t len, int bad)
+{
+    static const char* const parts[] = {
+        "abc", "x y", "+", "%", "%4", "%41", "%c3%a9", "%e2%82%ac",
+        "%F0%9F%98%80", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80",
+        "&", "<", ">", "\"", "'", "\\", "\n", "%00", "%2"
+    };
+    size_t n = 0;
+    size_t k;
+    const char* p;
+
+    srand(seed);
+    while (n < len) {
+        p = parts[(size_t) rand() % (sizeof(parts) / sizeof(parts[0]))];
+        k = strlen(p);
+        if (n + k > len) {
+            k = len - n;
+        }
+        memcpy(src + n, p, k);
+        n += k;
+    }
+    if (bad && len > 0) {
+        src[(size_t) rand() % len] = (char) 0xC3;
+    }
+    return n;
+}
+
+static char* testSameAsStages(void)
+{
+    static const int flags[] = {
+        MODP_FUSE_BURL_DECODE | MODP_FUSE_UTF8_VALIDATE | MODP_FUSE_XML_ENCODE,
+        MODP_FUSE_BURL_DECODE | MODP_FUSE_UTF8_VALIDATE | MODP_FUSE_JSON_STRING,
+        MODP_FUSE_BURL_DECODE | MODP_FUSE_XML_ENCODE,
+        MODP_FUSE_UTF8_VALIDATE | MODP_FUSE_XML_ENCODE,
+        MODP_FUSE_UTF8_VALIDATE | MODP_FUSE_JSON_STRING,
+        MODP_FUSE_BURL_DECODE | MODP_FUSE_UTF8_VALIDATE,
+        MODP_FUSE_BURL_DECODE,
+        MODP_FUSE_JSON_STRING,
+        0
+    };
+    static const size_t lens[] = { 0, 1, 2, 3, 100, 8190, 8191, 8192, 8193, 8194, 16384, 19999 };
+    size_t f, l, len, n, m;
+    unsigned seed;
+
+    for (f = 0; f < sizeof(flags) / sizeof(flags[0]); ++f) {
+        for (l = 0; l < sizeof(lens) / sizeof(lens[0]); ++l) {
+            for (seed = 1; seed <= 20; ++seed) {
+                len = make_input(seed, lens[l], seed % 4 == 0);
+                n = stages(once, src, len, flags[f]);
+                m = modp_fuse(out, src, len, flags[f]);
+                mu_assert_int_equals(n, m);
+                mu_assert_int_equals(n, modp_fuse_strlen(src, len, flags[f]));
+                if (n != (size_t) -1) {
+                    mu_assert(memcmp(once, out, n + 1) == 0);
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static char* testFormToXml(void)
+{
+    const char* s = "name=%3Ca+href%3D%22x%22%3E+caf%C3%A9";
+    const int f = MODP_FUSE_BURL_DECODE | MODP_FUSE_UTF8_VALIDATE | MODP_FUSE_XML_ENCODE;
+
+    mu_assert_int_equals(39, modp_fuse(out, s, strlen(s), f));
+    mu_assert_str_equals("name=&lt;a href=&quot;x&quot;&gt; caf\xc3\xa9", out);
+
+    /* a lone %C3 is not UTF-8 */
+    s = "caf%C3";
+    mu_assert_int_equals(-1, modp_fuse(out, s, strlen(s), f));
+    return 0;
+}
+
+static char* all_tests(void)
+{
+    src = (char*) malloc(MAXLEN);
+    mid = (char*) malloc(MAXLEN + 1);
+    once = (char*) malloc(modp_fuse_len(MAXLEN));
+    out = (char*) malloc(modp_fuse_len(MAXLEN));
+    mu_assert(src && mid && once && out);
+
+    mu_run_test(testSameAsStages);
+    mu_run_test(testFormToXml);
+    return 0;
+}
+
+UNITTESTS
@@ -0,0 +1,193 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/*
+ * This test is not linked with the library: every function comes from
+ * the amalgamated header
+ */
+
+/* we compile as C90 but use snprintf */
+#define _ISOC99_SOURCE
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minunit.h"
+
+#ifdef HAVE_PTHREAD_H
+#define MODP_INLINE_PTHREAD
+#endif
+#define MODP_INLINE
+#include "modp_inline.h"
+
+static char* testBase64(void)
+{
+    char buf[100];
+    size_t d;
+
+    d = modp_b64_encode(buf, "\xfb\xff", (size_t)2);
+    mu_assert_int_equals(4, d);
+    mu_assert_str_equals("+/8=", buf);
+    d = modp_b64w_encode(buf, "\xfb\xff", (size_t)2);
+    mu_assert_str_equals("-_8.", buf);
+    d = modp_b64r_encode(buf, "\xfb\xff", (size_t)2);
+    mu_assert_str_equals("-_8=", buf);
+
+    d = modp_b64_decode(buf, "YWJjZA==", (size_t)8);
+    mu_assert_int_equals(4, d);
+    mu_assert(memcmp(buf, "abcd", 4) == 0);
+    mu_assert_int_equals(-1, modp_b64_decode(buf, "YW!j", (size_t)4));
+    return 0;
+}
+
+static char* testOtherCodecs(void)
+{
+    char buf[100];
+    size_t d;
+
+    modp_b16_encode(buf, "\x01\xab", (size_t)2);
+    mu_assert_str_equals("01AB", buf);
+    modp_b2_encode(buf, "a", (size_t)1);
+    mu_assert_str_equals("01100001", buf);
+    modp_b85_encode(buf, "\0\0\0\0", (size_t)4);
+    mu_assert_str_equals("!!!!!", buf);
+    modp_burl_encode(buf, "a b&", (size_t)4);
+    mu_assert_str_equals("a+b%26", buf);
+    modp_bjavascript_encode(buf, "a\"b", (size_t)3);
+    mu_assert_str_equals("a\\\"b", buf);
+    modp_xml_encode(buf, "<&>", (size_t)3);
+    mu_assert_str_equals("&lt;&amp;&gt;", buf);
+    modp_qp_encode(buf, "a=b", (size_t)3);
+    mu_assert_str_equals("a=3Db", buf);
+    d = modp_encword_decode(buf, "=?UTF-8?Q?a_b?=", (size_t)15);
+    mu_assert_int_equals(3, d);
+    mu_assert_str_equals("a b", buf);
+    modp_idna_host_to_ascii(buf, "B\xc3\xbc" "cher.de", (size_t)10);
+    mu_assert_str_equals("xn--bcher-kva.de", buf);
+    modp_datauri_encode(buf, "text/plain", (size_t)10, "hi", (size_t)2);
+    mu_assert_str_equals("data:text/plain;base64,aGk=", buf);
+    return 0;
+}
+
+static char* testText(void)
+{
+    char buf[100];
+    size_t consumed;
+    struct qsiter_t qsi;
+    modp_json_ctx ctx;
+
+    modp_itoa10(-123, buf);
+    mu_assert_str_equals("-123", buf);
+
+    strcpy(buf, "Hello");
+    modp_toupper(buf, strlen(buf));
+    mu_assert_str_equals("HELLO", buf);
+
+    mu_assert_int_equals(MODP_UTF8_OK, modp_utf8_validate("caf\xc3\xa9", (size_t)5));
+    mu_assert_int_equals(38, modp_html_decode_char_at("&amp;", (size_t)5, &consumed));
+    mu_assert_int_equals(5, consumed);
+
+    qsiter_reset(&qsi, "a=1&b=2", (size_t)7);
+    mu_assert_int_equals(1, qsiter_next(&qsi));
+    mu_assert_int_equals(1, qsi.keylen);
+    mu_assert_int_equals('a', qsi.key[0]);
+
+    modp_json_init(&ctx, buf);
+    modp_json_ary_open(&ctx);
+    modp_json_add_int32(&ctx, 1);
+    modp_json_add_cstring(&ctx, "x");
+    modp_json_ary_close(&ctx);
+    buf[modp_json_end(&ctx)] = '\0';
+    mu_assert_str_equals("[1,\"x\"]", buf);
+    return 0;
+}
+
+static char* testIov(void)
+{
+    char out[100];
+    struct iovec src[2];
+    struct iovec dest[1];
+    int destcnt = 1;
+
+    src[0].iov_base = (void*)(size_t) "ab";
+    src[0].iov_len = 2;
+    src[1].iov_base = (void*)(size_t) "cd";
+    src[1].iov_len = 2;
+    dest[0].iov_base = out;
+    dest[0].iov_len = sizeof(out);
+    mu_assert_int_equals(8, modp_iov_code(&modp_pipeline_b64_encode, dest, &destcnt, src, 2));
+    mu_assert_int_equals(1, destcnt);
+    mu_assert(memcmp(out, "YWJjZA==", 8) == 0);
+
+    src[1].iov_base = (void*)(size_t) "\"";
+    src[1].iov_len = 1;
+    destcnt = 1;
+    dest[0].iov_len = sizeof(out);
+    mu_assert_int_equals(6, modp_iov_json_string(dest, &destcnt, src, 2));
+    mu_assert(memcmp(out, "\"ab\\\"\"", 6) == 0);
+    return 0;
+}
+
+/* the input and output of testPipeline */
+struct mem {
+    const char* in;
+    size_t inlen;
+    char out[256];
+    size_t outlen;
+};
+
+static size_t mem_read(void* arg, char* buf, size_t len)
+{
+    struct mem* m = (struct mem*)arg;
+    size_t n = (len < m->inlen) ? len : m->inlen;
+
+    memcpy(buf, m->in, n);
+    m->in += n;
+    m->inlen -= n;
+    return n;
+}
+
+static int mem_write(void* arg, const char* buf, size_t len)
+{
+    struct mem* m = (struct mem*)arg;
+
+    if (m->outlen + len > sizeof(m->out)) {
+        return -1;
+    }
+    memcpy(m->out + m->outlen, buf, len);
+    m->outlen += len;
+    return 0;
+}
+
+static char* testPipeline(void)
+{
+    struct mem m;
+    size_t offset;
+
+    /* blocks of 4 bytes, on 2 threads with MODP_INLINE_PTHREAD */
+    m.in = "%41%42+%4";
+    m.inlen = 9;
+    m.outlen = 0;
+    mu_assert_int_equals(MODP_PIPELINE_OK,
+                         modp_pipeline_run(&modp_pipeline_burl_decode, mem_read, mem_write,
+                                           &m, 4, 2, &offset));
+    mu_assert_int_equals(9, offset);
+    mu_assert_int_equals(5, m.outlen);
+    mu_assert(memcmp(m.out, "AB %4", 5) == 0);
+    return 0;
+}
+
+static char* all_tests(void)
+{
+    mu_run_test(testBase64);
+    mu_run_test(testOtherCodecs);
+    mu_run_test(testText);
+    mu_run_test(testIov);
+    mu_run_test(testPipeline);
+    return 0;
+}
+
+UNITTESTS
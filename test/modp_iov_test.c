@@ -0,0 +1,255 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minunit.h"
+
+#include "modp_iov.h"
+#include "modp_b16.h"
+#include "modp_b64.h"
+#include "modp_burl.h"
+#include "modp_json.h"
+
+#define MAXLEN 5000
+#define MAXIOV 40000
+#define OUTLEN (8 * MAXLEN + 64)
+
+static char* src;
+static char* coded;
+static char* once;
+static char* out;
+static struct iovec in[MAXIOV];
+static struct iovec dest[MAXIOV];
+
+static unsigned int seed;
+
+static size_t rnd(size_t n)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) % n;
+}
+
+/* text with many '%XX', '%' and '+' for the url decoder */
+static void fill_url(char* s, size_t len)
+{
+    static const char chars[] = "%%%%41fF+a9";
+    size_t i;
+
+    for (i = 0; i < len; ++i) {
+        s[i] = chars[rnd(sizeof(chars) - 1)];
+    }
+}
+
+/* cut len bytes at s into buffers of min to max bytes */
+static int split(struct iovec* iov, const char* s, size_t len, size_t min, size_t max)
+{
+    int n = 0;
+    size_t k;
+
+    while (len > 0 && n < MAXIOV - 1) {
+        k = min + rnd(max - min + 1);
+        if (k > len) {
+            k = len;
+        }
+        iov[n].iov_base = (void*)(size_t) s;
+        iov[n].iov_len = k;
+        s += k;
+        len -= k;
+        n += 1;
+    }
+    iov[n].iov_base = (void*)(size_t) s;
+    iov[n].iov_len = len;
+    return n + 1;
+}
+
+/* the buffers written to, one after another */
+static size_t gather(const struct iovec* iov, int cnt, char* to)
+{
+    size_t n = 0;
+    int i;
+
+    for (i = 0; i < cnt; ++i) {
+        memcpy(to + n, iov[i].iov_base, iov[i].iov_len);
+        n += iov[i].iov_len;
+    }
+    return n;
+}
+
+/*
+ * code s in pieces of up to inmax bytes into buffers of up to outmax
+ * bytes, and check it is what the one-shot call gives
+ */
+static char* check(const modp_pipeline_codec* c, const char* s, size_t len,
+                   size_t inmax, size_t outmax)
+{
+    size_t n;
+    size_t want;
+    size_t space;
+    int incnt, outcnt;
+
+    want = c->fn(once, s, len);
+    incnt = split(in, s, len, 0, inmax);
+    space = modp_iov_len(c, in, incnt);
+    mu_assert(want <= space);
+
+    outcnt = split(dest, out, space, 1, outmax);
+    n = modp_iov_code(c, dest, &outcnt, in, incnt);
+    mu_assert_int_equals(want, n);
+    mu_assert_int_equals(want, gather(dest, outcnt, coded));
+    mu_assert(memcmp(once, coded, want) == 0);
+    mu_assert((want == 0) == (outcnt == 0));
+    if (outcnt > 0) {
+        mu_assert(dest[outcnt - 1].iov_len > 0);
+    }
+    return 0;
+}
+
+static char* testSameAsOneCall(void)
+{
+    static const modp_pipeline_codec* const encoders[] = {
+        &modp_pipeline_b64_encode, &modp_pipeline_b16_encode, &modp_pipeline_burl_encode
+    };
+    static const size_t lens[] = { 0, 1, 2, 3, 4, 5, 100, 1000, MAXLEN };
+    static const size_t inmax[] = { 1, 2, 7, 100, MAXLEN };
+    static const size_t outmax[] = { 1, 5, 31, 600, OUTLEN };
+    size_t e, l, a, b, n, i;
+    char* msg;
+
+    for (i = 0; i < MAXLEN; ++i) {
+        src[i] = (char)(i * 7 + i / 251);
+    }
+    for (l = 0; l < sizeof(lens) / sizeof(lens[0]); ++l) {
+        for (a = 0; a < sizeof(inmax) / sizeof(inmax[0]); ++a) {
+            for (b = 0; b < sizeof(outmax) / sizeof(outmax[0]); ++b) {
+                for (e = 0; e < sizeof(encoders) / sizeof(encoders[0]); ++e) {
+                    msg = check(encoders[e], src, lens[l], inmax[a], outmax[b]);
+                    if (msg) {
+                        return msg;
+                    }
+                }
+
+                /* and back */
+                n = modp_b64_encode(coded, src, lens[l]);
+                memcpy(src + MAXLEN, coded, n);
+                msg = check(&modp_pipeline_b64_decode, src + MAXLEN, n, inmax[a], outmax[b]);
+                if (msg) {
+                    return msg;
+                }
+                n = modp_b16_encode(coded, src, lens[l]);
+                memcpy(src + MAXLEN, coded, n);
+                msg = check(&modp_pipeline_b16_decode, src + MAXLEN, n, inmax[a], outmax[b]);
+                if (msg) {
+                    return msg;
+                }
+                fill_url(src + MAXLEN, lens[l]);
+                msg = check(&modp_pipeline_burl_decode, src + MAXLEN, lens[l], inmax[a], outmax[b]);
+                if (msg) {
+                    return msg;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+static char* testJsonString(void)
+{
+    static const size_t lens[] = { 0, 1, 2, 100, MAXLEN };
+    modp_json_ctx ctx;
+    size_t want, n, l, i, k;
+    int incnt, outcnt;
+
+    for (i = 0; i < MAXLEN; ++i) {
+        src[i] = (char)(i * 13 + i / 7);
+    }
+    for (l = 0; l < sizeof(lens) / sizeof(lens[0]); ++l) {
+        for (k = 1; k <= 64; k *= 4) {
+            modp_json_init(&ctx, once);
+            modp_json_add_string(&ctx, src, lens[l]);
+            want = modp_json_end(&ctx);
+
+            incnt = split(in, src, lens[l], 0, k);
+            n = modp_iov_json_string_len(in, incnt);
+            mu_assert_int_equals(want, n);
+            outcnt = split(dest, out, n, 1, k);
+            n = modp_iov_json_string(dest, &outcnt, in, incnt);
+            mu_assert_int_equals(want, n);
+            mu_assert_int_equals(want, gather(dest, outcnt, coded));
+            mu_assert(memcmp(once, coded, want) == 0);
+        }
+    }
+    return 0;
+}
+
+/* one output buffer is the one-shot call */
+static char* testOneBuffer(void)
+{
+    struct iovec one;
+    int incnt, outcnt = 1;
+    size_t n;
+
+    incnt = split(in, src, 1000, 0, 10);
+    one.iov_base = out;
+    one.iov_len = modp_iov_len(&modp_pipeline_b64_encode, in, incnt);
+    mu_assert_int_equals(modp_b64_encode_strlen(1000), one.iov_len);
+    n = modp_iov_code(&modp_pipeline_b64_encode, &one, &outcnt, in, incnt);
+    mu_assert_int_equals(modp_b64_encode(once, src, 1000), n);
+    mu_assert_int_equals(1, outcnt);
+    mu_assert_int_equals(n, one.iov_len);
+    mu_assert(memcmp(once, out, n) == 0);
+    return 0;
+}
+
+static char* testErrors(void)
+{
+    struct iovec two[2];
+    int incnt, outcnt;
+    size_t n;
+
+    /* a bad char in the 3rd piece */
+    n = modp_b64_encode(coded, src, 300);
+    coded[250] = '!';
+    incnt = split(in, coded, n, 0, 100);
+    two[0].iov_base = out;
+    two[0].iov_len = 200;
+    two[1].iov_base = out + 200;
+    two[1].iov_len = 200;
+    outcnt = 2;
+    mu_assert_int_equals(-1, modp_iov_code(&modp_pipeline_b64_decode, two, &outcnt, in, incnt));
+
+    /* not enough room, by one byte */
+    incnt = split(in, src, 300, 0, 100);
+    two[1].iov_len = 199;
+    outcnt = 2;
+    mu_assert_int_equals(-1, modp_iov_code(&modp_pipeline_b64_encode, two, &outcnt, in, incnt));
+    two[1].iov_len = 200;
+    outcnt = 2;
+    mu_assert_int_equals(400, modp_iov_code(&modp_pipeline_b64_encode, two, &outcnt, in, incnt));
+    mu_assert_int_equals(2, outcnt);
+
+    /* nothing in, nothing used */
+    outcnt = 2;
+    mu_assert_int_equals(0, modp_iov_code(&modp_pipeline_b16_encode, two, &outcnt, in, 0));
+    mu_assert_int_equals(0, outcnt);
+    return 0;
+}
+
+static char* all_tests(void)
+{
+    src = (char*)malloc(4 * MAXLEN);
+    coded = (char*)malloc(6 * MAXLEN + 16);
+    once = (char*)malloc(6 * MAXLEN + 16);
+    out = (char*)malloc(OUTLEN);
+    mu_assert(src && coded && once && out);
+
+    mu_run_test(testSameAsOneCall);
+    mu_run_test(testJsonString);
+    mu_run_test(testOneBuffer);
+    mu_run_test(testErrors);
+    return 0;
+}
+
+UNITTESTS
@@ -326,6 +326,68 @@ static char* test_json_uint64()
     return 0;
 }
 
+static char* test_json_int64()
+{
+    size_t len;
+    char buf[100];
+    modp_json_ctx ctx;
+
+    modp_json_init(&ctx, NULL);
+    modp_json_add_int64(&ctx, -123, 0);
+    len = modp_json_end(&ctx);
+    mu_assert_int_equals(len, 4);
+
+    modp_json_init(&ctx, buf);
+    modp_json_ary_open(&ctx);
+    modp_json_add_int64(&ctx, -123, 0);
+    modp_json_add_int64(&ctx, 123, 0);
+    modp_json_add_int64(&ctx, -123, 1);
+    modp_json_add_int64(&ctx, -(1LL << 53), 0);
+    modp_json_ary_close(&ctx);
+    len = modp_json_end(&ctx);
+    mu_assert_str_equals("[-123,123,\"-123\",-9007199254740992]", buf);
+    mu_assert_int_equals(len, strlen(buf));
+
+    /* automatic stringonly mode, and the count agrees */
+    modp_json_init(&ctx, NULL);
+    modp_json_add_int64(&ctx, INT64_MIN, 0);
+    len = modp_json_end(&ctx);
+    mu_assert_int_equals(len, 22);
+
+    modp_json_init(&ctx, buf);
+    modp_json_add_int64(&ctx, INT64_MIN, 0);
+    len = modp_json_end(&ctx);
+    mu_assert_int_equals(len, 22);
+    mu_assert_str_equals("\"-9223372036854775808\"", buf);
+
+    return 0;
+}
+
+static char* test_json_double()
+{
+    size_t len;
+    char buf[100];
+    modp_json_ctx ctx;
+
+    modp_json_init(&ctx, NULL);
+    modp_json_add_double(&ctx, 1.5);
+    len = modp_json_end(&ctx);
+    mu_assert_int_equals(len, 3);
+
+    modp_json_init(&ctx, buf);
+    modp_json_ary_open(&ctx);
+    modp_json_add_double(&ctx, 1.5);
+    modp_json_add_double(&ctx, -0.25);
+    modp_json_add_double(&ctx, 3.0);
+    modp_json_add_double(&ctx, 0.0 / 0.0);
+    modp_json_ary_close(&ctx);
+    len = modp_json_end(&ctx);
+    mu_assert_str_equals("[1.5,-0.25,3,null]", buf);
+    mu_assert_int_equals(len, strlen(buf));
+
+    return 0;
+}
+
 static char* all_tests()
 {
     mu_run_test(test_json_init);
@@ -338,6 +400,8 @@ static char* all_tests()
     mu_run_test(test_json_nest_1);
     mu_run_test(test_json_int32);
     mu_run_test(test_json_uint64);
+    mu_run_test(test_json_int64);
+    mu_run_test(test_json_double);
     return 0;
 }
 
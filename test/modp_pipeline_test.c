@@ -0,0 +1,186 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minunit.h"
+
+#include "modp_pipeline.h"
+#include "modp_b64.h"
+#include "modp_b85.h"
+
+#define INLEN 100003
+
+/* a stream in memory, read in odd sized pieces */
+struct mem {
+    const char* in;
+    size_t inlen;
+    size_t inpos;
+    char* out;
+    size_t outlen;
+    size_t outcap;
+    /* fail the read or write after this many bytes */
+    size_t read_fail;
+    size_t write_fail;
+};
+
+static size_t mem_read(void* arg, char* buf, size_t len)
+{
+    struct mem* m = (struct mem*)arg;
+    size_t n = m->inlen - m->inpos;
+
+    if (m->inpos >= m->read_fail) {
+        return (size_t)-1;
+    }
+    if (n > len) {
+        n = len;
+    }
+    if (n > 777) {
+        n = 777;
+    }
+    memcpy(buf, m->in + m->inpos, n);
+    m->inpos += n;
+    return n;
+}
+
+static int mem_write(void* arg, const char* buf, size_t len)
+{
+    struct mem* m = (struct mem*)arg;
+
+    if (m->outlen + len > m->outcap || m->outlen + len > m->write_fail) {
+        return -1;
+    }
+    memcpy(m->out + m->outlen, buf, len);
+    m->outlen += len;
+    return 0;
+}
+
+static void mem_init(struct mem* m, const char* in, size_t inlen, char* out, size_t outcap)
+{
+    memset(m, 0, sizeof(*m));
+    m->in = in;
+    m->inlen = inlen;
+    m->out = out;
+    m->outcap = outcap;
+    m->read_fail = (size_t)-1;
+    m->write_fail = (size_t)-1;
+}
+
+static char* src;
+static char* once;
+static char* out;
+static char* back;
+
+/* the same output as one call, on 1 to 4 threads and odd block sizes */
+static char* testSameAsOneCall(void)
+{
+    struct mem m;
+    size_t n, at, t, b;
+    static const size_t blocks[] = { 1, 4096, 5000, 65536, 1 << 20 };
+
+    n = modp_b64_encode(once, src, INLEN);
+    for (t = 1; t <= 4; ++t) {
+        for (b = 0; b < sizeof(blocks) / sizeof(blocks[0]); ++b) {
+            mem_init(&m, src, INLEN, out, modp_b64_encode_len(INLEN));
+            mu_assert_int_equals(MODP_PIPELINE_OK,
+                                 modp_pipeline_run(&modp_pipeline_b64_encode, mem_read, mem_write,
+                                                   &m, blocks[b], t, &at));
+            mu_assert_int_equals(n, m.outlen);
+            mu_assert(memcmp(once, out, n) == 0);
+            mu_assert_int_equals(INLEN, at);
+
+            /* and back */
+            mem_init(&m, out, n, back, INLEN + 16);
+            mu_assert_int_equals(MODP_PIPELINE_OK,
+                                 modp_pipeline_run(&modp_pipeline_b64_decode, mem_read, mem_write,
+                                                   &m, blocks[b], t, NULL));
+            mu_assert_int_equals(INLEN, m.outlen);
+            mu_assert(memcmp(src, back, INLEN) == 0);
+        }
+    }
+    return 0;
+}
+
+static char* testEmpty(void)
+{
+    struct mem m;
+    size_t at = 99;
+
+    mem_init(&m, src, 0, out, 16);
+    mu_assert_int_equals(MODP_PIPELINE_OK,
+                         modp_pipeline_run(&modp_pipeline_b64_encode, mem_read, mem_write,
+                                           &m, 0, 2, &at));
+    mu_assert_int_equals(0, m.outlen);
+    mu_assert_int_equals(0, at);
+    return 0;
+}
+
+/* b85 needs groups of 4, a block of 4097 must not split one */
+static char* testGroups(void)
+{
+    struct mem m;
+    size_t n;
+
+    n = modp_b85_encode(once, src, 40000);
+    mem_init(&m, src, 40000, out, modp_b85_encode_len(40000));
+    mu_assert_int_equals(MODP_PIPELINE_OK,
+                         modp_pipeline_run(&modp_pipeline_b85_encode, mem_read, mem_write,
+                                           &m, 4097, 3, NULL));
+    mu_assert_int_equals(n, m.outlen);
+    mu_assert(memcmp(once, out, n) == 0);
+    return 0;
+}
+
+static char* testErrors(void)
+{
+    struct mem m;
+    size_t n, at;
+
+    /* a bad char in the 3rd block of 4096 */
+    n = modp_b64_encode(once, src, 30000);
+    once[10000] = '!';
+    mem_init(&m, once, n, back, 30000);
+    mu_assert_int_equals(MODP_PIPELINE_EINPUT,
+                         modp_pipeline_run(&modp_pipeline_b64_decode, mem_read, mem_write,
+                                           &m, 4096, 2, &at));
+    mu_assert_int_equals(8192, at);
+    mu_assert(m.outlen <= 8192 / 4 * 3);
+
+    mem_init(&m, src, INLEN, out, modp_b64_encode_len(INLEN));
+    m.read_fail = 50000;
+    mu_assert_int_equals(MODP_PIPELINE_EREAD,
+                         modp_pipeline_run(&modp_pipeline_b64_encode, mem_read, mem_write,
+                                           &m, 4096, 3, NULL));
+
+    mem_init(&m, src, INLEN, out, modp_b64_encode_len(INLEN));
+    m.write_fail = 20000;
+    mu_assert_int_equals(MODP_PIPELINE_EWRITE,
+                         modp_pipeline_run(&modp_pipeline_b64_encode, mem_read, mem_write,
+                                           &m, 4096, 3, &at));
+    mu_assert(at < 20000);
+    return 0;
+}
+
+static char* all_tests(void)
+{
+    size_t i;
+
+    src = (char*)malloc(INLEN);
+    once = (char*)malloc(modp_b64_encode_len(INLEN));
+    out = (char*)malloc(modp_b64_encode_len(INLEN));
+    back = (char*)malloc(INLEN + 16);
+    mu_assert(src && once && out && back);
+    for (i = 0; i < INLEN; ++i) {
+        src[i] = (char)(i * 7 + i / 251);
+    }
+
+    mu_run_test(testSameAsOneCall);
+    mu_run_test(testEmpty);
+    mu_run_test(testGroups);
+    mu_run_test(testErrors);
+    return 0;
+}
+
+UNITTESTS
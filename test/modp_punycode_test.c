@@ -0,0 +1,137 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/* we compile as C90 but use snprintf */
+#define _ISOC99_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minunit.h"
+
+#include "modp_punycode.h"
+
+/* samples from RFC 3492 section 7.1 */
+static const char* sUnicode[] = {
+    /* (A) Arabic (Egyptian) */
+    "\xd9\x84\xd9\x8a\xd9\x87\xd9\x85\xd8\xa7\xd8\xa8\xd8\xaa\xd9\x83"
+    "\xd9\x84\xd9\x85\xd9\x88\xd8\xb4\xd8\xb9\xd8\xb1\xd8\xa8\xd9\x8a"
+    "\xd8\x9f",
+    /* (B) Chinese (simplified) */
+    "\xe4\xbb\x96\xe4\xbb\xac\xe4\xb8\xba\xe4\xbb\x80\xe4\xb9\x88\xe4"
+    "\xb8\x8d\xe8\xaf\xb4\xe4\xb8\xad\xe6\x96\x87",
+    /* (D) Czech */
+    "Pro\xc4\x8dprost\xc4\x9bnemluv\xc3\xad\xc4\x8d" "esky",
+    "b\xc3\xbc" "cher",
+    NULL
+};
+
+static const char* sPunycode[] = {
+    "egbpdaj6bu4bxfgehfvwxn",
+    "ihqwcrb4cv8a8dqg056pqjye",
+    "Proprostnemluvesky-uyb24dma41a",
+    "bcher-kva",
+    NULL
+};
+
+static char* testRFC(void)
+{
+    char buf[modp_punycode_encode_len(100)];
+    char back[modp_punycode_decode_len(100)];
+    size_t i, d;
+
+    for (i = 0; sUnicode[i] != NULL; ++i) {
+        d = modp_punycode_encode(buf, sUnicode[i], strlen(sUnicode[i]));
+        mu_assert_int_equals(strlen(sPunycode[i]), d);
+        mu_assert_str_equals(sPunycode[i], buf);
+
+        d = modp_punycode_decode(back, buf, d);
+        mu_assert_int_equals(strlen(sUnicode[i]), d);
+        mu_assert_str_equals(sUnicode[i], back);
+    }
+    return 0;
+}
+
+static char* testAscii(void)
+{
+    char buf[100];
+    size_t d;
+
+    d = modp_punycode_encode(buf, "", (size_t)0);
+    mu_assert_int_equals(0, d);
+    mu_assert_str_equals("", buf);
+
+    /* all basic, just a trailing delimiter */
+    d = modp_punycode_encode(buf, "abc", (size_t)3);
+    mu_assert_str_equals("abc-", buf);
+    d = modp_punycode_decode(buf, "abc-", (size_t)4);
+    mu_assert_str_equals("abc", buf);
+    return 0;
+}
+
+static char* testBadInput(void)
+{
+    char buf[modp_punycode_encode_len(2 * MODP_PUNYCODE_MAX + 2)];
+    char src[2 * MODP_PUNYCODE_MAX + 2];
+    size_t i;
+
+    /* invalid UTF-8 */
+    mu_assert_int_equals(-1, modp_punycode_encode(buf, "a\xc3", (size_t)2));
+    mu_assert_int_equals(-1, modp_punycode_encode(buf, "\xed\xa0\x80", (size_t)3));
+
+    /* bad digits, truncated numbers, and basic after the delimiter */
+    mu_assert_int_equals(-1, modp_punycode_decode(buf, "abc-!", (size_t)5));
+    mu_assert_int_equals(-1, modp_punycode_decode(buf, "bcher-kv", (size_t)8));
+    mu_assert_int_equals(-1, modp_punycode_decode(buf, "-", (size_t)1));
+    mu_assert_int_equals(-1, modp_punycode_decode(buf, "99999999999", (size_t)11));
+
+    /* too many code points */
+    for (i = 0; i < sizeof(src); i += 2) {
+        src[i] = (char)0xc3;
+        src[i + 1] = (char)0xa9;
+    }
+    mu_assert_int_equals(-1, modp_punycode_encode(buf, src, sizeof(src)));
+    mu_assert(modp_punycode_encode(buf, src, 2 * MODP_PUNYCODE_MAX) != (size_t)-1);
+    return 0;
+}
+
+static char* testHost(void)
+{
+    char buf[modp_idna_to_ascii_len(100)];
+    char back[modp_idna_to_unicode_len(sizeof(buf))];
+    const char* host = "WWW.B\xc3\xbc" "cher.Example.COM.";
+    size_t d;
+
+    d = modp_idna_host_to_ascii(buf, "WWW.Example.COM", (size_t)15);
+    mu_assert_int_equals(15, d);
+    mu_assert_str_equals("www.example.com", buf);
+
+    d = modp_idna_host_to_ascii(buf, host, strlen(host));
+    mu_assert_str_equals("www.xn--bcher-kva.example.com.", buf);
+    mu_assert_int_equals(strlen(buf), d);
+
+    d = modp_idna_host_to_unicode(back, buf, d);
+    mu_assert_str_equals("www.b\xc3\xbc" "cher.example.com.", back);
+
+    d = modp_idna_host_to_unicode(back, "XN--bcher-kva.com", (size_t)17);
+    mu_assert_str_equals("b\xc3\xbc" "cher.com", back);
+
+    d = modp_idna_host_to_unicode(back, "xn--bcher-kv.com", (size_t)16);
+    mu_assert_int_equals(-1, d);
+
+    d = modp_idna_label_to_ascii(buf, "B\xc3\xbc" "CHER", (size_t)7);
+    mu_assert_str_equals("xn--bcher-kva", buf);
+    return 0;
+}
+
+static char* all_tests(void)
+{
+    mu_run_test(testRFC);
+    mu_run_test(testAscii);
+    mu_run_test(testBadInput);
+    mu_run_test(testHost);
+    return 0;
+}
+
+UNITTESTS
@@ -0,0 +1,225 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+/* we compile as C90 but use snprintf */
+#define _ISOC99_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "minunit.h"
+
+#include "modp_qp.h"
+
+static char* testEncodeSimple(void)
+{
+    char buf[1000];
+    size_t d;
+
+    d = modp_qp_encode(buf, "", (size_t)0);
+    mu_assert_int_equals(0, d);
+    mu_assert_str_equals("", buf);
+
+    d = modp_qp_encode(buf, "hello world", (size_t)11);
+    mu_assert_int_equals(11, d);
+    mu_assert_str_equals("hello world", buf);
+
+    d = modp_qp_encode(buf, "a=b", (size_t)3);
+    mu_assert_int_equals(5, d);
+    mu_assert_str_equals("a=3Db", buf);
+
+    /* 8-bit, with a 2-byte utf-8 char */
+    d = modp_qp_encode(buf, "caf\xc3\xa9", (size_t)5);
+    mu_assert_str_equals("caf=C3=A9", buf);
+
+    /* hard line breaks pass through, lone CR or LF do not */
+    d = modp_qp_encode(buf, "a\r\nb\nc\rd", (size_t)8);
+    mu_assert_str_equals("a\r\nb=0Ac=0Dd", buf);
+    return 0;
+}
+
+static char* testTrailingSpace(void)
+{
+    char buf[1000];
+
+    /* white space is escaped only at the end of a line */
+    modp_qp_encode(buf, "a b", (size_t)3);
+    mu_assert_str_equals("a b", buf);
+    modp_qp_encode(buf, "a ", (size_t)2);
+    mu_assert_str_equals("a=20", buf);
+    modp_qp_encode(buf, "a\t", (size_t)2);
+    mu_assert_str_equals("a=09", buf);
+    modp_qp_encode(buf, "a  \r\nb", (size_t)6);
+    mu_assert_str_equals("a =20\r\nb", buf);
+    modp_qp_encode(buf, "a \r", (size_t)3);
+    mu_assert_str_equals("a =0D", buf);
+    return 0;
+}
+
+/*
+ * every line is at most 76 chars, and soft line breaks decode away
+ */
+static char* testSoftBreaks(void)
+{
+    char src[500];
+    char buf[modp_qp_encode_len(500)];
+    char back[modp_qp_decode_len(sizeof(buf))];
+    char* line;
+    char* eol;
+    size_t i, len, d;
+
+    for (len = 0; len < sizeof(src); ++len) {
+        for (i = 0; i < len; ++i) {
+            /* a mix of literals and escapes */
+            src[i] = (char)((i % 7 == 0) ? '=' : 'a' + (i % 26));
+        }
+        d = modp_qp_encode(buf, src, len);
+        mu_assert_int_equals(d, strlen(buf));
+        mu_assert_int_equals(d, modp_qp_encode_strlen(src, len));
+
+        line = buf;
+        while ((eol = strstr(line, "\r\n")) != NULL) {
+            mu_assert((size_t)(eol - line) <= MODP_QP_LINE_MAX);
+            mu_assert_int_equals('=', eol[-1]);
+            line = eol + 2;
+        }
+        mu_assert(strlen(line) <= MODP_QP_LINE_MAX);
+
+        d = modp_qp_decode(back, buf, d);
+        mu_assert_int_equals(len, d);
+        mu_assert(memcmp(src, back, len) == 0);
+    }
+    return 0;
+}
+
+static char* testBinaryRoundTrip(void)
+{
+    char src[1024];
+    char buf[modp_qp_encode_len(1024)];
+    char back[sizeof(buf)];
+    size_t i, d;
+
+    for (i = 0; i < sizeof(src); ++i) {
+        src[i] = (char)((i * 7) & 0xff);
+    }
+    d = modp_qp_encode(buf, src, sizeof(src));
+    mu_assert(d < sizeof(buf));
+    mu_assert_int_equals(d, modp_qp_encode_strlen(src, sizeof(src)));
+
+    /* in-place decode */
+    memcpy(back, buf, d + 1);
+    d = modp_qp_decode(back, back, d);
+    mu_assert_int_equals(sizeof(src), d);
+    mu_assert(memcmp(src, back, sizeof(src)) == 0);
+    return 0;
+}
+
+static char* testDecode(void)
+{
+    char buf[100];
+    size_t d;
+
+    d = modp_qp_decode(buf, "a=3Db=3db", (size_t)9);
+    mu_assert_int_equals(5, d);
+    mu_assert_str_equals("a=b=b", buf);
+
+    /* soft breaks with CRLF and bare LF */
+    d = modp_qp_decode(buf, "ab=\r\ncd=\nef", (size_t)11);
+    mu_assert_str_equals("abcdef", buf);
+
+    /* malformed "=" passes through */
+    d = modp_qp_decode(buf, "=ZZ=4=", (size_t)6);
+    mu_assert_str_equals("=ZZ=4=", buf);
+    return 0;
+}
+
+/*
+ * streaming output, split at every point, matches the one-shot output
+ */
+static char* testStreaming(void)
+{
+    const char* src = "ab c \r\n= \t\r\nline2=\r\x80 \r";
+    size_t len = strlen(src);
+    char expected[200];
+    char buf[200];
+    char back[200];
+    modp_qp_ctx ctx;
+    size_t i, j, d, elen;
+
+    elen = modp_qp_encode(expected, src, len);
+    for (i = 0; i <= len; ++i) {
+        for (j = i; j <= len; ++j) {
+            modp_qp_encode_init(&ctx);
+            d = modp_qp_encode_update(&ctx, buf, src, i);
+            d += modp_qp_encode_update(&ctx, buf + d, src + i, j - i);
+            d += modp_qp_encode_update(&ctx, buf + d, src + j, len - j);
+            d += modp_qp_encode_final(&ctx, buf + d);
+            mu_assert_int_equals(elen, d);
+            mu_assert(memcmp(expected, buf, d) == 0);
+        }
+    }
+
+    for (i = 0; i <= elen; ++i) {
+        for (j = i; j <= elen; ++j) {
+            modp_qp_decode_init(&ctx);
+            d = modp_qp_decode_update(&ctx, back, expected, i);
+            d += modp_qp_decode_update(&ctx, back + d, expected + i, j - i);
+            d += modp_qp_decode_update(&ctx, back + d, expected + j, elen - j);
+            d += modp_qp_decode_final(&ctx, back + d);
+            mu_assert_int_equals(len, d);
+            mu_assert(memcmp(src, back, d) == 0);
+        }
+    }
+    return 0;
+}
+
+/*
+ * malformed '=' decoded in chunks, split at every point, is the same
+ * as the one-shot decode
+ */
+static char* testStreamingMalformed(void)
+{
+    static const char* const srcs[] = {
+        "abc=G=41rest",
+        "abc=A=41rest",
+        "==41===4=\n=\r=\r\n=ZZ=",
+        "x=4=3D=\r=41=",
+        "=="
+    };
+    char expected[100];
+    char back[100];
+    modp_qp_ctx ctx;
+    size_t k, i, j, d, len, elen;
+
+    for (k = 0; k < sizeof(srcs) / sizeof(srcs[0]); ++k) {
+        len = strlen(srcs[k]);
+        elen = modp_qp_decode(expected, srcs[k], len);
+        for (i = 0; i <= len; ++i) {
+            for (j = i; j <= len; ++j) {
+                modp_qp_decode_init(&ctx);
+                d = modp_qp_decode_update(&ctx, back, srcs[k], i);
+                d += modp_qp_decode_update(&ctx, back + d, srcs[k] + i, j - i);
+                d += modp_qp_decode_update(&ctx, back + d, srcs[k] + j, len - j);
+                d += modp_qp_decode_final(&ctx, back + d);
+                mu_assert_int_equals(elen, d);
+                mu_assert(memcmp(expected, back, d) == 0);
+            }
+        }
+    }
+    return 0;
+}
+
+static char* all_tests(void)
+{
+    mu_run_test(testEncodeSimple);
+    mu_run_test(testTrailingSpace);
+    mu_run_test(testSoftBreaks);
+    mu_run_test(testBinaryRoundTrip);
+    mu_run_test(testDecode);
+    mu_run_test(testStreaming);
+    mu_run_test(testStreamingMalformed);
+    return 0;
+}
+
+UNITTESTS
@@ -0,0 +1,161 @@
+/* -*- mode: c; c-basic-offset: 4; indent-tabs-mode: nil; tab-width: 4 -*- */
+/* vi: set expandtab shiftwidth=4 tabstop=4: */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef MODP_STATS
+#include <pthread.h>
+#endif
+
+#include "minunit.h"
+
+#include "modp_stats.h"
+#include "modp_b64.h"
+#include "modp_b64w.h"
+#include "modp_burl.h"
+#include "modp_utf8.h"
+#include "modp_encword.h"
+#include "modp_datauri.h"
+#include "modp_fuse.h"
+
+static modp_stats_entry stats[MODP_STATS_COUNT];
+
+static char* testNames(void)
+{
+    mu_assert_int_equals(MODP_STATS_COUNT, modp_stats_read(stats, MODP_STATS_COUNT));
+    mu_assert_str_equals("modp_b64_decode", stats[MODP_STATS_ID_b64_decode].name);
+    mu_assert_str_equals("modp_b64w_encode", stats[MODP_STATS_ID_b64w_encode].name);
+    mu_assert_str_equals("modp_datauri_decode",
+                         stats[MODP_STATS_COUNT - 1].name);
+
+    /* a short read */
+    mu_assert_int_equals(2, modp_stats_read(stats, 2));
+    return 0;
+}
+
+static char* testCount(void)
+{
+    char buf[64];
+
+    modp_stats_reset();
+    modp_b64_encode(buf, "abcdef", 6);
+    modp_b64_decode(buf, "YWJj", 4);
+    modp_b64_decode(buf, "!!!!", 4);
+    modp_b64w_encode(buf, "a", 1);
+    modp_utf8_validate("\xC0\x80", 2);
+    modp_utf8_validate("ok", 2);
+
+    modp_stats_read(stats, MODP_STATS_COUNT);
+    if (!modp_stats_enabled()) {
+        mu_assert_int_equals(0, stats[MODP_STATS_ID_b64_decode].calls);
+        return 0;
+    }
+    mu_assert_int_equals(1, stats[MODP_STATS_ID_b64_encode].calls);
+    mu_assert_int_equals(6, stats[MODP_STATS_ID_b64_encode].bytes_in);
+    mu_assert_int_equals(8, stats[MODP_STATS_ID_b64_encode].bytes_out);
+
+    mu_assert_int_equals(2, stats[MODP_STATS_ID_b64_decode].calls);
+    mu_assert_int_equals(8, stats[MODP_STATS_ID_b64_decode].bytes_in);
+    mu_assert_int_equals(3, stats[MODP_STATS_ID_b64_decode].bytes_out);
+    mu_assert_int_equals(1, stats[MODP_STATS_ID_b64_decode].errors);
+
+    /* made from modp_b64.c but counted on its own */
+    mu_assert_int_equals(1, stats[MODP_STATS_ID_b64w_encode].calls);
+    mu_assert_int_equals(4, stats[MODP_STATS_ID_b64w_encode].bytes_out);
+
+    mu_assert_int_equals(2, stats[MODP_STATS_ID_utf8_validate].calls);
+    mu_assert_int_equals(1, stats[MODP_STATS_ID_utf8_validate].errors);
+
+    mu_assert_int_equals(0, stats[MODP_STATS_ID_burl_encode].calls);
+
+    /* reset zeroes what is read */
+    modp_stats_reset();
+    modp_stats_read(stats, MODP_STATS_COUNT);
+    mu_assert_int_equals(0, stats[MODP_STATS_ID_b64_decode].calls);
+    mu_assert_int_equals(0, stats[MODP_STATS_ID_b64_decode].errors);
+    modp_burl_encode(buf, "a b", 3);
+    modp_stats_read(stats, MODP_STATS_COUNT);
+    mu_assert_int_equals(1, stats[MODP_STATS_ID_burl_encode].calls);
+    return 0;
+}
+
+/* a call that codes with other modules counts once, as itself */
+static char* testNested(void)
+{
+    char buf[256];
+    char uri[] = "data:;base64,YWJj";
+    struct modp_datauri_t d;
+
+    modp_stats_reset();
+    modp_encword_encode(buf, "caf\xc3\xa9 caf\xc3\xa9", 11);
+    modp_datauri_encode(buf, "text/plain", 10, "abc", 3);
+    mu_assert_int_equals(3, modp_datauri_decode(&d, uri, strlen(uri)));
+    modp_fuse(buf, "a%C3%A9b", 8, MODP_FUSE_BURL_DECODE | MODP_FUSE_UTF8_VALIDATE);
+
+    modp_stats_read(stats, MODP_STATS_COUNT);
+    if (!modp_stats_enabled()) {
+        return 0;
+    }
+    mu_assert_int_equals(1, stats[MODP_STATS_ID_encword_encode].calls);
+    mu_assert_int_equals(1, stats[MODP_STATS_ID_datauri_encode].calls);
+    mu_assert_int_equals(1, stats[MODP_STATS_ID_datauri_decode].calls);
+    mu_assert_int_equals(0, stats[MODP_STATS_ID_b64_encode].calls);
+    mu_assert_int_equals(0, stats[MODP_STATS_ID_b64_decode].calls);
+    mu_assert_int_equals(0, stats[MODP_STATS_ID_burl_decode].calls);
+    mu_assert_int_equals(0, stats[MODP_STATS_ID_burl_decode_raw].calls);
+    mu_assert_int_equals(0, stats[MODP_STATS_ID_utf8_validate].calls);
+    return 0;
+}
+
+#ifdef MODP_STATS
+static void* encode_many(void* arg)
+{
+    char buf[16];
+    int i;
+    (void)arg;
+    for (i = 0; i < 1000; ++i) {
+        modp_b64_encode(buf, "abc", 3);
+    }
+    return NULL;
+}
+#endif
+
+/* the counts of threads that have exited are kept */
+static char* testThreads(void)
+{
+#ifdef MODP_STATS
+    pthread_t t[4];
+    int i;
+
+    modp_stats_reset();
+    for (i = 0; i < 4; ++i) {
+        mu_assert(pthread_create(&t[i], NULL, encode_many, NULL) == 0);
+    }
+    for (i = 0; i < 4; ++i) {
+        pthread_join(t[i], NULL);
+    }
+    /* a new thread reuses a block and adds to it */
+    mu_assert(pthread_create(&t[0], NULL, encode_many, NULL) == 0);
+    pthread_join(t[0], NULL);
+
+    modp_stats_read(stats, MODP_STATS_COUNT);
+    mu_assert_int_equals(5000, stats[MODP_STATS_ID_b64_encode].calls);
+    mu_assert_int_equals(15000, stats[MODP_STATS_ID_b64_encode].bytes_in);
+#endif
+    return 0;
+}
+
+static char* all_tests(void)
+{
+    mu_run_test(testNames);
+    mu_run_test(testCount);
+    mu_run_test(testNested);
+    mu_run_test(testThreads);
+    return 0;
+}
+
+UNITTESTS
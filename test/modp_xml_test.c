@@ -321,6 +321,53 @@ static char* testXmlDecodeHexEntities(void)
     return 0;
 }
 
+/**
+ * Bad numeric entities, no digits or bytes over 0x7f, are copied
+ */
+static char* testXmlDecodeBadNumeric(void)
+{
+    static const char* const strin[] = {
+        "X&#;X", "X&#x;X", "X&#X;", "&#\x80;", "&#x\x80;", "&#\xff\xfe;X",
+        "&#x41\xc1;", "&#0;", "&#xD7FF;"
+    };
+    char buf[1000];
+    size_t d;
+    size_t i;
+
+    for (i = 0; i < sizeof(strin) / sizeof(strin[0]); ++i) {
+        memset(buf, 0, sizeof(buf));
+        d = modp_xml_decode(buf, strin[i], strlen(strin[i]));
+        mu_assert_int_equals(d, strlen(strin[i]));
+        mu_assert_str_equals(strin[i], buf);
+    }
+    mu_assert_int_equals(-1, modp_xml_parse_dec_entity("\x80", 1));
+    mu_assert_int_equals(-1, modp_xml_parse_hex_entity("\xc1", 1));
+
+    return 0;
+}
+
+static char* testXmlEncode(void)
+{
+    const char* strin = "X\"X'X&X>X<X";
+    const char* strout = "X&quot;X&apos;X&amp;X&gt;X&lt;X";
+
+    char buf[1000];
+    size_t d = 0;
+
+    memset(buf, 0, sizeof(buf));
+    d = modp_xml_encode(buf, strin, strlen(strin));
+    mu_assert_int_equals(d, strlen(strout));
+    mu_assert_str_equals(strout, buf);
+    mu_assert_int_equals(d, modp_xml_min_encode_strlen(strin, strlen(strin)));
+
+    /* and back */
+    d = modp_xml_decode(buf, buf, d);
+    buf[d] = '\0';
+    mu_assert_str_equals(strin, buf);
+
+    return 0;
+}
+
 static char* all_tests(void)
 {
     mu_run_test(testXmlDecodeEmpty);
@@ -336,6 +383,8 @@ static char* all_tests(void)
     mu_run_test(testXmlUnicodeCharToUTF8);
     mu_run_test(testXmlDecodeDecimalEntities);
     mu_run_test(testXmlDecodeHexEntities);
+    mu_run_test(testXmlDecodeBadNumeric);
+    mu_run_test(testXmlEncode);
     return 0;
 }
 